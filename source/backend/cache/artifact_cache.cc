@@ -0,0 +1,129 @@
+#include "src/cache/artifact_cache.h"
+
+#include "include/utility/logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <format>
+#include <string>
+#include <system_error>
+#include <vector>
+
+// POSIX process id for unique temporary names
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace seecpp::backend {
+
+namespace {
+std::atomic<uint64_t> g_hits{0};
+std::atomic<uint64_t> g_misses{0};
+std::atomic<uint64_t> g_evictions{0};
+std::atomic<uint64_t> g_temp_counter{0};
+
+constexpr std::string_view kEntryExtension = ".see";
+}  // namespace
+
+ArtifactCache::ArtifactCache(fs::path directory, uint64_t max_bytes)
+    : directory_(std::move(directory)), max_bytes_(max_bytes) {}
+
+fs::path ArtifactCache::EntryPath(uint64_t key) const {
+    return directory_ / std::format("{:016x}{}", key, kEntryExtension);
+}
+
+bool ArtifactCache::Fetch(uint64_t key, const fs::path& output) {
+    const fs::path entry = EntryPath(key);
+    std::error_code ec;
+    if (!fs::is_regular_file(entry, ec)) {
+        g_misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Materialize under a temporary name and rename it over `output`, so the
+    // path always names a complete file, and never write through `output`: it
+    // may itself be a link to an entry, or be mapped by a running engine.
+    const fs::path temp = output.parent_path() / std::format(
+        ".{}.{}.{}.tmp", output.filename().string(), getpid(),
+        g_temp_counter.fetch_add(1, std::memory_order_relaxed));
+    fs::create_hard_link(entry, temp, ec);
+    if (ec) {
+        ec.clear();
+        fs::copy_file(entry, temp, fs::copy_options::overwrite_existing, ec);
+    }
+    if (!ec) fs::rename(temp, output, ec);
+    // Normally gone by now; rename() leaves it if `output` already was a link to the entry.
+    std::error_code ignored;
+    fs::remove(temp, ignored);
+    if (ec) {
+        // Most likely evicted by another process between the check and the link.
+        utility::Logger::Warn(std::format(
+            "ArtifactCache: Could not materialize '{}': {}", entry.string(), ec.message()));
+        g_misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // The modification time doubles as the LRU timestamp.
+    fs::last_write_time(entry, fs::file_time_type::clock::now(), ec);
+    g_hits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void ArtifactCache::Store(uint64_t key, const fs::path& artifact) {
+    std::error_code ec;
+    fs::create_directories(directory_, ec);
+
+    // Copy rather than link, so later edits to `artifact` cannot reach the cache.
+    const fs::path temp = directory_ / std::format(
+        "{:016x}.{}.{}.tmp", key, getpid(), g_temp_counter.fetch_add(1, std::memory_order_relaxed));
+    if (!ec) fs::copy_file(artifact, temp, fs::copy_options::overwrite_existing, ec);
+    if (!ec) fs::rename(temp, EntryPath(key), ec);
+    if (ec) {
+        utility::Logger::Warn(std::format(
+            "ArtifactCache: Could not store '{}': {}", artifact.string(), ec.message()));
+        fs::remove(temp, ec);
+        return;
+    }
+
+    Evict();
+}
+
+void ArtifactCache::Evict() {
+    struct Entry {
+        fs::path path;
+        uint64_t size;
+        fs::file_time_type last_used;
+    };
+
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+    std::error_code ec;
+    for (const auto& dirent : fs::directory_iterator(directory_, ec)) {
+        if (dirent.path().extension() != kEntryExtension) continue;
+        std::error_code entry_ec;
+        const uint64_t size = dirent.file_size(entry_ec);
+        const auto mtime = dirent.last_write_time(entry_ec);
+        if (entry_ec) continue;
+        entries.push_back({dirent.path(), size, mtime});
+        total += size;
+    }
+    if (total <= max_bytes_) return;
+
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.last_used < b.last_used; });
+
+    for (const auto& e : entries) {
+        if (total <= max_bytes_) break;
+        // A concurrent process may have removed it already; count only our own.
+        if (fs::remove(e.path, ec)) g_evictions.fetch_add(1, std::memory_order_relaxed);
+        total -= e.size;
+    }
+}
+
+ArtifactCacheStats ArtifactCache::ProcessStats() {
+    return {g_hits.load(std::memory_order_relaxed),
+            g_misses.load(std::memory_order_relaxed),
+            g_evictions.load(std::memory_order_relaxed)};
+}
+
+}  // namespace seecpp::backend
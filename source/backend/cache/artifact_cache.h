@@ -0,0 +1,48 @@
+#ifndef SEECPP_BACKEND_SRC_CACHE_ARTIFACT_CACHE_H_
+#define SEECPP_BACKEND_SRC_CACHE_ARTIFACT_CACHE_H_
+
+#include <cstdint>
+#include <filesystem>
+
+namespace seecpp::backend {
+
+/// @brief Process-wide counters, summed over every ArtifactCache instance.
+struct ArtifactCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+};
+
+/// @brief A local, content-addressed store of finished .see files.
+///
+/// Entries are named by a 64-bit key that the caller derives from everything
+/// that influences the artifact. Hits are materialized as a hard link (or a
+/// copy across filesystems); entries are published with an atomic rename so
+/// several compiler processes can share one directory. When the directory
+/// grows past `max_bytes`, the least recently used entries are deleted.
+class ArtifactCache {
+ public:
+    ArtifactCache(std::filesystem::path directory, uint64_t max_bytes);
+
+    /// @brief Places the artifact stored under `key` at `output`, linked or
+    /// copied to a temporary name and then renamed over it.
+    /// @return False on a miss, or if the entry could not be materialized.
+    bool Fetch(uint64_t key, const std::filesystem::path& output);
+
+    /// @brief Copies `artifact` into the cache under `key`, then evicts.
+    /// Failures are logged and otherwise ignored; caching is best-effort.
+    void Store(uint64_t key, const std::filesystem::path& artifact);
+
+    static ArtifactCacheStats ProcessStats();
+
+ private:
+    std::filesystem::path EntryPath(uint64_t key) const;
+    void Evict();
+
+    std::filesystem::path directory_;
+    uint64_t max_bytes_;
+};
+
+}  // namespace seecpp::backend
+
+#endif  // SEECPP_BACKEND_SRC_CACHE_ARTIFACT_CACHE_H_
@@ -2,39 +2,160 @@
 
 // The pipeline components we built
 #include "src/lowering/instruction_selector.h"
+#include "src/lowering/cost_annotator.h"
 #include "src/memory/offset_binder.h"
 #include "src/weights/weight_packer.h"
 #include "src/serialization/serializer.h"
+#include "src/serialization/schema.h"
+#include "src/cache/artifact_cache.h"
 
 // Utilities
 #include "include/utility/logger.h"
+#include "seecpp/utility/compilation_context.h"
+#include "seecpp/utility/stable_hash.h"
+#include "seecpp/utility/time_report.h"
 #include "seecpp/utility/weight_buffer.h"
 #include "seecpp/sir/sir.h"
 
+#include <algorithm>
 #include <format>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace seecpp::backend {
 
-std::expected<void, CodegenError> CodegenDriver::Run(
+namespace {
+
+#if defined(__x86_64__) || defined(_M_X64)
+constexpr std::string_view kHostArch = "x86_64";
+#elif defined(__aarch64__) || defined(_M_ARM64)
+constexpr std::string_view kHostArch = "aarch64";
+#else
+constexpr std::string_view kHostArch = "generic";
+#endif
+
+void HashShape(utility::StableHasher& h, const sir::Value& v) {
+    h.Update(v.dtype());
+    h.Update(v.shape().dims.size());
+    for (int64_t d : v.shape().dims) h.Update(d);
+}
+
+/// @brief Derives the artifact cache key of an optimized block.
+///
+/// Values are numbered by position rather than by their printed ids, which
+/// come from a process-wide counter and differ from run to run. The middle-end
+/// has already run, so the block reflects both the ONNX graph and the pass
+/// options that shaped it. A hit therefore saves only the backend: the cache
+/// belongs to CodegenDriver, which never sees the model file.
+uint64_t ComputeCacheKey(const sir::Block& block,
+                         const utility::WeightBuffer& weights,
+                         const CodegenOptions& options) {
+    utility::StableHasher h;
+    h.Update(kCurrentVersion);
+    h.Update(kHostArch);
+    h.Update(options.large_weight_threshold);
+    h.Update(options.large_weight_alignment);
+    // Everything that changes the bytes written; checksum_threads does not.
+    const SerializerOptions& layout = options.serializer;
+    h.Update(static_cast<uint32_t>(layout.encoding));
+    h.Update(layout.rodata_alignment);
+    h.Update(layout.emit_source_info);
+    h.Update(layout.emit_weight_names);
+    h.Update(layout.checksum_sections);
+
+    std::unordered_map<const sir::Value*, uint32_t> numbering;
+    auto define = [&](const sir::Value& v) {
+        numbering.emplace(&v, static_cast<uint32_t>(numbering.size()));
+        HashShape(h, v);
+    };
+
+    for (const auto& arg : block.arguments()) define(*arg);
+    std::unordered_set<std::string> hashed_weights;
+
+    for (const auto& op : block.operations()) {
+        h.Update(op->mnemonic());
+
+        h.Update(op->numOperands());
+        for (const sir::Value* operand : op->operands()) {
+            auto it = numbering.find(operand);
+            h.Update(it != numbering.end() ? it->second : UINT32_MAX);
+
+            // Weight content, not just the name, decides whether the rodata
+            // matches. Same rule as WeightPacker: any operand whose id names
+            // a weight is packed, block arguments included.
+            const std::string tensor_id(operand->id());
+            if (!weights.Contains(tensor_id) || !hashed_weights.insert(tensor_id).second) continue;
+            if (auto bytes = weights.GetRawBytes(tensor_id)) {
+                h.Update(bytes->size());
+                h.Update(*bytes);
+            }
+        }
+
+        h.Update(op->numResults());
+        for (const auto& result : op->results()) define(*result);
+
+        // Attribute IDs depend on interning order, which varies between runs.
+        std::vector<std::pair<std::string_view, const sir::AttributeValue*>> attrs;
+        for (const auto& [id, value] : op->attributes().entries()) {
+            attrs.emplace_back(sir::OpRegistry::Get().AttrName(id), &value);
+        }
+        std::sort(attrs.begin(), attrs.end());
+
+        for (const auto& [key, value_ptr] : attrs) {
+            const sir::AttributeValue& value = *value_ptr;
+            h.Update(key);
+            h.Update(value.index());
+            std::visit([&](const auto& v) {
+                using T = std::decay_t<decltype(v)>;
+                if constexpr (std::is_same_v<T, std::string>) {
+                    h.Update(std::string_view(v));
+                } else if constexpr (std::is_arithmetic_v<T>) {
+                    h.Update(v);
+                } else {
+                    h.Update(v.size());
+                    for (auto e : v) h.Update(e);
+                }
+            }, value);
+        }
+    }
+    return h.Digest();
+}
+
+// The output of phases 1-3, shared by full compiles and weight refreshes.
+struct LoweredModel {
+    uint64_t arena_size;
+    PackedWeights packed;
+};
+
+std::expected<LoweredModel, CodegenError> Lower(
     sir::Block& block,
     const utility::WeightBuffer& weights,
-    std::string_view output_file) 
+    const CodegenOptions& options,
+    utility::TimeReport* report)
 {
-    utility::Logger::Info(std::format(
-        "CodegenDriver: Starting AOT compilation to '{}'", output_file
-    ));
-
     // =========================================================================
     // Phase 1: Instruction Selection
     // Lowers abstract math operations into hardware-specific execution opcodes.
     // =========================================================================
     utility::Logger::Info("CodegenDriver: [1/4] Running Instruction Selector...");
-    InstructionSelector selector;
-    if (auto res = selector.Run(block); !res) {
-        return std::unexpected(CodegenError{
-            "instruction_selection", 
-            std::format("Failed to select instructions: {}", res.error().message)
-        });
+    {
+        utility::TimeReport::Scope timer(report, "instruction_selection", "backend", &block);
+        InstructionSelector selector;
+        if (auto res = selector.Run(block); !res) {
+            return std::unexpected(CodegenError{
+                "instruction_selection", 
+                std::format("Failed to select instructions: {}", res.error().message)
+            });
+        }
+    }
+
+    // FLOPs and bytes moved per instruction, for the runtime's roofline report.
+    {
+        utility::TimeReport::Scope timer(report, "cost_annotation", "backend", &block);
+        CostAnnotator annotator;
+        annotator.Run(block);
     }
 
     // =========================================================================
@@ -42,47 +163,170 @@ std::expected<void, CodegenError> CodegenDriver::Run(
     // Calculates absolute byte offsets for all intermediate tensors.
     // =========================================================================
     utility::Logger::Info("CodegenDriver: [2/4] Running Offset Binder...");
-    OffsetBinder binder;
-    auto bind_result = binder.Run(block);
-    if (!bind_result) {
-        return std::unexpected(CodegenError{
-            "offset_binding", 
-            std::format("Failed to bind memory offsets: {}", bind_result.error().message)
-        });
+    uint64_t required_arena_size = 0;
+    {
+        utility::TimeReport::Scope timer(report, "offset_binding", "backend", &block);
+        OffsetBinder binder;
+        auto bind_result = binder.Run(block);
+        if (!bind_result) {
+            return std::unexpected(CodegenError{
+                "offset_binding", 
+                std::format("Failed to bind memory offsets: {}", bind_result.error().message)
+            });
+        }
+        required_arena_size = bind_result.value();
     }
-    const uint64_t required_arena_size = bind_result.value();
 
     // =========================================================================
     // Phase 3: Weight Packing
-    // Flattens, deduplicates, and aligns constants into a binary blob.
+    // Deduplicates and aligns constants into a rodata layout. The layout borrows 
+    // the bytes from `weights`; nothing is copied until the Serializer streams it.
     // =========================================================================
     utility::Logger::Info("CodegenDriver: [3/4] Running Weight Packer...");
+    utility::TimeReport::Scope timer(report, "weight_packing", "backend", &block);
     WeightPacker packer;
-    auto pack_result = packer.Run(block, weights);
+    PackingOptions packing_options;
+    packing_options.large_tensor_threshold = options.large_weight_threshold;
+    packing_options.large_tensor_alignment = options.large_weight_alignment;
+    auto pack_result = packer.Run(block, weights, packing_options);
     if (!pack_result) {
         return std::unexpected(CodegenError{
             "weight_packing", 
             std::format("Failed to pack weights: {}", pack_result.error().message)
         });
     }
-    // Extract the packed payload and symbol table
-    const PackedWeights packed_data = std::move(pack_result.value());
+    // Extract the rodata layout and symbol table
+    return LoweredModel{required_arena_size, std::move(pack_result.value())};
+}
+
+}  // namespace
+
+CodegenDriver::CodegenDriver(const utility::CompilationContext& context)
+    : options_{context.options().large_weight_threshold,
+               context.options().large_weight_alignment,
+               context.options().cache_dir,
+               context.options().cache_max_bytes} {}
+
+std::expected<void, CodegenError> CodegenDriver::Run(
+    sir::Block& block,
+    utility::CompilationContext& context,
+    std::string_view output_file)
+{
+    auto result = Compile(block, context.weights(), output_file, &context.time_report());
+    if (!result) {
+        context.diagnostics().Report(utility::DiagnosticSeverity::kError, result.error().phase,
+                                     result.error().message);
+    }
+    // Serialization is the last phase of a compilation.
+    context.WriteTimeReport();
+    return result;
+}
+
+std::expected<void, CodegenError> CodegenDriver::Run(
+    sir::Block& block,
+    const utility::WeightBuffer& weights,
+    std::string_view output_file) 
+{
+    return Compile(block, weights, output_file, nullptr);
+}
+
+std::expected<void, CodegenError> CodegenDriver::Compile(
+    sir::Block& block,
+    const utility::WeightBuffer& weights,
+    std::string_view output_file,
+    utility::TimeReport* report)
+{
+    utility::TimeReport::Scope codegen_timer(report, "codegen", "backend", &block);
+    utility::Logger::Info(std::format(
+        "CodegenDriver: Starting AOT compilation to '{}'", output_file
+    ));
+
+    // =========================================================================
+    // Phase 0: Artifact Cache Lookup
+    // Must hash the block before instruction selection rewrites it.
+    // =========================================================================
+    std::optional<ArtifactCache> cache;
+    uint64_t cache_key = 0;
+    if (!options_.cache_dir.empty()) {
+        utility::TimeReport::Scope timer(report, "cache_lookup", "backend");
+        cache.emplace(options_.cache_dir, options_.cache_max_bytes);
+        cache_key = ComputeCacheKey(block, weights, options_);
+        const bool hit = cache->Fetch(cache_key, std::filesystem::path(output_file));
+
+        const ArtifactCacheStats stats = ArtifactCache::ProcessStats();
+        utility::Logger::Info(std::format(
+            "CodegenDriver: Cache {} for key {:016x} ({} hit(s), {} miss(es), {} eviction(s) in this process)",
+            hit ? "hit" : "miss", cache_key, stats.hits, stats.misses, stats.evictions));
+        if (hit) return {};
+    }
+
+    auto lowered = Lower(block, weights, options_, report);
+    if (!lowered) return std::unexpected(lowered.error());
+    const uint64_t required_arena_size = lowered->arena_size;
+    const PackedWeights& packed_data = lowered->packed;
 
     // =========================================================================
     // Phase 4: Serialization
     // Writes the headers, instruction array, and weights to disk.
     // =========================================================================
     utility::Logger::Info("CodegenDriver: [4/4] Running Serializer...");
-    Serializer serializer;
-    if (auto res = serializer.Run(output_file, block, packed_data, required_arena_size); !res) {
-        return std::unexpected(CodegenError{
-            "serialization", 
-            std::format("Failed to write binary file: {}", res.error().message)
-        });
+    {
+        utility::TimeReport::Scope timer(report, "serialization", "backend", &block);
+        Serializer serializer(options_.serializer);
+        if (auto res = serializer.Run(output_file, block, packed_data, required_arena_size); !res) {
+            return std::unexpected(CodegenError{
+                "serialization", 
+                std::format("Failed to write binary file: {}", res.error().message)
+            });
+        }
     }
 
+    if (cache) cache->Store(cache_key, std::filesystem::path(output_file));
+
     utility::Logger::Info("CodegenDriver: Compilation finished successfully.");
     return {};
 }
 
+std::expected<void, CodegenError> CodegenDriver::RefreshWeights(
+    sir::Block& block,
+    const utility::WeightBuffer& weights,
+    std::string_view see_file)
+{
+    utility::Logger::Info(std::format(
+        "CodegenDriver: Refreshing weights of '{}'", see_file
+    ));
+
+    auto lowered = Lower(block, weights, options_, nullptr);
+    if (!lowered) return std::unexpected(lowered.error());
+
+    // =========================================================================
+    // Phase 4: Rodata Patch
+    // Verifies the graph signature against the existing file, then rewrites 
+    // only its weights.
+    // =========================================================================
+    utility::Logger::Info("CodegenDriver: [4/4] Patching .rodata...");
+    Serializer serializer(options_.serializer);
+    if (auto res = serializer.PatchRodata(see_file, block, lowered->packed, lowered->arena_size); !res) {
+        return std::unexpected(res.error());
+    }
+
+    utility::Logger::Info("CodegenDriver: Weight refresh finished successfully.");
+    return {};
+}
+
+std::expected<void, CodegenError> CodegenDriver::RefreshWeights(
+    const utility::WeightBuffer& weights,
+    std::string_view see_file)
+{
+    utility::Logger::Info(std::format(
+        "CodegenDriver: Refreshing weights of '{}' by name", see_file
+    ));
+    Serializer serializer(options_.serializer);
+    if (auto res = serializer.PatchWeights(see_file, weights); !res) {
+        return std::unexpected(res.error());
+    }
+    utility::Logger::Info("CodegenDriver: Weight refresh finished successfully.");
+    return {};
+}
+
 }  // namespace seecpp::backend
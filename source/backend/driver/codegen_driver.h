@@ -1,15 +1,23 @@
 #ifndef SEECPP_BACKEND_CODEGEN_DRIVER_H_
 #define SEECPP_BACKEND_CODEGEN_DRIVER_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <expected>
+#include <filesystem>
+#include <string>
 #include <string_view>
 
+#include "src/serialization/serializer.h"
+
 // Forward declarations
 namespace seecpp::sir {
 class Block;
 }
 
 namespace seecpp::utility {
+class CompilationContext;
+class TimeReport;
 class WeightBuffer;
 }
 
@@ -20,10 +28,30 @@ struct CodegenError {
     std::string message;
 };
 
+/// @brief User-facing knobs for the backend pipeline.
+struct CodegenOptions {
+    /// @brief Weights of at least this many bytes are placed on their own page 
+    /// in .rodata. Zero keeps the dense 64-byte packing.
+    size_t large_weight_threshold = 0;
+    /// @brief Page boundary for large weights: 4 KiB, or 2 MiB for huge pages.
+    /// Must be a power of two.
+    size_t large_weight_alignment = 4096;
+    /// @brief Directory of the content-addressed .see cache. Empty disables it.
+    /// Keyed on the optimized block, so a hit skips the backend phases only.
+    std::filesystem::path cache_dir;
+    /// @brief Least recently used artifacts are evicted beyond this size.
+    uint64_t cache_max_bytes = uint64_t{4} << 30;
+    /// @brief Layout of the written file: instruction encoding, section
+    /// checksums and the optional sections. Part of the cache key.
+    SerializerOptions serializer;
+};
+
 /// @brief Orchestrates the lowering, packing, and serialization of an ML model.
 class CodegenDriver {
  public:
-    CodegenDriver() = default;
+    explicit CodegenDriver(CodegenOptions options = {}) : options_(options) {}
+    /// @brief Takes the backend knobs from the context's CompilationOptions.
+    explicit CodegenDriver(const utility::CompilationContext& context);
 
     /// @brief Executes the complete backend compilation pipeline.
     /// @param block The optimized Middle-End IR graph.
@@ -34,6 +62,46 @@ class CodegenDriver {
         sir::Block& block,
         const utility::WeightBuffer& weights,
         std::string_view output_file);
+
+    /// @brief Runs the pipeline on the weights owned by `context`, and records
+    /// any failure in its diagnostics as well as returning it. Each phase is
+    /// timed into the context's TimeReport, which is written afterwards.
+    [[nodiscard]] std::expected<void, CodegenError> Run(
+        sir::Block& block,
+        utility::CompilationContext& context,
+        std::string_view output_file);
+
+    /// @brief Fast path for a retrained checkpoint: replaces only the weights of 
+    /// an existing .see file compiled from the same graph.
+    /// @param block The optimized IR of the new model.
+    /// @param weights The new weights.
+    /// @param see_file The previously compiled artifact, replaced by rename().
+    /// @return A CodegenError with phase "weights_refresh" if the graph, arena 
+    ///         layout or weight shapes differ from those in `see_file`.
+    [[nodiscard]] std::expected<void, CodegenError> RefreshWeights(
+        sir::Block& block,
+        const utility::WeightBuffer& weights,
+        std::string_view see_file);
+
+    /// @brief Fastest path for a retrained checkpoint: replaces the weights of 
+    /// `see_file` by name, without the graph or any lowering. Fill `weights` 
+    /// from a weight file, or from an ONNX model with 
+    /// frontend::ProtobufReader::ingestWeights().
+    /// @return A CodegenError with phase "weights_refresh" if `see_file` has no 
+    ///         weight names, or a weight is missing or changed size. Use the 
+    ///         overload above for those.
+    [[nodiscard]] std::expected<void, CodegenError> RefreshWeights(
+        const utility::WeightBuffer& weights,
+        std::string_view see_file);
+
+ private:
+    std::expected<void, CodegenError> Compile(
+        sir::Block& block,
+        const utility::WeightBuffer& weights,
+        std::string_view output_file,
+        utility::TimeReport* report);
+
+    CodegenOptions options_;
 };
 
 }  // namespace seecpp::backend
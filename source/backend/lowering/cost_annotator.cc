@@ -0,0 +1,148 @@
+#include "src/lowering/cost_annotator.h"
+#include "include/utility/logger.h"
+
+#include "seecpp/sir/sir.h"
+
+#include <algorithm>
+#include <format>
+#include <set>
+#include <string>
+#include <string_view>
+
+namespace seecpp::backend {
+
+namespace {
+
+uint64_t Elements(const sir::Value& v) {
+    const int64_t volume = v.shape().volume();
+    return volume > 0 ? static_cast<uint64_t>(volume) : 0;
+}
+
+uint64_t MatMulFlops(const sir::Operation& op, uint64_t outputs) {
+    const auto& a = op.operand(0)->shape().dims;
+    const uint64_t k = a.empty() || a.back() < 0 ? 0 : static_cast<uint64_t>(a.back());
+    return 2 * outputs * k;
+}
+
+// Elements one pooling window covers, from kernel_shape.
+uint64_t WindowSize(const sir::Operation& op) {
+    const auto kernel = op.getAttrAs<std::vector<int64_t>>(sir::attr::kKernelShape);
+    if (!kernel || kernel->empty()) return 0;
+    uint64_t size = 1;
+    for (int64_t d : *kernel) size *= d > 0 ? static_cast<uint64_t>(d) : 0;
+    return size;
+}
+
+// Elementwise steps of a fused chain, e.g. "add,relu" is two.
+uint64_t FusedSteps(const sir::Operation& op) {
+    const auto sequence = op.getAttrAs<std::string>(sir::attr::kOpSequence);
+    if (!sequence || sequence->empty()) return 1;
+    return 1 + static_cast<uint64_t>(std::count(sequence->begin(), sequence->end(), ','));
+}
+
+}  // namespace
+
+OpCost CostAnnotator::Estimate(const sir::Operation& op) {
+    OpCost cost;
+    for (const sir::Value* operand : op.operands()) {
+        cost.bytes_read += operand->shape().byteSize(operand->dtype());
+    }
+    uint64_t outputs = 0;
+    for (const auto& result : op.results()) {
+        cost.bytes_written += result->shape().byteSize(result->dtype());
+        outputs += Elements(*result);
+    }
+
+    switch (op.opId()) {
+        // [..., M, K] x [..., K, N]: one multiply-add per output per K.
+        case sir::op::kLowMatMul:
+        case sir::op::kMatMul:
+            cost.flops = MatMulFlops(op, outputs);
+            break;
+        case sir::op::kGemm:
+            cost.flops = MatMulFlops(op, outputs);
+            if (op.numOperands() > 2) cost.flops += outputs;  // Bias
+            break;
+        // The filter is [F, C/group, KH, KW]; each output sums one filter row.
+        case sir::op::kLowConv2d:
+        case sir::op::kConv2d: {
+            const sir::Value* filter = op.operand(1);
+            const auto& dims = filter->shape().dims;
+            const uint64_t per_output = dims.empty() || dims.front() <= 0
+                ? 0 : Elements(*filter) / static_cast<uint64_t>(dims.front());
+            cost.flops = 2 * outputs * per_output;
+            if (op.numOperands() > 2) cost.flops += outputs;  // Bias
+            break;
+        }
+        case sir::op::kAdd:
+        case sir::op::kSub:
+        case sir::op::kMul:
+        case sir::op::kDiv:
+        case sir::op::kPow:
+        case sir::op::kRelu:
+        case sir::op::kLowRelu:
+            cost.flops = outputs;
+            break;
+        case sir::op::kFusedEw:
+            cost.flops = outputs * FusedSteps(op);
+            break;
+        // Inference batch norm folds to one multiply-add per element.
+        case sir::op::kBatchNorm:
+            cost.flops = 2 * outputs;
+            break;
+        case sir::op::kMaxPool:
+            cost.flops = outputs * WindowSize(op);
+            break;
+        case sir::op::kAvgPool:
+            cost.flops = outputs * (WindowSize(op) + 1);  // Sum, then divide
+            break;
+        // One add per input element: summed into its output, or, for col2im,
+        // into the pixel its patch overlaps.
+        case sir::op::kLowReduceSum:
+        case sir::op::kLowCol2Im:
+            cost.flops = Elements(*op.operand(0));
+            break;
+        // Data movement and structure only.
+        case sir::op::kConstant:
+        case sir::op::kReshape:
+        case sir::op::kTranspose:
+        case sir::op::kConcat:
+        case sir::op::kLowTranspose:
+        case sir::op::kLowIm2Col:
+        case sir::op::kLowViewCast:
+        case sir::op::kReturn:
+        case sir::op::kLowReturn:
+        case sir::op::kYield:
+            break;
+        default:
+            cost.flops_known = false;
+            break;
+    }
+    return cost;
+}
+
+void CostAnnotator::Run(sir::Block& block) {
+    uint64_t total_flops = 0;
+    uint64_t total_bytes = 0;
+    std::set<std::string_view> unknown;
+    block.walk([&](sir::Operation* op) {
+        const OpCost cost = Estimate(*op);
+        if (!cost.flops_known) unknown.insert(op->mnemonic());
+        op->setAttribute(sir::attr::kFlops, static_cast<int64_t>(cost.flops));
+        op->setAttribute(sir::attr::kBytesRead, static_cast<int64_t>(cost.bytes_read));
+        op->setAttribute(sir::attr::kBytesWritten, static_cast<int64_t>(cost.bytes_written));
+        total_flops += cost.flops;
+        total_bytes += cost.bytes_read + cost.bytes_written;
+    });
+
+    for (std::string_view mnemonic : unknown) {
+        utility::Logger::Warn(std::format(
+            "CostAnnotator: No FLOP model for '{}'; its instructions count 0 FLOPs", mnemonic));
+    }
+    utility::Logger::Info(std::format(
+        "CostAnnotator: {:.3f} GFLOP and {:.3f} GB per step ({:.2f} FLOP/byte)",
+        total_flops * 1e-9, total_bytes * 1e-9,
+        total_bytes > 0 ? static_cast<double>(total_flops) / total_bytes : 0.0));
+}
+
+} // namespace seecpp::backend
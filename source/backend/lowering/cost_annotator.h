@@ -0,0 +1,47 @@
+#ifndef SEECPP_BACKEND_SRC_LOWERING_COST_ANNOTATOR_H_
+#define SEECPP_BACKEND_SRC_LOWERING_COST_ANNOTATOR_H_
+
+#include <cstdint>
+
+// Forward declarations for the SeeC++ core IR
+namespace seecpp::sir {
+    class Block;
+    class Operation;
+}
+
+namespace seecpp::backend {
+
+/// @brief The arithmetic and memory traffic of one lowered operation.
+struct OpCost {
+    uint64_t flops = 0;          // A multiply-accumulate counts as 2.
+    uint64_t bytes_read = 0;     // Every operand once, weights included.
+    uint64_t bytes_written = 0;  // Every result once.
+    bool flops_known = true;     // False for ops with no FLOP model; flops is then 0.
+};
+
+/// @brief Computes each operation's FLOPs and bytes moved from its operand and
+/// result shapes, and stores them as the "flops", "bytes_read" and
+/// "bytes_written" attributes for the Serializer's cost table.
+///
+/// Runs after the InstructionSelector, when the block holds exactly the ops
+/// that become instructions. Traffic is the compulsory minimum (each tensor
+/// touched once), so a kernel that re-reads its inputs from DRAM shows up as
+/// a low fraction of the roofline rather than as a higher byte count.
+/// Elementwise ops count one FLOP per output element (per fused step for
+/// sc_high.fused_ew), reductions one per input element, and pure data
+/// movement none. Ops without a model are reported once per Run().
+class CostAnnotator {
+public:
+    CostAnnotator() = default;
+
+    /// @brief Annotates every operation of the block. Dynamic dimensions
+    /// count as zero; such blocks cannot be serialized anyway.
+    void Run(sir::Block& block);
+
+    /// @brief The cost of a single operation, without annotating it.
+    static OpCost Estimate(const sir::Operation& op);
+};
+
+} // namespace seecpp::backend
+
+#endif // SEECPP_BACKEND_SRC_LOWERING_COST_ANNOTATOR_H_
@@ -49,51 +49,47 @@ InstructionSelector::run(sir::Block& block, TargetArch arch) {
 
 std::expected<void, CodegenError>
 InstructionSelector::lowerOperation(sir::Operation* op, TargetArch arch) {
-    const std::string mnemonic = op->mnemonic();
-    BackendOpcode selected_opcode = BackendOpcode::INVALID;
+    // Pick the AVX-512, NEON or scalar variant of a kernel family.
+    auto for_arch = [arch](BackendOpcode avx512, BackendOpcode neon, BackendOpcode scalar) {
+        return arch == TargetArch::x86_64_AVX512 ? avx512
+             : arch == TargetArch::ARM_NEON      ? neon
+                                                 : scalar;
+    };
 
-    // --- 1. Lower Matrix Multiplication (GEMM) ---
-    if (mnemonic == "sc_low.matmul") {
-        if (arch == TargetArch::x86_64_AVX512) {
-            selected_opcode = BackendOpcode::AVX512_GEMM_FP32;
-        } else if (arch == TargetArch::ARM_NEON) {
-            selected_opcode = BackendOpcode::NEON_GEMM_FP32;
-        } else {
-            selected_opcode = BackendOpcode::SCALAR_GEMM_FP32;
-        }
-    }
-    // --- 2. Lower Convolutions ---
-    else if (mnemonic == "sc_low.conv2d" || mnemonic == "sc_high.conv2d") {
-        if (arch == TargetArch::x86_64_AVX512) {
-            selected_opcode = BackendOpcode::AVX512_CONV2D_FP32;
-        } else if (arch == TargetArch::ARM_NEON) {
-            selected_opcode = BackendOpcode::NEON_CONV2D_FP32;
-        } else {
-            selected_opcode = BackendOpcode::SCALAR_CONV2D_FP32;
-        }
-    }
-    // --- 3. Lower Activations ---
-    else if (mnemonic == "sc_low.relu") {
-        if (arch == TargetArch::x86_64_AVX512) {
-            selected_opcode = BackendOpcode::AVX512_RELU_FP32;
-        } else if (arch == TargetArch::ARM_NEON) {
-            selected_opcode = BackendOpcode::NEON_RELU_FP32;
-        } else {
-            selected_opcode = BackendOpcode::SCALAR_RELU_FP32;
-        }
-    }
-    // --- 4. Unrecognized Operation Error ---
-    else {
-        return std::unexpected(CodegenError{
-            "instruction_selection",
-            std::format("Backend selector encountered unhandled instruction mnemonic '{}'", mnemonic)
-        });
+    BackendOpcode selected_opcode = BackendOpcode::INVALID;
+    switch (op->opId()) {
+        // --- 1. Lower Matrix Multiplication (GEMM) ---
+        case sir::op::kLowMatMul:
+            selected_opcode = for_arch(BackendOpcode::AVX512_GEMM_FP32,
+                                       BackendOpcode::NEON_GEMM_FP32,
+                                       BackendOpcode::SCALAR_GEMM_FP32);
+            break;
+        // --- 2. Lower Convolutions ---
+        case sir::op::kLowConv2d:
+        case sir::op::kConv2d:
+            selected_opcode = for_arch(BackendOpcode::AVX512_CONV2D_FP32,
+                                       BackendOpcode::NEON_CONV2D_FP32,
+                                       BackendOpcode::SCALAR_CONV2D_FP32);
+            break;
+        // --- 3. Lower Activations ---
+        case sir::op::kLowRelu:
+            selected_opcode = for_arch(BackendOpcode::AVX512_RELU_FP32,
+                                       BackendOpcode::NEON_RELU_FP32,
+                                       BackendOpcode::SCALAR_RELU_FP32);
+            break;
+        // --- 4. Unrecognized Operation Error ---
+        default:
+            return std::unexpected(CodegenError{
+                "instruction_selection",
+                std::format("Backend selector encountered unhandled instruction mnemonic '{}'", 
+                            op->mnemonic())
+            });
     }
 
     // --- 5. Bind the raw numeric value back to the IR operation attributes ---
     // Storing as a standard primitive type allows the final serializer to read 
     // it without needing complex deserialization dependencies.
-    op->setAttribute("runtime_opcode", static_cast<int64_t>(selected_opcode));
+    op->setAttribute(sir::attr::kRuntimeOpcode, static_cast<int64_t>(selected_opcode));
 
     ++lowered_count_;
     return {};
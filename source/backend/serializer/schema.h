@@ -2,6 +2,8 @@
 #define SEECPP_BACKEND_SCHEMA_H_
 
 #include <cstdint>
+#include <span>
+#include <string_view>
 
 namespace seecpp::backend {
 
@@ -12,8 +14,46 @@ namespace seecpp::backend {
 // "SEE!" in little-endian ASCII (0x21454553)
 inline constexpr uint32_t kSeeMagic = 0x21454553; 
 
-// Increment this whenever the schema structs change to prevent segfaults
-inline constexpr uint32_t kCurrentVersion = 1;
+// Increment this whenever the schema structs change to prevent segfaults. 
+// New optional sections do not need a bump; see SectionEntry.
+inline constexpr uint32_t kCurrentVersion = 2;
+
+// Fixed text/rodata header without a section table. Still accepted by the runtime.
+inline constexpr uint32_t kLegacyVersion = 1;
+
+// =============================================================================
+// Opcodes
+// =============================================================================
+
+/// @brief Operations the runtime executes, as stored in the `opcode` field of
+/// either instruction encoding. Values are part of the file format.
+enum Opcode : uint16_t {
+    kGemv = 10,              // inputs: A (rodata), x, bias (rodata), m<<32|n; outputs: y
+    kRelu = 11,              // inputs: data, element count; in place, no outputs
+};
+
+/// @brief One row of the opcode table.
+struct OpcodeInfo {
+    Opcode opcode;
+    std::string_view name;   // Lower-case mnemonic used in profiles and diagnostics
+    uint8_t min_inputs;      // Operands the runtime reads, before any outputs
+    uint8_t min_outputs;
+};
+
+/// @brief Every opcode the runtime understands. Add a row here before teaching
+/// the interpreter a new opcode; loaders and profilers consult this table.
+inline constexpr OpcodeInfo kOpcodeTable[] = {
+    {kGemv, "gemv", 4, 1},
+    {kRelu, "relu", 2, 0},
+};
+
+/// @brief The table row of `opcode`, or null if the runtime does not know it.
+constexpr const OpcodeInfo* FindOpcode(uint16_t opcode) {
+    for (const OpcodeInfo& info : kOpcodeTable) {
+        if (info.opcode == opcode) return &info;
+    }
+    return nullptr;
+}
 
 // =============================================================================
 // Memory Layout Definitions
@@ -22,11 +62,57 @@ inline constexpr uint32_t kCurrentVersion = 1;
 // Ensure strict packing so the C++ compiler doesn't insert hidden padding bytes.
 #pragma pack(push, 1)
 
-/// @brief The 64-byte master header at byte 0 of the .see file.
+/// @brief The 64-byte master header at byte 0 of the .see file. Everything 
+/// else is found through the SectionEntry table it points to.
 struct FileHeader {
     uint32_t magic;          // 4 bytes: kSeeMagic
     uint32_t version;        // 4 bytes: kCurrentVersion
     
+    uint64_t arena_size;     // 8 bytes: Total bytes to aligned_alloc() at runtime
+    uint64_t instruction_count;     // 8 bytes: Number of instructions to execute
+
+    uint64_t section_table_offset;  // 8 bytes: Absolute file offset of the SectionEntry array
+    uint32_t section_count;         // 4 bytes: Number of SectionEntry records
+    uint32_t flags;                 // 4 bytes: Zero; reserved for whole-file flags
+
+    uint64_t reserved[3];           // 24 bytes: Zero
+};
+
+/// @brief Kinds of section. A runtime skips types it does not know unless 
+/// the entry carries kSectionRequired, in which case it refuses the file.
+enum class SectionType : uint32_t {
+    kText = 1,               // SerializedInstruction array, in execution order
+    kRodata = 2,             // Packed weights, addressed by instruction operands
+    kWeightRefs = 3,         // WeightRef table, for weight streaming
+    kInstructionCost = 4,    // One InstructionCost per instruction
+    kStringTable = 5,        // NUL-terminated UTF-8 strings, starting with ""
+    kSourceInfo = 6,         // One SourceInfo per instruction
+    kCompactText = 7,        // CompactInstruction array; replaces kText
+    kOperandPool = 8,        // uint64_t operands indexed by CompactInstruction
+    kWeightNames = 9,        // WeightName table, for refreshing weights by name
+};
+
+/// @brief Bits of SectionEntry::flags.
+enum SectionFlags : uint32_t {
+    kSectionRequired = 1u << 0,     // Loading must fail if the type is unknown
+    kSectionChecksummed = 1u << 1,  // SectionEntry::checksum is valid
+};
+
+/// @brief A 32-byte entry of the section table. Entries are sorted by offset.
+struct SectionEntry {
+    uint32_t type;           // 4 bytes: A SectionType
+    uint32_t flags;          // 4 bytes: SectionFlags
+    uint64_t offset;         // 8 bytes: Absolute file offset, a multiple of alignment
+    uint64_t size;           // 8 bytes: Length in bytes
+    uint32_t alignment;      // 4 bytes: Power of two the offset honours
+    uint32_t checksum;       // 4 bytes: Valid only with kSectionChecksummed
+};
+
+/// @brief The version 1 header, which fixed the text/rodata pair in place.
+struct LegacyFileHeader {
+    uint32_t magic;          // 4 bytes: kSeeMagic
+    uint32_t version;        // 4 bytes: kLegacyVersion
+    
     uint64_t arena_size;     // 8 bytes: Total bytes to aligned_alloc() at runtime
     
     uint64_t text_offset;    // 8 bytes: Absolute file offset to SerializedInstruction array
@@ -35,7 +121,8 @@ struct FileHeader {
     uint64_t rodata_offset;  // 8 bytes: Absolute file offset to the packed weights
     uint64_t rodata_size;    // 8 bytes: Size of the weight blob in bytes
     
-    uint64_t reserved[2];    // 16 bytes: Padding to pad the header to exactly 64 bytes
+    uint64_t weight_refs_offset;  // 8 bytes: Absolute file offset to the WeightRef table (0 if absent)
+    uint64_t weight_refs_count;   // 8 bytes: Number of WeightRef records
 };
 
 /// @brief A 64-byte instruction block, explicitly designed to fit in a single L1 cache line.
@@ -51,8 +138,69 @@ struct SerializedInstruction {
     uint64_t outputs[3];     // 24 bytes: Destination arena offsets
 };
 
+/// @brief An 8-byte instruction of the compact encoding. Its operands sit 
+/// back to back in the kOperandPool section, inputs first, so an op may have 
+/// any number of them and a two-operand RELU costs 8 + 2 * 8 = 24 bytes instead of 64.
+/// Decoding is two loads and an add: inputs = pool + operand_index, 
+/// outputs = inputs + num_inputs.
+struct CompactInstruction {
+    uint16_t opcode;         // 2 bytes: Hardware operation, as in SerializedInstruction
+    uint8_t num_inputs;      // 1 byte:  Input operands
+    uint8_t num_outputs;     // 1 byte:  Output operands
+    uint32_t operand_index;  // 4 bytes: Index of the first operand in the pool
+};
+
+/// @brief A 24-byte record naming one rodata range read by one instruction.
+/// Records are sorted by instruction index. The interpreter never reads them; 
+/// they exist so a streaming runtime can prefetch and evict weights in step order.
+struct WeightRef {
+    uint32_t instruction;    // 4 bytes: Index into the SerializedInstruction array
+    uint32_t reserved;       // 4 bytes: Keeps the 64-bit fields naturally aligned
+    uint64_t rodata_offset;  // 8 bytes: Byte offset from the start of the kRodata section
+    uint64_t size;           // 8 bytes: Length of the tensor in bytes
+};
+
+/// @brief A 24-byte record of the work one instruction does, computed by the 
+/// CostAnnotator from operand shapes. Lets profilers place each instruction on a 
+/// roofline without decoding its operands.
+struct InstructionCost {
+    uint64_t flops;          // 8 bytes: Floating-point operations (an FMA counts as 2)
+    uint64_t bytes_read;     // 8 bytes: Operand bytes, weights included
+    uint64_t bytes_written;  // 8 bytes: Result bytes
+};
+
+/// @brief A 24-byte record naming where one instruction came from. Every field 
+/// is a byte offset into the kStringTable section, whose offset 0 holds "".
+struct SourceInfo {
+    uint32_t node_name;      // 4 bytes: ONNX node name(s), "+"-joined when fused
+    uint32_t op_type;        // 4 bytes: ONNX op type(s), e.g. "Conv+BatchNormalization"
+    uint32_t sir_op;         // 4 bytes: SIR mnemonic at selection, e.g. "sc_low.matmul"
+    uint32_t op_sequence;    // 4 bytes: Fused elementwise chain, "" unless fused
+    uint32_t shapes;         // 4 bytes: e.g. "f32[1,64], f32[64,10] -> f32[1,10]"
+    uint32_t reserved;       // 4 bytes: Zero
+};
+
+/// @brief A 24-byte record naming the rodata range of one weight. `name` is a 
+/// byte offset into the kStringTable section. Weights the packer deduplicated 
+/// have one record each, with the same range. Records are sorted by name.
+struct WeightName {
+    uint32_t name;           // 4 bytes: The weight's tensor ID, e.g. the ONNX initializer name
+    uint32_t reserved;       // 4 bytes: Zero
+    uint64_t rodata_offset;  // 8 bytes: Byte offset from the start of the kRodata section
+    uint64_t size;           // 8 bytes: Length of the tensor in bytes
+};
+
 #pragma pack(pop)
 
+/// @brief The entry of the given type, or null. Tables hold a handful of 
+/// entries, so a scan beats any index.
+inline const SectionEntry* FindSection(std::span<const SectionEntry> table, SectionType type) {
+    for (const SectionEntry& entry : table) {
+        if (entry.type == static_cast<uint32_t>(type)) return &entry;
+    }
+    return nullptr;
+}
+
 // =============================================================================
 // Compile-Time Layout Validation
 // =============================================================================
@@ -65,6 +213,24 @@ static_assert(sizeof(FileHeader) == 64,
 static_assert(sizeof(SerializedInstruction) == 64, 
     "SerializedInstruction must be exactly 64 bytes to prevent cache-line spanning.");
 
+static_assert(sizeof(CompactInstruction) == 8, 
+    "CompactInstruction must be exactly 8 bytes; eight share a cache line.");
+
+static_assert(sizeof(WeightRef) == 24, 
+    "WeightRef must be exactly 24 bytes to keep the table densely packed.");
+
+static_assert(sizeof(LegacyFileHeader) == 64, 
+    "LegacyFileHeader must match the version 1 layout byte for byte.");
+
+static_assert(sizeof(SectionEntry) == 32, 
+    "SectionEntry must be exactly 32 bytes so two share a cache line.");
+
+static_assert(sizeof(InstructionCost) == 24 && sizeof(SourceInfo) == 24,
+    "Per-instruction records must keep their on-disk sizes.");
+
+static_assert(sizeof(WeightName) == 24, 
+    "WeightName must be exactly 24 bytes to keep the table densely packed.");
+
 }  // namespace seecpp::backend
 
 #endif  // SEECPP_BACKEND_SCHEMA_H_
@@ -1,38 +1,244 @@
 #include "source/serialization/serializer.h"
 #include "source/serialization/schema.h"
 #include "source/weights/weight_packer.h" // For PackedWeights struct
+#include "include/utility/crc32c.h"
 #include "include/utility/logger.h"
+#include "include/utility/thread_pool.h"
 
 #include "seecpp/sir/sir.h"
+#include "seecpp/utility/weight_buffer.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
 #include <format>
-#include <fstream>
+#include <map>
+#include <span>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
+// POSIX gather I/O
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
 namespace seecpp::backend {
 
 namespace {
-// Helper to pad file streams to specific byte boundaries for cache-line alignment
-void WritePadding(std::ofstream& file, size_t current_offset, size_t alignment) {
-    const size_t aligned_offset = (current_offset + alignment - 1) & ~(alignment - 1);
-    const size_t padding_bytes = aligned_offset - current_offset;
-    if (padding_bytes > 0) {
-        std::vector<char> pad(padding_bytes, 0);
-        file.write(pad.data(), pad.size());
+// Reads exactly `size` bytes at `offset`. Returns 0 on success, or an errno
+// (EIO for a file that ends early).
+int ReadAt(int fd, void* dst, size_t size, uint64_t offset) {
+    auto* out = static_cast<uint8_t*>(dst);
+    while (size > 0) {
+        const ssize_t n = pread(fd, out, size, static_cast<off_t>(offset));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return errno;
+        }
+        if (n == 0) return EIO;
+        out += n;
+        size -= static_cast<size_t>(n);
+        offset += static_cast<uint64_t>(n);
+    }
+    return 0;
+}
+
+// Reads the section table `header` points to. Both counts and offsets are
+// untrusted, so the table and every section must lie within the file before
+// anything is sized from them. Returns 0 or an errno (EIO if they do not).
+int ReadSectionTable(int fd, const FileHeader& header, std::vector<SectionEntry>& sections) {
+    struct stat sb;
+    if (fstat(fd, &sb) != 0) return errno;
+    const auto file_size = static_cast<uint64_t>(sb.st_size);
+    if (header.section_table_offset > file_size ||
+        header.section_count > (file_size - header.section_table_offset) / sizeof(SectionEntry)) {
+        return EIO;
+    }
+    sections.resize(header.section_count);
+    if (int err = ReadAt(fd, sections.data(), sections.size() * sizeof(SectionEntry),
+                         header.section_table_offset); err != 0) {
+        return err;
+    }
+    for (const SectionEntry& section : sections) {
+        if (section.size > file_size || section.offset > file_size - section.size) return EIO;
+    }
+    return 0;
+}
+
+// A contiguous run of bytes destined for an absolute file offset.
+struct Segment {
+    uint64_t file_offset;
+    const void* data;
+    size_t size;
+};
+
+// Gather-writes segments (sorted by file_offset) with one pwritev() per 
+// contiguous run. Gaps between runs are never written: they read back as 
+// zeros and, on most filesystems, cost no disk blocks.
+// Returns 0 on success, or the errno of the failing call (EIO if a call
+// writes nothing).
+int WriteSegments(int fd, std::span<const Segment> segments) {
+    size_t i = 0;
+    while (i < segments.size()) {
+        // Collect the longest contiguous run starting at segments[i]
+        std::vector<iovec> iov;
+        const uint64_t run_offset = segments[i].file_offset;
+        uint64_t run_end = run_offset;
+        for (; i < segments.size() && segments[i].file_offset == run_end &&
+               iov.size() < IOV_MAX; ++i) {
+            if (segments[i].size == 0) continue;
+            iov.push_back({const_cast<void*>(segments[i].data), segments[i].size});
+            run_end += segments[i].size;
+        }
+
+        // pwritev may write short; advance through the iovecs until drained
+        uint64_t offset = run_offset;
+        size_t first = 0;
+        while (first < iov.size()) {
+            const ssize_t written = pwritev(fd, iov.data() + first,
+                                            static_cast<int>(iov.size() - first),
+                                            static_cast<off_t>(offset));
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return errno;
+            }
+            // No progress and no error would otherwise retry forever.
+            if (written == 0) return EIO;
+            offset += static_cast<uint64_t>(written);
+            for (size_t remaining = static_cast<size_t>(written); remaining > 0;) {
+                if (remaining >= iov[first].iov_len) {
+                    remaining -= iov[first].iov_len;
+                    ++first;
+                } else {
+                    iov[first].iov_base = static_cast<uint8_t*>(iov[first].iov_base) + remaining;
+                    iov[first].iov_len -= remaining;
+                    remaining = 0;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+// Makes a rename into the directory of `path` durable. Best-effort: some
+// filesystems do not support fsync() on directories.
+void SyncParentDirectory(const std::string& path) {
+    const size_t slash = path.rfind('/');
+    const std::string dir = slash == std::string::npos ? "." : path.substr(0, slash + 1);
+    const int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd == -1) return;
+    fsync(fd);
+    close(fd);
+}
+
+// The in-memory bytes of a section of `image`. Null for .rodata, whose bytes 
+// the packer owns.
+template <typename Image>
+const void* SectionData(const Image& image, SectionType type) {
+    switch (type) {
+        case SectionType::kText:            return image.text.data();
+        case SectionType::kCompactText:     return image.compact_text.data();
+        case SectionType::kOperandPool:     return image.operand_pool.data();
+        case SectionType::kWeightRefs:      return image.weight_refs.data();
+        case SectionType::kInstructionCost: return image.costs.data();
+        case SectionType::kStringTable:     return image.strings.data();
+        case SectionType::kSourceInfo:      return image.source_info.data();
+        case SectionType::kWeightNames:     return image.weight_names.data();
+        case SectionType::kRodata:          return nullptr;
     }
+    return nullptr;
+}
+
+// Adds the header, the section table and every section, in file order. .rodata 
+// is written tensor by tensor straight from the packer's borrowed bytes.
+template <typename Image>
+void AppendImageSegments(std::vector<Segment>& segments, const Image& image,
+                         const PackedWeights& weights) {
+    segments.push_back({0, &image.header, sizeof(FileHeader)});
+    segments.push_back({image.header.section_table_offset, image.sections.data(),
+                        image.sections.size() * sizeof(SectionEntry)});
+    for (const SectionEntry& section : image.sections) {
+        const auto type = static_cast<SectionType>(section.type);
+        if (type != SectionType::kRodata) {
+            segments.push_back({section.offset, SectionData(image, type), section.size});
+            continue;
+        }
+        for (const PackedTensor& tensor : weights.layout) {
+            segments.push_back({section.offset + tensor.offset, 
+                                tensor.bytes.data(), tensor.bytes.size()});
+        }
+    }
+}
+
+// "f32[1,64], f32[64,10] -> f32[1,10]"
+std::string FormatShapes(const sir::Operation& op) {
+    std::string out;
+    auto append = [&out](const sir::Value& v) {
+        out += sir::dtypeName(v.dtype());
+        out += '[';
+        for (size_t i = 0; i < v.shape().dims.size(); ++i) {
+            if (i > 0) out += ',';
+            out += std::to_string(v.shape().dims[i]);
+        }
+        out += ']';
+    };
+    for (size_t i = 0; i < op.numOperands(); ++i) {
+        if (i > 0) out += ", ";
+        append(*op.operand(i));
+    }
+    out += " ->";
+    for (size_t i = 0; i < op.numResults(); ++i) {
+        out += i == 0 ? " " : ", ";
+        append(*op.result(i));
+    }
+    return out;
 }
 }  // namespace
 
-std::expected<void, CodegenError> Serializer::Run(
-    std::string_view file_path, 
+Serializer::Serializer(SerializerOptions options) : options_(options) {}
+
+Serializer::~Serializer() = default;
+
+utility::ThreadPool* Serializer::ChecksumPool(uint64_t bytes) const {
+    // Hardware CRC runs at several GB/s, so below this a single thread is done
+    // in about the time it takes to start the workers.
+    constexpr uint64_t kParallelChecksumBytes = uint64_t{16} << 20;
+    if (bytes < kParallelChecksumBytes || options_.checksum_threads == 1) return nullptr;
+    if (!checksum_pool_) checksum_pool_ = std::make_unique<utility::ThreadPool>(options_.checksum_threads);
+    return checksum_pool_.get();
+}
+
+std::expected<Serializer::Image, CodegenError> Serializer::BuildImage(
     const sir::Block& block, 
     const PackedWeights& weights,
-    uint64_t required_arena_size) 
+    uint64_t required_arena_size) const
 {
-    utility::Logger::Info(std::format("Serializer: Writing binary to '{}'", file_path));
-
     // --- 1. Extract and Validate Instructions from IR ---
-    std::vector<SerializedInstruction> text_section;
+    Image image;
+    std::vector<SerializedInstruction>& text_section = image.text;
+    std::vector<WeightRef>& weight_refs = image.weight_refs;
+    std::vector<uint64_t>& operand_pool = image.operand_pool;
+    std::vector<InstructionCost>& costs = image.costs;
+    uint64_t instruction_count = 0;
+    bool all_costed = true;
+
+    // Offset 0 of the string table is the empty string.
+    std::string& strings = image.strings;
+    strings.assign(1, '\0');
+    std::unordered_map<std::string, uint32_t> string_offsets{{"", 0}};
+    auto intern = [&](std::string s) {
+        auto [it, inserted] = string_offsets.try_emplace(std::move(s), static_cast<uint32_t>(strings.size()));
+        if (inserted) {
+            strings += it->first;
+            strings += '\0';
+        }
+        return it->second;
+    };
     std::expected<void, CodegenError> pass_result = {};
 
     block.walk([&](const sir::Operation* op) {
@@ -54,83 +260,483 @@ std::expected<void, CodegenError> Serializer::Run(
 
         const auto& inputs = inputs_opt.value();
         const auto& outputs = outputs_opt.value();
+        const auto inst_index = static_cast<uint32_t>(instruction_count);
 
-        if (inputs.size() > 4 || outputs.size() > 2) {
-            pass_result = std::unexpected(CodegenError{
-                "serialization", 
-                std::format("Operation '{}' exceeds hardware struct limit (max 4 inputs, 2 outputs).", 
-                            op->mnemonic())
+        if (options_.encoding == InstructionEncoding::kCompact) {
+            // Operands go to the shared pool; only the counts bound the op.
+            if (inputs.size() > UINT8_MAX || outputs.size() > UINT8_MAX ||
+                operand_pool.size() + inputs.size() + outputs.size() > UINT32_MAX) {
+                pass_result = std::unexpected(CodegenError{
+                    "serialization", 
+                    std::format("Operation '{}' exceeds compact encoding limit (max 255 inputs, "
+                                "255 outputs, 2^32 pooled operands).", op->mnemonic())
+                });
+                return;
+            }
+            image.compact_text.push_back(CompactInstruction{
+                static_cast<uint16_t>(opcode_opt.value()),
+                static_cast<uint8_t>(inputs.size()),
+                static_cast<uint8_t>(outputs.size()),
+                static_cast<uint32_t>(operand_pool.size())
             });
-            return;
+            operand_pool.insert(operand_pool.end(), inputs.begin(), inputs.end());
+            operand_pool.insert(operand_pool.end(), outputs.begin(), outputs.end());
+        } else {
+            if (inputs.size() > 4 || outputs.size() > 2) {
+                pass_result = std::unexpected(CodegenError{
+                    "serialization", 
+                    std::format("Operation '{}' exceeds hardware struct limit (max 4 inputs, 2 outputs). "
+                                "Use InstructionEncoding::kCompact.", op->mnemonic())
+                });
+                return;
+            }
+
+            // Populate the physical struct
+            SerializedInstruction inst{};
+            inst.opcode = static_cast<uint16_t>(opcode_opt.value());
+            inst.num_inputs = static_cast<uint16_t>(inputs.size());
+            inst.num_outputs = static_cast<uint16_t>(outputs.size());
+            inst.reserved = 0;
+
+            for (size_t i = 0; i < inputs.size(); ++i) inst.inputs[i] = inputs[i];
+            for (size_t i = 0; i < outputs.size(); ++i) inst.outputs[i] = outputs[i];
+            text_section.push_back(inst);
         }
+        ++instruction_count;
 
-        // Populate the physical struct
-        SerializedInstruction inst{};
-        inst.opcode = static_cast<uint16_t>(opcode_opt.value());
-        inst.num_inputs = static_cast<uint16_t>(inputs.size());
-        inst.num_outputs = static_cast<uint16_t>(outputs.size());
-        inst.reserved = 0;
+        // Record which packed weights this instruction reads, in execution order
+        for (const sir::Value* operand : op->operands()) {
+            auto it = weights.offsets.find(std::string(operand->id()));
+            if (it == weights.offsets.end()) continue;
+            weight_refs.push_back(WeightRef{
+                inst_index, 0, it->second, weights.sizes.at(it->first)
+            });
+        }
 
-        for (size_t i = 0; i < inputs.size(); ++i) inst.inputs[i] = inputs[i];
-        for (size_t i = 0; i < outputs.size(); ++i) inst.outputs[i] = outputs[i];
+        // Costs from the CostAnnotator; the table is dropped if any op lacks them
+        auto flops = op->getAttrAs<int64_t>(sir::attr::kFlops);
+        auto bytes_read = op->getAttrAs<int64_t>(sir::attr::kBytesRead);
+        auto bytes_written = op->getAttrAs<int64_t>(sir::attr::kBytesWritten);
+        if (flops && bytes_read && bytes_written) {
+            costs.push_back(InstructionCost{static_cast<uint64_t>(*flops), 
+                                            static_cast<uint64_t>(*bytes_read),
+                                            static_cast<uint64_t>(*bytes_written)});
+        } else {
+            all_costed = false;
+        }
+
+        if (options_.emit_source_info) {
+            auto text = [op](sir::AttrId id) { return op->getAttrAs<std::string>(id).value_or(""); };
+            image.source_info.push_back(SourceInfo{
+                intern(text(sir::attr::kSourceNode)),
+                intern(text(sir::attr::kSourceOpType)),
+                intern(std::string(op->mnemonic())),
+                intern(text(sir::attr::kOpSequence)),
+                intern(FormatShapes(*op)),
+                0
+            });
+        }
 
-        text_section.push_back(inst);
     });
 
-    if (!pass_result) return pass_result;
+    if (!pass_result) return std::unexpected(pass_result.error());
+
+    // Sorted by name, so equal layouts serialize to equal bytes.
+    if (options_.emit_weight_names) {
+        std::vector<std::string_view> names;
+        names.reserve(weights.offsets.size());
+        for (const auto& [name, offset] : weights.offsets) names.push_back(name);
+        std::sort(names.begin(), names.end());
+        for (std::string_view name : names) {
+            const std::string key(name);
+            image.weight_names.push_back(WeightName{
+                intern(key), 0, weights.offsets.at(key), weights.sizes.at(key)
+            });
+        }
+    }
 
     // --- 2. Calculate Layout Offsets ---
-    FileHeader header{};
+    if (!all_costed) costs.clear();
+    if (image.source_info.empty() && image.weight_names.empty()) strings.clear();
+
+    FileHeader& header = image.header;
     header.magic = kSeeMagic;
     header.version = kCurrentVersion;
     header.arena_size = required_arena_size;
-    header.text_size = text_section.size();
-    header.rodata_size = weights.rodata_blob.size();
-
-    // Text section follows immediately after the header
-    header.text_offset = sizeof(FileHeader);
-    
-    // Rodata section must be 64-byte aligned for AVX-512 loading
-    size_t end_of_text = header.text_offset + (header.text_size * sizeof(SerializedInstruction));
-    header.rodata_offset = (end_of_text + 63) & ~63; 
-
-    // --- 3. Write to Disk ---
-    std::ofstream out(std::string(file_path), std::ios::out | std::ios::binary);
-    if (!out.is_open()) {
+    header.instruction_count = instruction_count;
+
+    // The section table follows the header, so a loader gets both with one read.
+    const bool has_refs = !weight_refs.empty();
+    const bool has_costs = !costs.empty();
+    const bool has_source = !image.source_info.empty();
+    const bool has_names = !image.weight_names.empty();
+    header.section_table_offset = sizeof(FileHeader);
+    const bool compact = options_.encoding == InstructionEncoding::kCompact;
+    header.section_count = 2 + compact + has_refs + has_costs + (has_source || has_names) + 
+                           has_source + has_names;
+    uint64_t cursor = header.section_table_offset + header.section_count * sizeof(SectionEntry);
+
+    auto place = [&](SectionType type, uint32_t flags, uint64_t size, uint64_t alignment) {
+        cursor = (cursor + alignment - 1) & ~(alignment - 1);
+        image.sections.push_back(SectionEntry{
+            static_cast<uint32_t>(type), flags, cursor, size, static_cast<uint32_t>(alignment), 0
+        });
+        cursor += size;
+    };
+
+    // Instructions are cache-line sized (or divide one); keep each within one line.
+    if (compact) {
+        place(SectionType::kCompactText, kSectionRequired, 
+              image.compact_text.size() * sizeof(CompactInstruction), 64);
+        place(SectionType::kOperandPool, kSectionRequired, operand_pool.size() * sizeof(uint64_t), 8);
+    } else {
+        place(SectionType::kText, kSectionRequired, 
+              text_section.size() * sizeof(SerializedInstruction), 64);
+    }
+    // Streaming metadata sits between text and rodata, in the pages the loader
+    // maps anyway.
+    if (has_refs) place(SectionType::kWeightRefs, 0, weight_refs.size() * sizeof(WeightRef), 8);
+    image.end_of_text = cursor;
+
+    // Rodata section must be at least 64-byte aligned for AVX-512 loading, and 
+    // page/huge-page aligned whenever the packer placed tensors on such boundaries.
+    image.rodata_alignment = std::max<size_t>(
+        options_.rodata_alignment, weights.section_alignment);
+    place(SectionType::kRodata, kSectionRequired, weights.rodata_size, image.rodata_alignment);
+
+    // Optional sections trail .rodata, so the pages a plain load maps never 
+    // hold any of them.
+    if (has_costs) place(SectionType::kInstructionCost, 0, costs.size() * sizeof(InstructionCost), 8);
+    if (has_source || has_names) place(SectionType::kStringTable, 0, strings.size(), 8);
+    if (has_source) place(SectionType::kSourceInfo, 0, image.source_info.size() * sizeof(SourceInfo), 8);
+    if (has_names) place(SectionType::kWeightNames, 0, image.weight_names.size() * sizeof(WeightName), 8);
+    image.file_size = cursor;
+
+    // --- 3. Checksum Every Section ---
+    if (options_.checksum_sections) {
+        for (SectionEntry& section : image.sections) {
+            const auto type = static_cast<SectionType>(section.type);
+            if (type == SectionType::kRodata) {
+                // The largest section by far: checksum it in chunks, across threads if large, 
+                // treating the padding between tensors as the zeros it reads back as.
+                std::vector<utility::Crc32cExtent> extents;
+                extents.reserve(weights.layout.size());
+                for (const PackedTensor& tensor : weights.layout) extents.push_back({tensor.offset, tensor.bytes});
+                section.checksum = utility::Crc32cSparse(extents, section.size, ChecksumPool(section.size));
+            } else {
+                section.checksum = utility::Crc32c(std::span<const uint8_t>(
+                    static_cast<const uint8_t*>(SectionData(image, type)), section.size));
+            }
+            section.flags |= kSectionChecksummed;
+        }
+    }
+    return image;
+}
+
+std::expected<void, CodegenError> Serializer::Run(
+    std::string_view file_path, 
+    const sir::Block& block, 
+    const PackedWeights& weights,
+    uint64_t required_arena_size) 
+{
+    utility::Logger::Info(std::format("Serializer: Writing binary to '{}'", file_path));
+
+    auto image_result = BuildImage(block, weights, required_arena_size);
+    if (!image_result) return std::unexpected(image_result.error());
+    const Image& image = *image_result;
+
+    if (auto written = WriteImage(file_path, image, weights); !written) return written;
+
+    utility::Logger::Info(std::format(
+        "Serializer: Build complete. Output size: {} bytes. (Instructions: {}, Arena: {} bytes)",
+        image.file_size, image.header.instruction_count, required_arena_size
+    ));
+    const SectionEntry& rodata = *image.section(SectionType::kRodata);
+    utility::Logger::Info(std::format(
+        "Serializer: .rodata placed at offset {} ({}-byte aligned, {} bytes of section padding); {} section(s)",
+        rodata.offset, image.rodata_alignment, rodata.offset - image.end_of_text, image.sections.size()
+    ));
+
+    return {};
+}
+
+std::expected<void, CodegenError> Serializer::WriteImage(
+    std::string_view file_path,
+    const Image& image,
+    const PackedWeights& weights) const
+{
+    // Every section, including each weight tensor, is written directly from its 
+    // owner's memory. No intermediate copy of .rodata is ever materialized.
+    std::vector<Segment> segments;
+    segments.reserve(2 + image.sections.size() + weights.layout.size());
+    AppendImageSegments(segments, image, weights);
+
+    const std::string path(file_path);
+    // Write a sibling and rename it over the target, so the path always names
+    // either the old file or the complete new one. The old inode is left
+    // untouched: it may be mmap()ed by a running engine, or be a hard link into
+    // the artifact cache.
+    std::string temp_path = path + ".XXXXXX";
+    const int fd = mkstemp(temp_path.data());
+    if (fd == -1) {
         return std::unexpected(CodegenError{
             "io_error", 
-            std::format("Failed to open output file '{}' for writing.", file_path)
+            std::format("Failed to create a temporary file next to '{}': {}", file_path, std::strerror(errno))
         });
     }
 
-    // Write Header
-    out.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+    // Padding regions are holes; extend the file so trailing padding is present.
+    int err = fchmod(fd, 0644) != 0 ? errno : 0;
+    if (err == 0) err = WriteSegments(fd, segments);
+    if (err == 0 && ftruncate(fd, static_cast<off_t>(image.file_size)) != 0) err = errno;
+    if (err == 0 && fsync(fd) != 0) err = errno;
+    if (close(fd) != 0 && err == 0) err = errno;
+    if (err == 0 && rename(temp_path.c_str(), path.c_str()) != 0) err = errno;
+    if (err == 0) {
+        SyncParentDirectory(path);
+    } else {
+        unlink(temp_path.c_str());
+    }
 
-    // Write Text Section (Instructions)
-    out.write(reinterpret_cast<const char*>(text_section.data()), 
-              text_section.size() * sizeof(SerializedInstruction));
+    if (err != 0) {
+        return std::unexpected(CodegenError{
+            "io_error", 
+            std::format("A filesystem error occurred while writing the binary payload: {}", 
+                        std::strerror(err))
+        });
+    }
+    return {};
+}
 
-    // Pad to 64-byte boundary
-    WritePadding(out, static_cast<size_t>(out.tellp()), 64);
+std::expected<void, CodegenError> Serializer::PatchRodata(
+    std::string_view file_path, 
+    const sir::Block& block, 
+    const PackedWeights& weights,
+    uint64_t required_arena_size)
+{
+    utility::Logger::Info(std::format("Serializer: Refreshing weights in '{}'", file_path));
 
-    // Write Rodata Section (Weights)
-    if (!weights.rodata_blob.empty()) {
-        out.write(reinterpret_cast<const char*>(weights.rodata_blob.data()), 
-                  weights.rodata_blob.size());
-    }
+    auto image_result = BuildImage(block, weights, required_arena_size);
+    if (!image_result) return std::unexpected(image_result.error());
+    const Image& image = *image_result;
+    const FileHeader& header = image.header;
 
-    if (out.fail()) {
+    const std::string path(file_path);
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
         return std::unexpected(CodegenError{
             "io_error", 
-            "A filesystem error occurred while writing the binary payload."
+            std::format("Failed to open '{}' for patching: {}", file_path, std::strerror(errno))
         });
     }
+    auto fail = [&](std::string phase, std::string message) {
+        close(fd);
+        return std::unexpected(CodegenError{std::move(phase), std::move(message)});
+    };
+
+    // --- 1. Verify the Graph Signature ---
+    // The instruction stream encodes the opcodes, the arena layout (and with it 
+    // every activation shape), and the WeightRef table the size of every weight. 
+    // If all of them match, only the weight values differ.
+    FileHeader old{};
+    if (int err = ReadAt(fd, &old, sizeof(FileHeader), 0); err != 0) {
+        return fail("io_error", std::format("Failed to read header of '{}': {}", file_path, std::strerror(err)));
+    }
+    if (old.magic != kSeeMagic || old.version != kCurrentVersion) {
+        return fail("weights_refresh", std::format("'{}' is not a version {} .see file", file_path, kCurrentVersion));
+    }
+    std::vector<SectionEntry> old_sections;
+    if (int err = ReadSectionTable(fd, old, old_sections); err != 0) {
+        return fail("io_error", std::format("Failed to read section table of '{}': {}", file_path, std::strerror(err)));
+    }
+    const SectionEntry* old_rodata = FindSection(old_sections, SectionType::kRodata);
+    const SectionEntry* old_refs_section = FindSection(old_sections, SectionType::kWeightRefs);
+    const SectionEntry& new_rodata = *image.section(SectionType::kRodata);
+    if (old_rodata == nullptr) {
+        return fail("weights_refresh", std::format("'{}' has no .rodata section", file_path));
+    }
+    const uint64_t old_refs_count = old_refs_section ? old_refs_section->size / sizeof(WeightRef) : 0;
+    if (old.arena_size != header.arena_size || old.instruction_count != header.instruction_count ||
+        old_refs_count != image.weight_refs.size()) {
+        return fail("weights_refresh", std::format(
+            "Graph signature of '{}' differs from the new model ({} vs {} instructions, "
+            "{} vs {} arena bytes)", file_path, old.instruction_count, header.instruction_count, 
+            old.arena_size, header.arena_size));
+    }
+
+    // The file must hold the same instruction stream, in the same encoding.
+    std::vector<uint8_t> old_bytes;
+    for (SectionType type : {SectionType::kText, SectionType::kCompactText, SectionType::kOperandPool}) {
+        const SectionEntry* before = FindSection(old_sections, type);
+        const SectionEntry* after = image.section(type);
+        if (before == nullptr && after == nullptr) continue;
+        bool same = before != nullptr && after != nullptr && before->size == after->size;
+        if (same && before->size > 0) {
+            old_bytes.resize(before->size);
+            if (int err = ReadAt(fd, old_bytes.data(), old_bytes.size(), before->offset); err != 0) {
+                return fail("io_error", std::format("Failed to read '{}': {}", file_path, std::strerror(err)));
+            }
+            same = std::memcmp(old_bytes.data(), SectionData(image, type), old_bytes.size()) == 0;
+        }
+        if (!same) {
+            return fail("weights_refresh", std::format(
+                "Instruction stream of '{}' differs from the new model", file_path));
+        }
+    }
+
+    std::vector<WeightRef> old_refs(old_refs_count);
+    if (!old_refs.empty()) {
+        if (int err = ReadAt(fd, old_refs.data(), old_refs.size() * sizeof(WeightRef), 
+                             old_refs_section->offset); err != 0) {
+            return fail("io_error", std::format("Failed to read '{}': {}", file_path, std::strerror(err)));
+        }
+    }
+    for (size_t i = 0; i < old_refs.size(); ++i) {
+        if (old_refs[i].instruction != image.weight_refs[i].instruction ||
+            old_refs[i].size != image.weight_refs[i].size) {
+            return fail("weights_refresh", std::format(
+                "Weight shapes of instruction {} in '{}' differ from the new model", 
+                old_refs[i].instruction, file_path));
+        }
+    }
+
+    close(fd);
+
+    // --- 2. Write the New Weights ---
+    // Everything but .rodata is already in the image and identical to the file,
+    // so a fresh write costs no more than patching, and renaming it over the
+    // old path never changes bytes under an engine that has the file mapped.
+    const bool same_layout = old_rodata->size == new_rodata.size &&
+        std::equal(old_refs.begin(), old_refs.end(), image.weight_refs.begin(),
+                   [](const WeightRef& a, const WeightRef& b) { return a.rodata_offset == b.rodata_offset; });
+    if (auto written = WriteImage(file_path, image, weights); !written) return written;
 
     utility::Logger::Info(std::format(
-        "Serializer: Build complete. Output size: {} bytes. (Instructions: {}, Arena: {} bytes)",
-        static_cast<size_t>(out.tellp()), text_section.size(), required_arena_size
-    ));
+        "Serializer: Rewrote {} bytes of .rodata ({})", new_rodata.size,
+        same_layout ? "layout unchanged" : "layout changed"));
+    return {};
+}
+
+std::expected<void, CodegenError> Serializer::PatchWeights(
+    std::string_view file_path,
+    const utility::WeightBuffer& weights)
+{
+    utility::Logger::Info(std::format("Serializer: Refreshing weights in '{}' by name", file_path));
+
+    const std::string path(file_path);
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return std::unexpected(CodegenError{
+            "io_error", 
+            std::format("Failed to open '{}' for patching: {}", file_path, std::strerror(errno))
+        });
+    }
+    std::string temp_path;  // Set once the private copy exists.
+    auto fail = [&](std::string phase, std::string message) {
+        close(fd);
+        if (!temp_path.empty()) unlink(temp_path.c_str());
+        return std::unexpected(CodegenError{std::move(phase), std::move(message)});
+    };
+
+    // --- 1. Read the Name Table ---
+    FileHeader header{};
+    if (int err = ReadAt(fd, &header, sizeof(FileHeader), 0); err != 0) {
+        return fail("io_error", std::format("Failed to read header of '{}': {}", file_path, std::strerror(err)));
+    }
+    if (header.magic != kSeeMagic || header.version != kCurrentVersion) {
+        return fail("weights_refresh", std::format("'{}' is not a version {} .see file", file_path, kCurrentVersion));
+    }
+    std::vector<SectionEntry> sections;
+    if (int err = ReadSectionTable(fd, header, sections); err != 0) {
+        return fail("io_error", std::format("Failed to read section table of '{}': {}", file_path, std::strerror(err)));
+    }
+    const SectionEntry* rodata = FindSection(sections, SectionType::kRodata);
+    const SectionEntry* names_section = FindSection(sections, SectionType::kWeightNames);
+    const SectionEntry* strings_section = FindSection(sections, SectionType::kStringTable);
+    if (rodata == nullptr || names_section == nullptr || strings_section == nullptr) {
+        return fail("weights_refresh", std::format(
+            "'{}' has no weight names; refresh it from the optimized graph instead", file_path));
+    }
+    std::vector<WeightName> names(names_section->size / sizeof(WeightName));
+    std::string strings(strings_section->size, '\0');
+    int err = ReadAt(fd, names.data(), names.size() * sizeof(WeightName), names_section->offset);
+    if (err == 0) err = ReadAt(fd, strings.data(), strings.size(), strings_section->offset);
+    if (err != 0) {
+        return fail("io_error", std::format("Failed to read '{}': {}", file_path, std::strerror(err)));
+    }
+
+    // --- 2. Resolve Every Weight Before Writing Any ---
+    // Keyed by rodata offset: deduplicated weights share one range.
+    std::map<uint64_t, std::span<const uint8_t>> tensors;
+    for (const WeightName& record : names) {
+        if (record.name >= strings.size() || record.rodata_offset + record.size > rodata->size) {
+            return fail("weights_refresh", std::format("Weight name table of '{}' is corrupt", file_path));
+        }
+        const std::string_view name(strings.c_str() + record.name);
+        const auto bytes = weights.GetRawBytes(name);
+        if (!bytes) {
+            return fail("weights_refresh", std::format(
+                "The new weights lack '{}', which '{}' was compiled with", name, file_path));
+        }
+        if (bytes->size() != record.size) {
+            return fail("weights_refresh", std::format(
+                "Weight '{}' is {} bytes, but '{}' holds {}", name, bytes->size(), file_path, record.size));
+        }
+        auto [it, inserted] = tensors.try_emplace(record.rodata_offset, *bytes);
+        if (!inserted && !std::equal(it->second.begin(), it->second.end(), bytes->begin(), bytes->end())) {
+            return fail("weights_refresh", std::format(
+                "'{}' shares storage with another weight in '{}' but no longer matches it", name, file_path));
+        }
+    }
+
+    // --- 3. Patch a Copy of the File ---
+    // The copy is renamed over the original, so an engine that has the file
+    // mapped keeps its old weights and the artifact cache's inode is untouched.
+    // copy_file() lets the kernel copy (or reflink) without a round trip here.
+    close(fd);
+    temp_path = path + ".XXXXXX";
+    fd = mkstemp(temp_path.data());
+    std::error_code ec;
+    if (fd == -1 || !std::filesystem::copy_file(path, temp_path, 
+            std::filesystem::copy_options::overwrite_existing, ec) || fchmod(fd, 0644) != 0) {
+        if (fd == -1) temp_path.clear();
+        return fail("io_error", std::format("Failed to copy '{}' for patching: {}", file_path, 
+                                            ec ? ec.message() : std::strerror(errno)));
+    }
 
+    // Every range is rewritten and padding is zeros, so the new checksum needs 
+    // no read-back. The table precedes .rodata, keeping the segments sorted.
+    std::vector<Segment> segments;
+    segments.reserve(1 + tensors.size());
+    SectionEntry& rodata_entry = sections[static_cast<size_t>(rodata - sections.data())];
+    if (rodata_entry.flags & kSectionChecksummed) {
+        std::vector<utility::Crc32cExtent> extents;
+        extents.reserve(tensors.size());
+        for (const auto& [offset, bytes] : tensors) extents.push_back({offset, bytes});
+        rodata_entry.checksum = utility::Crc32cSparse(extents, rodata_entry.size, ChecksumPool(rodata_entry.size));
+        segments.push_back({header.section_table_offset, sections.data(), 
+                            sections.size() * sizeof(SectionEntry)});
+    }
+    for (const auto& [offset, bytes] : tensors) {
+        segments.push_back({rodata_entry.offset + offset, bytes.data(), bytes.size()});
+    }
+
+    err = WriteSegments(fd, segments);
+    if (err == 0 && fsync(fd) != 0) err = errno;
+    if (close(fd) != 0 && err == 0) err = errno;
+    if (err == 0 && rename(temp_path.c_str(), path.c_str()) != 0) err = errno;
+    if (err != 0) {
+        unlink(temp_path.c_str());
+        return std::unexpected(CodegenError{
+            "io_error", 
+            std::format("A filesystem error occurred while patching .rodata: {}", std::strerror(err))
+        });
+    }
+    SyncParentDirectory(path);
+
+    utility::Logger::Info(std::format(
+        "Serializer: Patched {} weight(s) ({} tensor(s)) into a copy renamed over the file",
+        names.size(), tensors.size()));
     return {};
 }
 
@@ -3,23 +3,70 @@
 
 #include <cstdint>
 #include <expected>
+#include <memory>
 #include <string>
 #include <string_view>
+#include <vector>
+
+#include "src/serialization/schema.h"
 
 // Forward declarations
 namespace seecpp::sir {
 class Block;
 }
 
+namespace seecpp::utility {
+class ThreadPool;
+class WeightBuffer;
+}
+
 namespace seecpp::backend {
 
 struct CodegenError;
 struct PackedWeights;
 
+/// @brief How the instruction stream is laid out in the .see file.
+enum class InstructionEncoding {
+    /// One 64-byte SerializedInstruction per op, at most 4 inputs and 2 outputs.
+    kFixed,
+    /// One 8-byte CompactInstruction per op plus a shared operand pool. Any
+    /// operand count fits, and small ops shrink to a fraction of a cache line.
+    kCompact,
+};
+
+/// @brief Controls the physical placement of sections within the .see file.
+struct SerializerOptions {
+    /// @brief Minimum file-offset boundary for the rodata section. Raised 
+    /// automatically to PackedWeights::section_alignment so that page-aligned 
+    /// tensors stay page-aligned once the file is mmap()ed.
+    uint64_t rodata_alignment = 64;
+
+    /// @brief Emit the string table and per-instruction SourceInfo that map
+    /// instructions back to ONNX nodes. They follow .rodata and are only read
+    /// for profiling and diagnostics; disable to keep node names out of the file.
+    bool emit_source_info = true;
+
+    /// @brief Emit a WeightName per packed weight, with the names in the string
+    /// table, so PatchWeights() can later refresh the file from weights alone.
+    bool emit_weight_names = true;
+
+    InstructionEncoding encoding = InstructionEncoding::kCompact;
+
+    /// @brief Store a CRC32C of every section in the section table, so the
+    /// runtime can reject truncated or corrupted artifacts.
+    bool checksum_sections = true;
+
+    /// @brief Threads that checksum .rodata, including the caller. Zero
+    /// selects std::thread::hardware_concurrency(). Small weight sets are
+    /// checksummed on the calling thread regardless.
+    size_t checksum_threads = 0;
+};
+
 /// @brief Writes the lowered, bound, and packed IR out to a physical binary file.
 class Serializer {
  public:
-    Serializer() = default;
+    explicit Serializer(SerializerOptions options = {});
+    ~Serializer();
 
     /// @brief Compiles the final state into a .see file.
     /// @param file_path Destination path on disk.
@@ -32,6 +79,71 @@ class Serializer {
         const sir::Block& block, 
         const PackedWeights& weights,
         uint64_t required_arena_size);
+
+    /// @brief Replaces only the .rodata section of an existing .see file.
+    ///
+    /// Fails with phase "weights_refresh" unless `file_path` was compiled from a 
+    /// graph with the same instruction stream, arena and weight shapes. The new
+    /// file is written beside the old one and renamed over it, so engines that 
+    /// have the old one mapped keep running on the old weights until they reload.
+    [[nodiscard]] std::expected<void, CodegenError> PatchRodata(
+        std::string_view file_path, 
+        const sir::Block& block, 
+        const PackedWeights& weights,
+        uint64_t required_arena_size);
+
+    /// @brief Rewrites the weights of an existing .see file from `weights`
+    /// alone, by the names in its kWeightNames section. No graph is needed.
+    ///
+    /// Fails with phase "weights_refresh" if the file has no weight names, a 
+    /// weight is missing or changed size, or weights that were deduplicated 
+    /// into one range no longer agree; PatchRodata() handles those. Like
+    /// PatchRodata(), patches a copy and renames it over the original.
+    [[nodiscard]] std::expected<void, CodegenError> PatchWeights(
+        std::string_view file_path,
+        const utility::WeightBuffer& weights);
+
+ private:
+    /// @brief The non-weight parts of a .see file, laid out but not yet written.
+    struct Image {
+        FileHeader header{};
+        /// Sorted by offset: text and weight refs, then .rodata, then the 
+        /// optional sections, which the runtime maps only on request.
+        std::vector<SectionEntry> sections;
+        std::vector<SerializedInstruction> text;          // InstructionEncoding::kFixed
+        std::vector<CompactInstruction> compact_text;     // InstructionEncoding::kCompact
+        std::vector<uint64_t> operand_pool;
+        std::vector<WeightRef> weight_refs;
+        std::vector<InstructionCost> costs;
+        std::vector<SourceInfo> source_info;
+        std::vector<WeightName> weight_names;
+        std::string strings;
+        uint64_t rodata_alignment = 0;
+        uint64_t end_of_text = 0;
+        uint64_t file_size = 0;
+
+        const SectionEntry* section(SectionType type) const { return FindSection(sections, type); }
+    };
+
+    std::expected<Image, CodegenError> BuildImage(
+        const sir::Block& block, 
+        const PackedWeights& weights,
+        uint64_t required_arena_size) const;
+
+    /// @brief Writes `image` and the weights to a temporary sibling of
+    /// `file_path`, then renames it over `file_path`.
+    std::expected<void, CodegenError> WriteImage(
+        std::string_view file_path,
+        const Image& image,
+        const PackedWeights& weights) const;
+
+    /// @brief The pool that checksums `bytes` of weights, or null if the
+    /// calling thread would finish before a pool started. Created on first
+    /// use and kept, so a build followed by a patch starts threads once.
+    utility::ThreadPool* ChecksumPool(uint64_t bytes) const;
+
+    SerializerOptions options_;
+    mutable std::unique_ptr<utility::ThreadPool> checksum_pool_;
 };
 
 }  // namespace seecpp::backend
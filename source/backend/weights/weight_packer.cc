@@ -5,8 +5,15 @@
 #include "seecpp/sir/sir.h"
 #include "seecpp/utility/weight_buffer.h"
 
+#include <algorithm>
+#include <bit>
+#include <cstring>
 #include <format>
+#include <functional>
 #include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace seecpp::backend {
 
@@ -15,24 +22,51 @@ namespace {
 inline size_t CalculateAlignedOffset(size_t current_offset, size_t alignment) {
     return (current_offset + alignment - 1) & ~(alignment - 1);
 }
+
+// Fast, non-cryptographic content fingerprint. Collisions are resolved by an 
+// exact byte compare, so the hash only has to be cheap and well distributed.
+inline size_t HashContent(std::span<const uint8_t> bytes) {
+    return std::hash<std::string_view>{}(std::string_view(
+        reinterpret_cast<const char*>(bytes.data()), bytes.size()));
+}
 }  // namespace
 
 std::expected<PackedWeights, CodegenError> WeightPacker::Run(
     sir::Block& block, 
     const utility::WeightBuffer& weights,
-    size_t alignment) 
+    const PackingOptions& options) 
 {
     packed_tensor_count_ = 0;
     total_bytes_packed_ = 0;
-
-    utility::Logger::Info(std::format(
-        "WeightPacker: Starting .rodata compilation (Alignment: {} bytes)", 
-        alignment
-    ));
+    padding_bytes_ = 0;
+    deduplicated_tensor_count_ = 0;
+    deduplicated_bytes_ = 0;
+
+    const bool promote_large = options.large_tensor_threshold > 0;
+
+    // The offset arithmetic masks with (alignment - 1), which only rounds up
+    // correctly for powers of two.
+    if (!std::has_single_bit(options.alignment) ||
+        (promote_large && !std::has_single_bit(options.large_tensor_alignment))) {
+        return std::unexpected(CodegenError{
+            "weight_packing",
+            std::format("Alignments must be powers of two (got {} and {} for large tensors)",
+                        options.alignment, options.large_tensor_alignment)
+        });
+    }
+    utility::Logger::Info(promote_large
+        ? std::format("WeightPacker: Starting .rodata compilation (Alignment: {} bytes, "
+                      "{} bytes for tensors >= {} bytes)",
+                      options.alignment, options.large_tensor_alignment,
+                      options.large_tensor_threshold)
+        : std::format("WeightPacker: Starting .rodata compilation (Alignment: {} bytes)", 
+                      options.alignment));
 
     PackedWeights result;
-    // Pre-allocate a reasonable chunk to prevent continuous vector reallocations
-    result.rodata_blob.reserve(1024 * 1024 * 10); // 10 MB initial reservation
+    result.section_alignment = options.alignment;
+
+    // Content hash -> indices into result.layout of tensors with that hash.
+    std::unordered_map<size_t, std::vector<size_t>> slots_by_hash;
 
     std::expected<void, CodegenError> pass_result = {};
 
@@ -41,43 +75,63 @@ std::expected<PackedWeights, CodegenError> WeightPacker::Run(
 
         // Iterate through all operands of the instruction
         for (size_t i = 0; i < op->numOperands(); ++i) {
-            const std::string tensor_id = op->operand(i)->id();
+            const std::string tensor_id(op->operand(i)->id());
 
             // 1. Skip if it's not a constant weight, or if we've already packed it
-            if (!weights.has(tensor_id) || result.offsets.contains(tensor_id)) {
+            if (!weights.Contains(tensor_id) || result.offsets.contains(tensor_id)) {
                 continue;
             }
 
-            // 2. Fetch the raw binary data from the WeightBuffer
-            // (Assuming a method that returns std::span<const uint8_t>)
-            auto byte_span = weights.getRawBytes(tensor_id);
-            if (byte_span.empty()) {
+            // 2. Borrow the raw binary data from the WeightBuffer (no copy)
+            auto bytes_opt = weights.GetRawBytes(tensor_id);
+            if (!bytes_opt || bytes_opt->empty()) {
                 pass_result = std::unexpected(CodegenError{
                     "weight_packing",
                     std::format("WeightBuffer contains no data for tensor '{}'", tensor_id)
                 });
                 return;
             }
+            const std::span<const uint8_t> byte_span = *bytes_opt;
+
+            // 3. Content deduplication: identical bytes under a different name 
+            // (tied embeddings, repeated scales) alias the existing rodata slot.
+            auto& candidates = slots_by_hash[HashContent(byte_span)];
+            auto duplicate = std::find_if(candidates.begin(), candidates.end(), 
+                [&](size_t slot) {
+                    const auto& packed = result.layout[slot].bytes;
+                    return packed.size() == byte_span.size() &&
+                           std::memcmp(packed.data(), byte_span.data(), byte_span.size()) == 0;
+                });
+            if (duplicate != candidates.end()) {
+                result.offsets[tensor_id] = result.layout[*duplicate].offset;
+                result.sizes[tensor_id] = byte_span.size();
+                ++deduplicated_tensor_count_;
+                deduplicated_bytes_ += byte_span.size();
+                continue;
+            }
+
+            // 4. Calculate alignment padding. Large tensors start on their own page 
+            // so the runtime can prefetch or drop them without touching neighbours.
+            const bool is_large = promote_large && 
+                                  byte_span.size() >= options.large_tensor_threshold;
+            const size_t alignment = is_large ? options.large_tensor_alignment 
+                                              : options.alignment;
+            result.section_alignment = std::max(result.section_alignment, alignment);
 
-            // 3. Calculate alignment padding
-            const size_t current_size = result.rodata_blob.size();
+            const size_t current_size = result.rodata_size;
             const size_t aligned_offset = CalculateAlignedOffset(current_size, alignment);
             const size_t padding_bytes = aligned_offset - current_size;
-
-            // 4. Inject zero-padding to reach the required hardware alignment
-            if (padding_bytes > 0) {
-                result.rodata_blob.insert(result.rodata_blob.end(), padding_bytes, 0x00);
-            }
+            padding_bytes_ += padding_bytes;
 
             // 5. Record the physical absolute offset in our symbol table
             result.offsets[tensor_id] = aligned_offset;
+            result.sizes[tensor_id] = byte_span.size();
+            candidates.push_back(result.layout.size());
 
-            // 6. Append the actual tensor bytes
-            result.rodata_blob.insert(
-                result.rodata_blob.end(), 
-                byte_span.begin(), 
-                byte_span.end()
-            );
+            // 6. Place the tensor. Its bytes stay in the WeightBuffer until the 
+            // Serializer streams them to disk.
+            result.layout.push_back(PackedTensor{aligned_offset, padding_bytes, byte_span});
+            result.rodata_size = aligned_offset + byte_span.size();
 
             ++packed_tensor_count_;
         }
@@ -87,16 +141,30 @@ std::expected<PackedWeights, CodegenError> WeightPacker::Run(
         return std::unexpected(pass_result.error());
     }
 
-    total_bytes_packed_ = result.rodata_blob.size();
-
-    // Shrink the vector capacity to perfectly match the final size, returning unused RAM
-    result.rodata_blob.shrink_to_fit();
+    total_bytes_packed_ = result.rodata_size;
 
     utility::Logger::Info(std::format(
         "WeightPacker: Successfully packed {} unique tensor(s). Total .rodata size: {} bytes", 
         packed_tensor_count_, total_bytes_packed_
     ));
 
+    if (deduplicated_tensor_count_ > 0) {
+        utility::Logger::Info(std::format(
+            "WeightPacker: Deduplicated {} tensor(s) by content, saving {} bytes",
+            deduplicated_tensor_count_, deduplicated_bytes_
+        ));
+    }
+
+    // Report the file-size cost of the alignment policy so page/huge-page 
+    // placement can be weighed against the bytes it burns.
+    if (total_bytes_packed_ > 0) {
+        utility::Logger::Info(std::format(
+            "WeightPacker: Alignment padding: {} bytes ({:.2f}% of .rodata)",
+            padding_bytes_, 
+            100.0 * static_cast<double>(padding_bytes_) / static_cast<double>(total_bytes_packed_)
+        ));
+    }
+
     return result; // Relies on NRVO (Named Return Value Optimization) to prevent copies
 }
 
@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <expected>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -21,35 +22,87 @@ namespace seecpp::backend {
 
 struct CodegenError;
 
-/// @brief Represents the compiled read-only data section and its symbol table.
+/// @brief One physical tensor placed in the rodata section.
+struct PackedTensor {
+    /// @brief Byte offset within the rodata section (already aligned).
+    uint64_t offset;
+    /// @brief Zero padding inserted before this tensor to reach `offset`.
+    uint64_t padding;
+    /// @brief The tensor contents, borrowed from the source WeightBuffer.
+    std::span<const uint8_t> bytes;
+};
+
+/// @brief The layout of the read-only data section and its symbol table.
+/// 
+/// No weight bytes are copied: every PackedTensor borrows from the WeightBuffer 
+/// handed to WeightPacker::Run, which must outlive this struct. The Serializer 
+/// streams each span straight to disk.
 struct PackedWeights {
-    /// @brief The flattened, aligned, raw byte array of all constant weights.
-    std::vector<uint8_t> rodata_blob;
-    /// @brief Maps a tensor ID to its exact byte offset within the rodata_blob.
+    /// @brief Physical tensors in ascending offset order.
+    std::vector<PackedTensor> layout;
+    /// @brief Total size of the rodata section in bytes, including padding.
+    uint64_t rodata_size = 0;
+    /// @brief Maps a tensor ID to its exact byte offset within the rodata section.
+    /// Tensors with identical contents share a single offset.
     std::unordered_map<std::string, uint64_t> offsets;
+    /// @brief Maps a tensor ID to its unpadded size in bytes.
+    std::unordered_map<std::string, uint64_t> sizes;
+    /// @brief The strictest alignment applied to any tensor. The Serializer must 
+    /// place the rodata section on at least this boundary for the per-tensor 
+    /// alignment to survive in the final file layout.
+    size_t section_alignment = 64;
 };
 
-/// @brief Flattens and aligns mathematical tensors into a bare-metal binary blob.
+/// @brief Controls how tensors are laid out within the rodata section.
+struct PackingOptions {
+    /// @brief The byte boundary every tensor is aligned to.
+    size_t alignment = 64;
+    /// @brief Tensors of at least this many bytes are promoted to 
+    /// `large_tensor_alignment`. Zero disables the promotion.
+    size_t large_tensor_threshold = 0;
+    /// @brief The boundary for large tensors, typically a 4 KiB page or a 
+    /// 2 MiB huge page, so the runtime can madvise() each tensor independently.
+    size_t large_tensor_alignment = 4096;
+};
+
+/// @brief Assigns every referenced constant an aligned slot in the rodata section.
 class WeightPacker {
  public:
     // 64-byte alignment is mandatory to avoid AVX-512 unaligned load penalties.
     static constexpr size_t kDefaultAlignment = 64;
+    // Standard and huge page boundaries for page-granular tensor placement.
+    static constexpr size_t kPageAlignment = 4096;
+    static constexpr size_t kHugePageAlignment = 2 * 1024 * 1024;
 
     WeightPacker() = default;
 
-    /// @brief Scans the IR block, extracts referenced weights, and packs them.
+    /// @brief Scans the IR block and lays out the referenced weights.
     /// @param block The Middle-End optimized IR block.
-    /// @param weights The buffer containing the raw parsed constants.
-    /// @param alignment The byte boundary to align each tensor to.
+    /// @param weights The buffer containing the raw parsed constants. The 
+    ///        returned layout borrows from it.
+    /// @param options Per-tensor alignment policy. Both alignments must be
+    ///        powers of two; anything else is rejected with a CodegenError.
     /// @return The compiled PackedWeights struct, or a CodegenError.
     [[nodiscard]] std::expected<PackedWeights, CodegenError> Run(
         sir::Block& block, 
         const utility::WeightBuffer& weights,
-        size_t alignment = kDefaultAlignment);
+        const PackingOptions& options = {});
+
+    // --- Statistics from the last Run() ---
+    size_t packed_tensor_count() const { return packed_tensor_count_; }
+    size_t total_bytes_packed() const { return total_bytes_packed_; }
+    size_t padding_bytes() const { return padding_bytes_; }
+    /// @brief Tensors aliased onto an existing rodata slot by content match.
+    size_t deduplicated_tensor_count() const { return deduplicated_tensor_count_; }
+    /// @brief Bytes of .rodata avoided by content deduplication.
+    size_t deduplicated_bytes() const { return deduplicated_bytes_; }
 
  private:
     size_t packed_tensor_count_ = 0;
     size_t total_bytes_packed_ = 0;
+    size_t padding_bytes_ = 0;
+    size_t deduplicated_tensor_count_ = 0;
+    size_t deduplicated_bytes_ = 0;
 };
 
 }  // namespace seecpp::backend
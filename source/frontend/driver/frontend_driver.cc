@@ -7,9 +7,7 @@
 #include <utility>
 
 #include "include/utility/logger.hpp"
-#include "include/utility/weight_buffer.hpp"
 #include "seecpp/sir/sir.h"
-#include "source/frontend/diagnostics_engine.h"
 #include "source/frontend/onnx_ingressor.h"
 #include "source/frontend/shape_inference.h"
 #include "source/frontend/validator.h"
@@ -17,21 +15,33 @@
 
 namespace fs = std::filesystem;
 
-namespace seecpp::utility {
-// Explicit ownership of the weight buffer for the lifetime of the process.
-WeightBuffer global_weight_buffer;
-}  // namespace seecpp::utility
-
 namespace seecpp::frontend {
 
 FrontendDriver::FrontendDriver(Config config)
     : config_(std::move(config)),
-      diag_engine_(std::make_unique<DiagnosticsEngine>()) {}
+      owned_context_(std::make_unique<utility::CompilationContext>(
+          utility::CompilationOptions{
+              .verbose = config_.verbose,
+              .time_report_path = config_.time_report_path,
+              .time_trace_path = config_.time_trace_path})),
+      context_(owned_context_.get()) {}
+
+FrontendDriver::FrontendDriver(Config config,
+                               utility::CompilationContext& context)
+    : config_(std::move(config)), context_(&context) {}
 
 int FrontendDriver::Run() {
   SetupLogger();
   utility::Logger::info("SeeC++ frontend pipeline starting");
 
+  const int status = RunPipeline();
+  // A caller-owned context goes on to the backend, which writes the report,
+  // unless the compilation ends here.
+  if (owned_context_ || status != 0) context_->WriteTimeReport();
+  return status;
+}
+
+int FrontendDriver::RunPipeline() {
   // 1. Ingestion
   auto model_block = Ingest();
   if (!model_block) return 1;
@@ -55,30 +65,30 @@ void FrontendDriver::SetupLogger() const {
 }
 
 void FrontendDriver::ReportDiagnostics(const ValidationReport& report) {
-  // Map validation errors into the DiagnosticsEngine.
+  // Map validation errors into the context's DiagnosticsEngine.
   // Note: ONNX nodes don't inherently have source line numbers, so we 
   // initialize a default SourceLocation tied to the input file.
-  SourceLocation loc;
+  utility::SourceLocation loc;
   loc.file_path = config_.input_path.string();
   loc.line = 0;
   loc.column = 0;
   loc.length = 1;
 
   for (const auto& diag : report.diagnostics) {
-    DiagnosticLevel level = 
+    utility::DiagnosticSeverity severity =
         (diag.severity == ValidationError::Severity::Warning)
-            ? DiagnosticLevel::Warning
-            : DiagnosticLevel::Error;
+            ? utility::DiagnosticSeverity::kWarning
+            : utility::DiagnosticSeverity::kError;
 
     std::string msg = diag.op_mnemonic.empty() ? "" : "[" + diag.op_mnemonic + "] ";
     msg += diag.message;
 
-    diag_engine_->Report(level, loc, msg);
+    context_->diagnostics().Report(severity, loc, msg);
   }
 }
 
 std::unique_ptr<sir::Block> FrontendDriver::Ingest() {
-  OnnxIngressor ingressor;
+  OnnxIngressor ingressor(*context_);
   auto result = ingressor.ingest(config_.input_path.string());
 
   if (!result) {
@@ -86,12 +96,16 @@ std::unique_ptr<sir::Block> FrontendDriver::Ingest() {
     std::string node_info =
         err.node_name.empty() ? "" : " at node '" + err.node_name + "'";
     utility::Logger::error("Ingestion failed" + node_info + ": " + err.message);
+    context_->diagnostics().Report(utility::DiagnosticSeverity::kError,
+                                   "ingest", err.message);
     return nullptr;
   }
   return std::move(*result);
 }
 
 bool FrontendDriver::RunShapeInference(sir::Block& block) {
+  utility::TimeReport::Scope timer(&context_->time_report(), "shape_inference",
+                                   "frontend", &block);
   ShapeInferencePass shape_pass;
   auto result = shape_pass.run(block);
 
@@ -99,12 +113,16 @@ bool FrontendDriver::RunShapeInference(sir::Block& block) {
     const auto& err = result.error();
     utility::Logger::error("Shape inference failed at op '" + err.op_mnemonic +
                            "': " + err.message);
+    context_->diagnostics().Report(utility::DiagnosticSeverity::kError,
+                                   "shape_inference", err.message);
     return false;
   }
   return true;
 }
 
 bool FrontendDriver::Validate(sir::Block& block) {
+  utility::TimeReport::Scope timer(&context_->time_report(), "validation",
+                                   "frontend", &block);
   Validator validator;
   ValidationReport report = validator.Validate(block);
   
@@ -113,6 +131,7 @@ bool FrontendDriver::Validate(sir::Block& block) {
   }
 
   if (report.HasErrors()) {
+    // Each error is already in the context's diagnostics.
     utility::Logger::error("Validation failed — aborting compilation");
     return false;
   }
@@ -120,17 +139,20 @@ bool FrontendDriver::Validate(sir::Block& block) {
 }
 
 bool FrontendDriver::RunMiddleEnd(sir::Block& block) {
-  middle::PassManager pm;
+  utility::TimeReport::Scope timer(&context_->time_report(), "middle_end",
+                                   "middle_end", &block);
+  middle_end::PassContext pass_context;
+  pass_context.verify_each = context_->options().verify_each;
+  pass_context.print_ir_after_all = context_->options().print_ir_after_all;
+  pass_context.num_threads = context_->options().num_threads;
+
+  middle_end::PassManager pm(std::move(pass_context), context_);
   // Pipeline configuration would typically be loaded from a config or CLI flags
-  auto result = pm.run(block);
+  auto result = pm.Run(block);
 
   if (!result) {
-    const auto& err = result.error();
-    utility::Logger::error("Middle-end pass '" + err.pass_name +
-                           "' failed: " + err.message);
-    
-    // Assuming the PassManager also returns a ValidationReport-compatible struct
-    // ReportDiagnostics(pm.lastReport()); 
+    // The PassManager has already recorded the failing pass in context_.
+    utility::Logger::error("Middle-end pipeline failed");
     return false;
   }
   return true;
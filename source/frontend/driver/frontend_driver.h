@@ -5,38 +5,55 @@
 #include <memory>
 
 #include "seecpp/sir/sir.h"
-#include "source/frontend/diagnostics_engine.h"
+#include "seecpp/utility/compilation_context.h"
 #include "source/frontend/validator.h"
 
 namespace seecpp::frontend {
 
 /// @brief Orchestrates the frontend compilation pipeline: Ingestion, Shape
 /// Inference, Validation, Optimization, and Serialization.
+///
+/// All per-model state lives in a utility::CompilationContext, so several
+/// drivers may run concurrently on different threads.
 class FrontendDriver {
  public:
   struct Config {
     std::filesystem::path input_path;
     std::filesystem::path output_path;
     bool verbose = false;
+    /// Timing report outputs for a private context; see TimeReport.
+    std::filesystem::path time_report_path;
+    std::filesystem::path time_trace_path;
   };
 
+  /// @brief Runs against a private context built from `config`.
   explicit FrontendDriver(Config config);
+  /// @brief Runs against a caller-owned context, which must outlive the
+  /// driver. Lets the caller hand the ingested weights to the backend.
+  FrontendDriver(Config config, utility::CompilationContext& context);
   ~FrontendDriver() = default;
 
   FrontendDriver(const FrontendDriver&) = delete;
   FrontendDriver& operator=(const FrontendDriver&) = delete;
 
-  /// @brief Executes the full frontend pipeline.
+  /// @brief Executes the full frontend pipeline. Writes the context's time
+  /// report, if it asks for one, when the context is private or the
+  /// pipeline fails; otherwise the backend finishes the compilation and
+  /// writes it.
   /// @return 0 on success, non-zero on failure.
   int Run();
 
+  [[nodiscard]] utility::CompilationContext& context() { return *context_; }
+
  private:
   Config config_;
-  std::unique_ptr<DiagnosticsEngine> diag_engine_;
+  std::unique_ptr<utility::CompilationContext> owned_context_;
+  utility::CompilationContext* context_;
 
   void SetupLogger() const;
   void ReportDiagnostics(const ValidationReport& report);
 
+  int RunPipeline();
   std::unique_ptr<sir::Block> Ingest();
   bool RunShapeInference(sir::Block& block);
   bool Validate(sir::Block& block);
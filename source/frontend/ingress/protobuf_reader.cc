@@ -1,20 +1,139 @@
 #include "seecpp/frontend/protobuf_reader.h"
 
 // Note: Ensure these headers exist in your include/utility/ directory
+#include "seecpp/utility/compilation_context.h"
 #include "seecpp/utility/logger.h"
+#include "seecpp/utility/mapped_file.h"
+#include "seecpp/utility/thread_pool.h"
 #include "seecpp/utility/weight_buffer.h"
 
 // Protobuf headers (compiled from external/onnx)
 #include <onnx.pb.h>
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <format>
 #include <fstream>
 #include <set>
+#include <span>
+#include <thread>
+#include <vector>
 
 namespace seecpp::frontend {
 
-// Assuming this is defined and allocated in your utility module
-extern utility::WeightBuffer global_weight_buffer;
+namespace {
+
+utility::BufferDtype toBufferDtype(sir::DataType dt) {
+    switch (dt) {
+        case sir::DataType::F16:  return utility::BufferDtype::kF16;
+        case sir::DataType::BF16: return utility::BufferDtype::kBF16;
+        case sir::DataType::F32:  return utility::BufferDtype::kF32;
+        case sir::DataType::F64:  return utility::BufferDtype::kF64;
+        case sir::DataType::I8:   return utility::BufferDtype::kI8;
+        case sir::DataType::I16:  return utility::BufferDtype::kI16;
+        case sir::DataType::I32:  return utility::BufferDtype::kI32;
+        case sir::DataType::I64:  return utility::BufferDtype::kI64;
+        case sir::DataType::U8:   return utility::BufferDtype::kU8;
+        case sir::DataType::U16:  return utility::BufferDtype::kU16;
+        case sir::DataType::U32:  return utility::BufferDtype::kU32;
+        case sir::DataType::U64:  return utility::BufferDtype::kU64;
+        case sir::DataType::Bool: return utility::BufferDtype::kBool;
+        default:                  return utility::BufferDtype::kUnknown;
+    }
+}
+
+// ONNX float8 types have no SIR dtype. Their bytes are carried unchanged as
+// U8; every other type SIR cannot represent (strings, complex numbers,
+// undefined) is rejected.
+bool isFloat8(int onnx_type) {
+    switch (onnx_type) {
+        case onnx::TensorProto::FLOAT8E4M3FN:
+        case onnx::TensorProto::FLOAT8E4M3FNUZ:
+        case onnx::TensorProto::FLOAT8E5M2:
+        case onnx::TensorProto::FLOAT8E5M2FNUZ: return true;
+        default:                                return false;
+    }
+}
+
+// A typed initializer whose payload must be decoded rather than borrowed.
+struct DecodeJob {
+    const onnx::TensorProto* init;
+    sir::DataType dtype;
+    std::span<uint8_t> dst;
+};
+
+template <typename Field>
+bool copyInto(const Field& field, std::span<uint8_t> dst) {
+    using Elem = typename Field::value_type;
+    if (static_cast<size_t>(field.size()) * sizeof(Elem) != dst.size()) return false;
+    std::memcpy(dst.data(), field.data(), dst.size());
+    return true;
+}
+
+template <typename Dst, typename Field>
+bool narrowInto(const Field& field, std::span<uint8_t> dst) {
+    if (static_cast<size_t>(field.size()) * sizeof(Dst) != dst.size()) return false;
+    auto* out = reinterpret_cast<Dst*>(dst.data());
+    for (int i = 0; i < field.size(); ++i) out[i] = static_cast<Dst>(field.Get(i));
+    return true;
+}
+
+// raw_data is little-endian on the wire. Only big-endian hosts take this path.
+bool byteSwapInto(const std::string& raw, size_t width, std::span<uint8_t> dst) {
+    if (raw.size() != dst.size() || width == 0) return false;
+    for (size_t i = 0; i < raw.size(); i += width) {
+        std::reverse_copy(raw.begin() + i, raw.begin() + i + width, dst.begin() + i);
+    }
+    return true;
+}
+
+bool decodeInitializer(const DecodeJob& job) {
+    const onnx::TensorProto& init = *job.init;
+    if (!init.raw_data().empty()) {
+        return byteSwapInto(init.raw_data(), sir::dtypeByteWidth(job.dtype), job.dst);
+    }
+
+    // The repeated field is chosen by the ONNX type, which may be carried in a
+    // SIR dtype of the same width.
+    switch (init.data_type()) {
+        case onnx::TensorProto::FLOAT:  return copyInto(init.float_data(), job.dst);
+        case onnx::TensorProto::DOUBLE: return copyInto(init.double_data(), job.dst);
+        case onnx::TensorProto::INT32:  return copyInto(init.int32_data(), job.dst);
+        case onnx::TensorProto::INT64:  return copyInto(init.int64_data(), job.dst);
+        case onnx::TensorProto::UINT64: return copyInto(init.uint64_data(), job.dst);
+        case onnx::TensorProto::UINT32: return narrowInto<uint32_t>(init.uint64_data(), job.dst);
+        // ONNX keeps 8- and 16-bit types, including the bit patterns of 16-bit
+        // floats, in the low bits of int32_data. Narrowing passes those bits
+        // through untouched; no float conversion occurs.
+        case onnx::TensorProto::BOOL:
+        case onnx::TensorProto::INT8:
+        case onnx::TensorProto::UINT8:
+        case onnx::TensorProto::FLOAT8E4M3FN:
+        case onnx::TensorProto::FLOAT8E4M3FNUZ:
+        case onnx::TensorProto::FLOAT8E5M2:
+        case onnx::TensorProto::FLOAT8E5M2FNUZ:
+            return narrowInto<uint8_t>(init.int32_data(), job.dst);
+        case onnx::TensorProto::FLOAT16:
+        case onnx::TensorProto::BFLOAT16:
+        case onnx::TensorProto::INT16:
+        case onnx::TensorProto::UINT16:
+            return narrowInto<uint16_t>(init.int32_data(), job.dst);
+        default:
+            return false;
+    }
+}
+
+bool hasTypedPayload(const onnx::TensorProto& init) {
+    return init.float_data_size() > 0 || init.double_data_size() > 0 ||
+           init.int32_data_size() > 0 || init.int64_data_size() > 0 ||
+           init.uint64_data_size() > 0;
+}
+
+} // namespace
 
 const std::unordered_map<std::string, ProtobufReader::NodeHandler, StringHash, std::equal_to<>>
 ProtobufReader::kHandlers = {
@@ -127,48 +246,207 @@ ProtobufReader::kHandlers = {
 
 std::expected<std::unique_ptr<sir::Block>, IngestError>
 ProtobufReader::ingest(std::string_view model_path) {
+    // Created first so that it outlives the scope counting it.
+    auto block = std::make_unique<sir::Block>();
+    utility::TimeReport* report = &context_.time_report();
+    utility::TimeReport::Scope ingest_timer(report, "ingest", "frontend", block.get());
+
+    auto parsed = parseModel(model_path);
+    if (!parsed) return std::unexpected(parsed.error());
+    const std::shared_ptr<onnx::ModelProto>& model = *parsed;
+
+    SymbolTable sym;
+
+    {
+        utility::TimeReport::Scope timer(report, "initializers", "frontend", block.get());
+        auto init_result = processInitializers(model->graph(), sym, *block, model);
+        if (!init_result) return std::unexpected(init_result.error());
+        processInputs(model->graph(), sym, *block);
+    }
+
+    {
+        utility::TimeReport::Scope timer(report, "nodes", "frontend", block.get());
+        auto result = processNodes(model->graph(), sym, *block);
+        if (!result) return std::unexpected(result.error());
+    }
+
+    return block;
+}
+
+std::expected<void, IngestError> ProtobufReader::ingestWeights(std::string_view model_path) {
+    utility::TimeReport* report = &context_.time_report();
+    utility::TimeReport::Scope ingest_timer(report, "ingest_weights", "frontend");
+
+    auto parsed = parseModel(model_path);
+    if (!parsed) return std::unexpected(parsed.error());
+
+    // The constants land in a scratch block; only the weights are kept.
+    sir::Block scratch;
+    SymbolTable sym;
+    utility::TimeReport::Scope timer(report, "initializers", "frontend");
+    return processInitializers((*parsed)->graph(), sym, scratch, *parsed);
+}
+
+std::expected<std::shared_ptr<onnx::ModelProto>, IngestError>
+ProtobufReader::parseModel(std::string_view model_path) {
     current_model_path_ = std::string(model_path);
-    
+    external_files_.clear();
+
     std::ifstream ifs(current_model_path_, std::ios::binary);
     if (!ifs) {
         return std::unexpected(IngestError{IngestErrorCode::InvalidModel, "", "", "Could not open: " + current_model_path_});
     }
 
-    onnx::ModelProto model;
+    // Shared so that weights borrowed from raw_data can pin the parsed model 
+    // for as long as the WeightBuffer references them.
+    auto model = std::make_shared<onnx::ModelProto>();
+    utility::TimeReport::Scope timer(&context_.time_report(), "protobuf_parse", "frontend");
     google::protobuf::io::IstreamInputStream zero_copy_input(&ifs);
-    if (!model.ParseFromZeroCopyStream(&zero_copy_input)) {
+    if (!model->ParseFromZeroCopyStream(&zero_copy_input)) {
         return std::unexpected(IngestError{IngestErrorCode::InvalidModel, "", "", "Protobuf parse failed"});
     }
-
-    auto block = std::make_unique<sir::Block>();
-    SymbolTable sym;
-
-    processInitializers(model.graph(), sym, *block);
-    processInputs(model.graph(), sym, *block);
-
-    auto result = processNodes(model.graph(), sym, *block);
-    if (!result) return std::unexpected(result.error());
-
-    return block;
+    return model;
 }
 
-void ProtobufReader::processInitializers(const onnx::GraphProto& graph, SymbolTable& sym, sir::Block& block) {
+std::expected<void, IngestError>
+ProtobufReader::processInitializers(const onnx::GraphProto& graph, SymbolTable& sym, sir::Block& block,
+                                    const std::shared_ptr<const void>& model_owner) {
+    // Initializers that cannot be borrowed are decoded after this serial walk,
+    // in parallel, each into a WeightBuffer slot reserved here.
+    std::vector<DecodeJob> jobs;
+
     for (const auto& init : graph.initializer()) {
-        auto dt = mapDataType(init.data_type()).value_or(sir::DataType::F32);
+        auto dt_opt = mapDataType(init.data_type());
+        // Types SIR cannot compute on still pass through to .rodata unchanged;
+        // only a kernel that reads them would need to know what they hold.
+        const bool opaque = !dt_opt;
+        if (opaque) {
+            if (!isFloat8(init.data_type())) {
+                return std::unexpected(IngestError{IngestErrorCode::UnsupportedDtype, init.name(), "initializer",
+                    "Unsupported ONNX data type " + std::to_string(init.data_type())});
+            }
+            dt_opt = sir::DataType::U8;
+            utility::Logger::Warn(std::format(
+                "ProtobufReader: Initializer '{}' has ONNX data type {}, which SIR has no dtype for; "
+                "carrying its bytes unchanged as {}", init.name(), init.data_type(), sir::dtypeName(*dt_opt)));
+        }
+        const sir::DataType dt = *dt_opt;
+        const utility::BufferDtype buffer_dtype = opaque ? utility::BufferDtype::kUnknown : toBufferDtype(dt);
         sir::Shape shape;
         for (auto d : init.dims()) shape.dims.push_back(d);
 
-        auto* op = block.appendOp("sc_high.constant");
-        op->setAttribute("weight_ref", init.name());
+        auto* op = block.appendOp(sir::op::kConstant);
+        op->setAttribute(sir::attr::kWeightRef, init.name());
         sym[init.name()] = op->addResult(init.name(), dt, shape);
 
-        if (!init.raw_data().empty()) {
-            const float* ptr = reinterpret_cast<const float*>(init.raw_data().data());
-            global_weight_buffer.addWeight(init.name(), std::vector<float>(ptr, ptr + shape.volume()));
-        } else if (!init.float_data().empty()) {
-            global_weight_buffer.addWeight(init.name(), std::vector<float>(init.float_data().begin(), init.float_data().end()));
+        const size_t expected_bytes = shape.byteSize(dt);
+
+        // Resolve the initializer's bytes without copying them where possible.
+        // External data is borrowed from an mmap() of the side file, raw_data from
+        // the parsed model. Both are little-endian, so big-endian hosts decode raw_data.
+        std::span<const uint8_t> bytes;
+        std::shared_ptr<const void> owner;
+
+        if (init.data_location() == onnx::TensorProto::EXTERNAL) {
+            auto ext = mapExternalData(init);
+            if (!ext) return std::unexpected(ext.error());
+            bytes = ext->first;
+            owner = std::move(ext->second);
+        } else if (!init.raw_data().empty() && std::endian::native == std::endian::little) {
+            bytes = std::span<const uint8_t>(
+                reinterpret_cast<const uint8_t*>(init.raw_data().data()), init.raw_data().size());
+            owner = model_owner;
+        } else if (!init.raw_data().empty() || hasTypedPayload(init)) {
+            // Typed repeated fields are not byte-addressable in the wire format.
+            const size_t width = sir::dtypeByteWidth(dt);
+            auto dst = context_.weights().Allocate(init.name(), expected_bytes / width, width,
+                                                     buffer_dtype);
+            if (!dst.empty()) jobs.push_back(DecodeJob{&init, dt, dst});
+            continue;
+        } else {
+            continue;
+        }
+
+        if (bytes.size() != expected_bytes) {
+            return std::unexpected(IngestError{IngestErrorCode::InvalidModel, init.name(), "initializer",
+                "Initializer holds " + std::to_string(bytes.size()) + " bytes, shape requires " +
+                std::to_string(expected_bytes)});
+        }
+
+        context_.weights().AddBorrowed(init.name(), bytes, sir::dtypeByteWidth(dt),
+                                         buffer_dtype, std::move(owner));
+    }
+
+    if (jobs.empty()) return {};
+
+    // Each job writes only its own pre-reserved slot, so no locking is needed.
+    utility::TimeReport::Scope timer(&context_.time_report(), "initializer_decode", "frontend");
+    std::vector<uint8_t> decoded(jobs.size(), 0);
+    const size_t requested = context_.options().num_threads;
+    const size_t threads = requested ? requested : std::thread::hardware_concurrency();
+    utility::ThreadPool pool(std::clamp<size_t>(threads, 1, jobs.size()));
+    pool.ParallelFor(jobs.size(), [&](size_t i) { decoded[i] = decodeInitializer(jobs[i]); });
+
+    size_t total_bytes = 0;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        if (!decoded[i]) {
+            return std::unexpected(IngestError{IngestErrorCode::InvalidModel, jobs[i].init->name(),
+                "initializer", "Typed payload does not match the declared shape"});
+        }
+        total_bytes += jobs[i].dst.size();
+    }
+
+    utility::Logger::Debug(std::format(
+        "ProtobufReader: Decoded {} typed initializer(s), {} bytes, on {} thread(s)",
+        jobs.size(), total_bytes, pool.size()));
+    return {};
+}
+
+std::expected<std::pair<std::span<const uint8_t>, std::shared_ptr<const void>>, IngestError>
+ProtobufReader::mapExternalData(const onnx::TensorProto& init) {
+    std::string location;
+    uint64_t offset = 0;
+    std::optional<uint64_t> length;
+
+    for (const auto& entry : init.external_data()) {
+        const std::string& v = entry.value();
+        uint64_t parsed = 0;
+        const bool numeric = 
+            std::from_chars(v.data(), v.data() + v.size(), parsed).ec == std::errc{};
+
+        if (entry.key() == "location") location = v;
+        else if (entry.key() == "offset" && numeric) offset = parsed;
+        else if (entry.key() == "length" && numeric) length = parsed;
+    }
+
+    if (location.empty()) {
+        return std::unexpected(IngestError{IngestErrorCode::InvalidModel, init.name(), "initializer",
+                                           "External data entry has no location"});
+    }
+
+    // Locations are relative to the directory holding the .onnx file. Each side 
+    // file is mapped once and shared by every tensor that lives in it.
+    const std::string path = 
+        (std::filesystem::path(current_model_path_).parent_path() / location).string();
+    auto it = external_files_.find(path);
+    if (it == external_files_.end()) {
+        auto mapped = utility::MappedFile::Open(path);
+        if (!mapped) {
+            return std::unexpected(IngestError{IngestErrorCode::InvalidModel, init.name(), "initializer",
+                                               mapped.error()});
         }
+        it = external_files_.emplace(path, std::move(*mapped)).first;
+    }
+
+    const auto& file = it->second;
+    const uint64_t size = length.value_or(file->size() - std::min<uint64_t>(offset, file->size()));
+    if (offset > file->size() || size > file->size() - offset) {
+        return std::unexpected(IngestError{IngestErrorCode::InvalidModel, init.name(), "initializer",
+                                           "External data range exceeds '" + path + "'"});
     }
+
+    return std::make_pair(file->bytes().subspan(offset, size), 
+                          std::shared_ptr<const void>(file));
 }
 
 void ProtobufReader::processInputs(const onnx::GraphProto& graph, SymbolTable& sym, sir::Block& block) {
@@ -207,6 +485,11 @@ ProtobufReader::processNodes(const onnx::GraphProto& graph, SymbolTable& sym, si
         if (!result) return std::unexpected(result.error());
 
         sir::Operation* op = *result;
+        // Kept through lowering so the .see file can name the node. ONNX
+        // node names are optional; the first output name is unique.
+        op->setAttribute(sir::attr::kSourceNode,
+                         node.name().empty() && node.output_size() > 0 ? node.output(0) : node.name());
+        op->setAttribute(sir::attr::kSourceOpType, node.op_type());
         for (int i = 0; i < node.output_size() && i < static_cast<int>(op->numResults()); ++i) {
             sym[node.output(i)] = op->result(i);
         }
@@ -217,10 +500,17 @@ ProtobufReader::processNodes(const onnx::GraphProto& graph, SymbolTable& sym, si
 std::optional<sir::DataType> ProtobufReader::mapDataType(int onnx_type) {
     switch (onnx_type) {
         case 1:  return sir::DataType::F32;
+        case 2:  return sir::DataType::U8;
+        case 3:  return sir::DataType::I8;
+        case 4:  return sir::DataType::U16;
+        case 5:  return sir::DataType::I16;
         case 6:  return sir::DataType::I32;
         case 7:  return sir::DataType::I64;
+        case 9:  return sir::DataType::Bool;
         case 10: return sir::DataType::F16;
         case 11: return sir::DataType::F64;
+        case 12: return sir::DataType::U32;
+        case 13: return sir::DataType::U64;
         case 16: return sir::DataType::BF16;
         default: return std::nullopt;
     }
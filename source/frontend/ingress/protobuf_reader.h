@@ -10,11 +10,20 @@
 #include <expected>
 #include <functional>
 #include <optional>
+#include <span>
+#include <utility>
 
 // Forward declarations to avoid exposing external/ Protobuf headers to the rest of the project
 namespace onnx {
+class ModelProto;
 class NodeProto;
 class GraphProto;
+class TensorProto;
+}
+
+namespace seecpp::utility {
+class CompilationContext;
+class MappedFile;
 }
 
 namespace seecpp::frontend {
@@ -22,7 +31,8 @@ namespace seecpp::frontend {
 enum class IngestErrorCode {
     MissingInput,
     InvalidModel,
-    UnsupportedOp
+    UnsupportedOp,
+    UnsupportedDtype
 };
 
 struct IngestError {
@@ -47,18 +57,33 @@ class ProtobufReader {
     using NodeHandler = std::function<std::expected<sir::Operation*, IngestError>(
         const onnx::NodeProto&, SymbolTable&, sir::Block&, ProtobufReader*)>;
 
-    ProtobufReader() = default;
+    /// @param context Receives the model's weights; its options().num_threads
+    ///        bounds the threads used to decode typed initializers.
+    explicit ProtobufReader(utility::CompilationContext& context) : context_(context) {}
 
     std::expected<std::unique_ptr<sir::Block>, IngestError> ingest(std::string_view model_path);
 
+    /// @brief Reads only the initializers of `model_path` into the context's 
+    /// weights, skipping the graph. Enough to refresh the weights of a 
+    /// compiled .see file; see backend::CodegenDriver::RefreshWeights().
+    std::expected<void, IngestError> ingestWeights(std::string_view model_path);
+
  private:
-    void processInitializers(const onnx::GraphProto& graph, SymbolTable& sym, sir::Block& block);
+    std::expected<std::shared_ptr<onnx::ModelProto>, IngestError> parseModel(std::string_view model_path);
+    std::expected<void, IngestError> processInitializers(const onnx::GraphProto& graph, SymbolTable& sym,
+                                                         sir::Block& block,
+                                                         const std::shared_ptr<const void>& model_owner);
+    std::expected<std::pair<std::span<const uint8_t>, std::shared_ptr<const void>>, IngestError>
+    mapExternalData(const onnx::TensorProto& init);
     void processInputs(const onnx::GraphProto& graph, SymbolTable& sym, sir::Block& block);
     std::expected<void, IngestError> processNodes(const onnx::GraphProto& graph, SymbolTable& sym, sir::Block& block);
     
     static std::optional<sir::DataType> mapDataType(int onnx_type);
 
     std::string current_model_path_;
+    utility::CompilationContext& context_;
+    // External-data side files, mapped once per ingest and shared by their tensors.
+    std::unordered_map<std::string, std::shared_ptr<const utility::MappedFile>> external_files_;
     static const std::unordered_map<std::string, NodeHandler, StringHash, std::equal_to<>> kHandlers;
 };
 
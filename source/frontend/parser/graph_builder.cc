@@ -41,7 +41,7 @@ std::expected<sir::Operation*, ParseError> GraphBuilder::AddOperation(
             "Attempted to insert operation without an active insertion point."});
     }
 
-    auto op = std::make_unique<sir::Operation>(std::string(mnemonic));
+    auto op = insertion_point_->createOp(mnemonic);
     
     for (const auto& in_name : input_names) {
         auto it = symbol_table_.find(in_name);
@@ -10,12 +10,12 @@
 
 namespace seecpp::frontend {
 
-const std::unordered_set<std::string> Validator::kSupportedOps = {
-    "sc_high.matmul", "sc_high.gemm",      "sc_high.conv2d",
-    "sc_high.relu",   "sc_high.add",       "sc_high.sub",
-    "sc_high.mul",    "sc_high.div",       "sc_high.batch_norm",
-    "sc_high.reshape","sc_high.maxpool",   "sc_high.avgpool",
-    "sc_high.concat", "sc_high.transpose", "sc_high.constant",
+const std::unordered_set<sir::OpId> Validator::kSupportedOps = {
+    sir::op::kMatMul, sir::op::kGemm,      sir::op::kConv2d,
+    sir::op::kRelu,   sir::op::kAdd,       sir::op::kSub,
+    sir::op::kMul,    sir::op::kDiv,       sir::op::kBatchNorm,
+    sir::op::kReshape,sir::op::kMaxPool,   sir::op::kAvgPool,
+    sir::op::kConcat, sir::op::kTranspose, sir::op::kConstant,
 };
 
 ValidationReport Validator::Validate(const sir::Block& block) const {
@@ -26,11 +26,10 @@ ValidationReport Validator::Validate(const sir::Block& block) const {
   CheckSsaLinks(block, report);
   CheckTopologicalOrder(block, report);
 
-  for (const auto& owned_op : block.operations()) {
-    const sir::Operation& op = *owned_op;
-    const std::string mnemonic(op.mnemonic());
-
-    if (kSupportedOps.find(mnemonic) == kSupportedOps.end()) {
+  for (const sir::Operation* op_ptr : block.operations()) {
+    const sir::Operation& op = *op_ptr;
+    if (kSupportedOps.find(op.opId()) == kSupportedOps.end()) {
+      const std::string mnemonic(op.mnemonic());
       report.diagnostics.push_back({
           ValidationError::Severity::Error, mnemonic, "",
           "Unsupported op '" + mnemonic +
@@ -56,8 +55,7 @@ ValidationReport Validator::Validate(const sir::Block& block) const {
 
 void Validator::CheckSsaLinks(const sir::Block& block,
                               ValidationReport& report) const {
-  for (const auto& owned_op : block.operations()) {
-    const sir::Operation* op = owned_op.get();
+  for (const sir::Operation* op : block.operations()) {
     const std::string mn(op->mnemonic());
 
     for (size_t i = 0; i < op->numOperands(); ++i) {
@@ -98,12 +96,11 @@ void Validator::CheckSsaLinks(const sir::Block& block,
 void Validator::CheckTopologicalOrder(const sir::Block& block,
                                       ValidationReport& report) const {
   std::unordered_set<const sir::Value*> defined;
-  for (const auto& arg : block.arguments()) {
-    defined.insert(arg.get());
+  for (const sir::Value* arg : block.arguments()) {
+    defined.insert(arg);
   }
 
-  for (const auto& owned_op : block.operations()) {
-    const sir::Operation* op = owned_op.get();
+  for (const sir::Operation* op : block.operations()) {
 
     for (size_t i = 0; i < op->numOperands(); ++i) {
       const sir::Value* v = op->operand(i);
@@ -145,16 +142,16 @@ void Validator::CheckOpConstraints(const sir::Operation& op,
     }
   };
 
-  if (mn == "sc_high.matmul") {
+  if (op.is(sir::op::kMatMul)) {
     requireOperands(2);
-  } else if (mn == "sc_high.gemm") {
+  } else if (op.is(sir::op::kGemm)) {
     if (op.numOperands() < 2 || op.numOperands() > 3) {
       report.diagnostics.push_back({
           ValidationError::Severity::Error, mn, "",
           "Gemm requires 2 or 3 operands, got " +
               std::to_string(op.numOperands())});
     }
-  } else if (mn == "sc_high.conv2d") {
+  } else if (op.is(sir::op::kConv2d)) {
     if (op.numOperands() < 2 || op.numOperands() > 3) {
       report.diagnostics.push_back({
           ValidationError::Severity::Error, mn, "",
@@ -164,26 +161,26 @@ void Validator::CheckOpConstraints(const sir::Operation& op,
     requireAttr("strides");
     requireAttr("pads");
     requireAttr("dilations");
-  } else if (mn == "sc_high.batch_norm") {
+  } else if (op.is(sir::op::kBatchNorm)) {
     requireOperands(5);
     requireAttr("epsilon");
-  } else if (mn == "sc_high.relu" || mn == "sc_high.transpose" ||
-             mn == "sc_high.reshape") {
+  } else if (op.is(sir::op::kRelu) || op.is(sir::op::kTranspose) ||
+             op.is(sir::op::kReshape)) {
     requireOperands(1);
-  } else if (mn == "sc_high.add" || mn == "sc_high.sub" ||
-             mn == "sc_high.mul" || mn == "sc_high.div") {
+  } else if (op.is(sir::op::kAdd) || op.is(sir::op::kSub) ||
+             op.is(sir::op::kMul) || op.is(sir::op::kDiv)) {
     requireOperands(2);
-  } else if (mn == "sc_high.maxpool" || mn == "sc_high.avgpool") {
+  } else if (op.is(sir::op::kMaxPool) || op.is(sir::op::kAvgPool)) {
     requireOperands(1);
     requireAttr("kernel_shape");
     requireAttr("strides");
-  } else if (mn == "sc_high.concat") {
+  } else if (op.is(sir::op::kConcat)) {
     if (op.numOperands() < 2) {
       report.diagnostics.push_back({ValidationError::Severity::Error, mn, "",
                                     "Concat requires at least 2 operands"});
     }
     requireAttr("axis");
-  } else if (mn == "sc_high.constant") {
+  } else if (op.is(sir::op::kConstant)) {
     if (op.numOperands() != 0) {
       report.diagnostics.push_back({ValidationError::Severity::Error, mn, "",
                                     "Constant op must have zero operands"});
@@ -198,14 +195,14 @@ void Validator::CheckOpConstraints(const sir::Operation& op,
 
 void Validator::CheckTypeConsistency(const sir::Operation& op,
                                      ValidationReport& report) const {
-  static const std::unordered_set<std::string> kHomogeneousOps = {
-      "sc_high.matmul", "sc_high.gemm", "sc_high.add",   "sc_high.sub",
-      "sc_high.mul",    "sc_high.div",  "sc_high.conv2d",
+  static const std::unordered_set<sir::OpId> kHomogeneousOps = {
+      sir::op::kMatMul, sir::op::kGemm, sir::op::kAdd,   sir::op::kSub,
+      sir::op::kMul,    sir::op::kDiv,  sir::op::kConv2d,
   };
 
-  const std::string mn(op.mnemonic());
-  if (kHomogeneousOps.find(mn) == kHomogeneousOps.end()) return;
+  if (kHomogeneousOps.find(op.opId()) == kHomogeneousOps.end()) return;
   if (op.numOperands() < 2) return;
+  const std::string mn(op.mnemonic());
 
   const sir::DataType expected = op.operand(0)->dtype();
   for (size_t i = 1; i < op.numOperands(); ++i) {
@@ -237,7 +234,7 @@ void Validator::CheckShapeConsistency(const sir::Operation& op,
     }
   }
 
-  if (mn == "sc_high.conv2d" && op.numOperands() >= 2) {
+  if (op.is(sir::op::kConv2d) && op.numOperands() >= 2) {
     auto checkRank4 = [&](size_t idx, std::string_view label) {
       if (op.operand(idx)->shape().dims.size() != 4) {
         report.diagnostics.push_back({
@@ -266,7 +263,7 @@ void Validator::CheckShapeConsistency(const sir::Operation& op,
     }
   }
 
-  if (mn == "sc_high.matmul" && op.numOperands() == 2) {
+  if (op.is(sir::op::kMatMul) && op.numOperands() == 2) {
     const auto& dim_a = op.operand(0)->shape().dims;
     const auto& dim_b = op.operand(1)->shape().dims;
     
@@ -284,7 +281,7 @@ void Validator::CheckShapeConsistency(const sir::Operation& op,
     }
   }
 
-  if (mn == "sc_high.batch_norm" && op.numOperands() == 5) {
+  if (op.is(sir::op::kBatchNorm) && op.numOperands() == 5) {
     const auto& input_dims = op.operand(0)->shape().dims;
     if (input_dims.size() >= 2) {
       int64_t channels = input_dims[1];
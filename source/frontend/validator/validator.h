@@ -44,7 +44,7 @@ class Validator {
   [[nodiscard]] ValidationReport Validate(const sir::Block& block) const;
 
  private:
-  static const std::unordered_set<std::string> kSupportedOps;
+  static const std::unordered_set<sir::OpId> kSupportedOps;
 
   void CheckSsaLinks(const sir::Block& block, ValidationReport& report) const;
   
@@ -8,6 +8,7 @@
 
 #include "include/utility/logger.hpp"
 #include "seecpp/sir/sir.h"
+#include "source/middle_end/transforms/common_subexpression_elimination.h"
 
 namespace seecpp::middle_end::autodiff {
 
@@ -166,6 +167,10 @@ bool GradientBuilder::BuildGradients(sir::Block& block,
     }
   }
 
+  // VJP rules are applied one node at a time and freely re-derive shared
+  // terms (transposes, views, seeds); fold the duplicates before returning.
+  transforms::CommonSubexpressionElimination().Run(block);
+
   return true;
 }
 
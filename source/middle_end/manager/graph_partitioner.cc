@@ -0,0 +1,203 @@
+#include "source/middle_end/manager/graph_partitioner.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+namespace seecpp::middle_end {
+
+namespace {
+
+bool IsTerminator(const sir::Operation* op) {
+  return op->is(sir::op::kReturn) || op->is(sir::op::kLowReturn) ||
+         op->is(sir::op::kYield);
+}
+
+}  // namespace
+
+std::vector<PartitionRange> PartitionBlock(sir::Block& block,
+                                           size_t max_partitions,
+                                           size_t min_ops) {
+  std::vector<sir::Operation*> ops;
+  ops.reserve(block.numOps());
+  for (sir::Operation* op : block.operations()) ops.push_back(op);
+  while (!ops.empty() && IsTerminator(ops.back())) ops.pop_back();
+
+  const size_t n = ops.size();
+  const size_t k = std::min(max_partitions, n / std::max<size_t>(min_ops, 1));
+  if (k < 2) return {};
+
+  // crossing[c] counts def-use edges from ops before position c to ops at or
+  // after it, i.e. the values a cut in front of ops[c] would have to proxy.
+  // Every edge into ops[0..c) also leaves it, so this is the number of uses
+  // of results defined before c minus the operands consumed before c.
+  std::vector<int64_t> crossing(n + 1, 0);
+  for (size_t i = 0; i < n; ++i) {
+    int64_t delta = 0;
+    for (const sir::Value* result : ops[i]->results())
+      delta += static_cast<int64_t>(result->numUses());
+    for (const sir::Value* v : ops[i]->operands())
+      delta -= v && v->definingOp() ? 1 : 0;
+    crossing[i + 1] = crossing[i] + delta;
+  }
+
+  std::vector<size_t> cuts{0};
+  const size_t window = n / k / 4;
+  for (size_t b = 1; b < k; ++b) {
+    const size_t ideal = b * n / k;
+    const size_t lo = std::max(cuts.back() + 1, ideal - window);
+    const size_t hi = std::min(n - 1, ideal + window);
+    size_t best = std::clamp(ideal, lo, hi);
+    for (size_t c = lo; c <= hi; ++c) {
+      const auto dist = [ideal](size_t x) { return x > ideal ? x - ideal : ideal - x; };
+      if (crossing[c] < crossing[best] ||
+          (crossing[c] == crossing[best] && dist(c) < dist(best))) {
+        best = c;
+      }
+    }
+    cuts.push_back(best);
+  }
+  cuts.push_back(n);
+
+  std::vector<PartitionRange> ranges;
+  ranges.reserve(k);
+  for (size_t b = 0; b + 1 < cuts.size(); ++b)
+    ranges.push_back({ops[cuts[b]], ops[cuts[b + 1] - 1], cuts[b + 1] - cuts[b]});
+  return ranges;
+}
+
+// --- PartitionedBlock ---
+
+PartitionedBlock::PartitionedBlock(sir::Block& parent,
+                                   std::span<const PartitionRange> ranges)
+    : parent_(parent) {
+  if (ranges.empty()) {
+    joined_ = true;
+    return;
+  }
+
+  // Park the trailing terminators so that Join() only ever appends.
+  while (parent_.back() != ranges.back().last)
+    tail_.push_back(parent_.removeOp(parent_.back()));
+  std::reverse(tail_.begin(), tail_.end());
+
+  parts_.resize(ranges.size());
+  part_of_.reserve(ranges.size());
+  for (size_t k = 0; k < ranges.size(); ++k) {
+    parts_[k].block = std::make_unique<sir::Block>(parent_.arena());
+    parts_[k].block->spliceOps(nullptr, parent_, ranges[k].first, ranges[k].last);
+    part_of_.emplace(parts_[k].block.get(), k);
+  }
+  assert(parent_.empty() && "Ranges must cover the block up to its terminators.");
+
+  // Cut every edge that crosses a partition boundary.
+  for (size_t k = 0; k < parts_.size(); ++k) {
+    Part& part = parts_[k];
+    std::unordered_map<const sir::Value*, sir::Value*> proxies;
+    for (sir::Operation* op : part.block->operations()) {
+      for (size_t slot = 0; slot < op->numOperands(); ++slot) {
+        sir::Value* v = op->operand(slot);
+        const sir::Operation* def = v->definingOp();
+        if (def && def->parentBlock() == part.block.get()) continue;
+        const size_t source = OwnerOf(v);
+
+        auto [it, inserted] = proxies.try_emplace(v, nullptr);
+        if (inserted) {
+          it->second = part.block->addArgument(v->dtype(), v->shape());
+          if (source == kExternal) {
+            part.inputs.push_back({it->second, kExternal, 0, v});
+          } else {
+            part.inputs.push_back({it->second, source, Escape(source, v), nullptr});
+          }
+        }
+        op->setOperand(slot, it->second);
+      }
+    }
+  }
+
+  // Terminators are not visible to any pass; detach them until Join().
+  for (const sir::OwnedOp& op : tail_) {
+    for (size_t slot = 0; slot < op->numOperands(); ++slot) {
+      sir::Value* v = op->operand(slot);
+      const size_t source = OwnerOf(v);
+      if (source == kExternal) continue;
+      tail_uses_.push_back({op.get(), slot, source, Escape(source, v)});
+      op->opOperands()[slot].drop();
+    }
+  }
+
+  for (Part& part : parts_) {
+    if (part.escapes.empty()) continue;
+    part.yield = part.block->appendOp(sir::op::kYield);
+    for (sir::Value* v : part.escapes) part.yield->addOperand(v);
+  }
+}
+
+PartitionedBlock::~PartitionedBlock() { Join(); }
+
+void PartitionedBlock::Join() {
+  if (joined_) return;
+  joined_ = true;
+
+  // What each escaping value became; passes rewrite the yields like any
+  // other user.
+  std::vector<std::vector<sir::Value*>> resolved(parts_.size());
+  for (size_t k = 0; k < parts_.size(); ++k) {
+    Part& part = parts_[k];
+    if (!part.yield) continue;
+    assert(part.yield->parentBlock() == part.block.get() &&
+           "A pass erased or moved a partition's yield.");
+    for (sir::Value* v : part.yield->operands()) resolved[k].push_back(v);
+    part.block->removeOp(part.yield);
+  }
+
+  for (Part& part : parts_) {
+    if (!part.block->empty())
+      parent_.spliceOps(nullptr, *part.block, part.block->front(), part.block->back());
+  }
+  for (sir::OwnedOp& op : tail_) parent_.appendOp(std::move(op));
+  tail_.clear();
+
+  // A pass may forward a proxy into its yield (x * 1 where x came from an
+  // earlier partition), so a resolved value can itself be a proxy. Sources
+  // always precede their users, so resolving in partition order means such
+  // a proxy's target is already known.
+  std::unordered_map<const sir::Value*, sir::Value*> target_of;
+  const auto resolve = [&](size_t source, size_t escape) {
+    sir::Value* v = resolved[source][escape];
+    auto it = target_of.find(v);
+    return it == target_of.end() ? v : it->second;
+  };
+  for (Part& part : parts_) {
+    for (const Input& in : part.inputs) {
+      sir::Value* target = in.source == kExternal
+                               ? in.external
+                               : resolve(in.source, in.escape);
+      target_of.emplace(in.proxy, target);
+      in.proxy->replaceAllUsesWith(target);
+    }
+  }
+  for (const TailUse& use : tail_uses_)
+    use.op->setOperand(use.slot, resolve(use.source, use.escape));
+  tail_uses_.clear();
+
+  // The staging blocks are empty now; destroying them releases the proxies.
+  parts_.clear();
+  part_of_.clear();
+}
+
+size_t PartitionedBlock::OwnerOf(const sir::Value* v) const {
+  const sir::Operation* def = v->definingOp();
+  if (!def) return kExternal;
+  auto it = part_of_.find(def->parentBlock());
+  return it == part_of_.end() ? kExternal : it->second;
+}
+
+size_t PartitionedBlock::Escape(size_t part, sir::Value* v) {
+  Part& p = parts_[part];
+  auto [it, inserted] = p.escape_index.try_emplace(v, p.escapes.size());
+  if (inserted) p.escapes.push_back(v);
+  return it->second;
+}
+
+}  // namespace seecpp::middle_end
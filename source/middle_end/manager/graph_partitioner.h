@@ -0,0 +1,103 @@
+#ifndef SEECPP_MIDDLE_END_GRAPH_PARTITIONER_H_
+#define SEECPP_MIDDLE_END_GRAPH_PARTITIONER_H_
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "seecpp/sir/sir.h"
+
+namespace seecpp::middle_end {
+
+/// @brief A contiguous run of ops, `first` through `last` in program order.
+struct PartitionRange {
+  sir::Operation* first;
+  sir::Operation* last;
+  size_t num_ops;
+};
+
+/// @brief Cuts a block into at most `max_partitions` contiguous ranges of at
+/// least `min_ops` ops each.
+///
+/// Cuts start at equal-size boundaries and then move, within a window of a
+/// quarter partition, to the point crossed by the fewest def-use edges. This
+/// tends to land between layers, or between the forward and backward
+/// halves, so partitions exchange few values. Trailing terminators are left
+/// out of every range. Returns fewer than two ranges if the block is too
+/// small to be worth splitting.
+std::vector<PartitionRange> PartitionBlock(sir::Block& block,
+                                           size_t max_partitions,
+                                           size_t min_ops);
+
+/// @brief Moves each range of a block into a staging block of its own so a
+/// pass can run on all of them concurrently, then splices them back.
+///
+/// While split, no two partitions share a use-list: an operand defined in
+/// another partition (or a block argument) is replaced by an argument of the
+/// staging block, and every value used outside its partition is appended to
+/// a trailing sc_high.yield. Whatever a pass replaces such a value with is
+/// therefore visible at Join(), which redirects the proxies to it. Staging
+/// blocks allocate from the parent's arena, so bind a distinct
+/// Arena::LaneScope per concurrent task.
+///
+/// A pass sees constants from other partitions only as arguments, so a
+/// pattern that needs to inspect them will not fire across a boundary.
+class PartitionedBlock {
+ public:
+  PartitionedBlock(sir::Block& parent, std::span<const PartitionRange> ranges);
+  ~PartitionedBlock();
+
+  PartitionedBlock(const PartitionedBlock&) = delete;
+  PartitionedBlock& operator=(const PartitionedBlock&) = delete;
+
+  sir::Block& parent() { return parent_; }
+  size_t size() const { return parts_.size(); }
+  sir::Block& partition(size_t i) { return *parts_[i].block; }
+
+  /// @brief Splices the partitions back into the parent in their original
+  /// order and rewires values across the former boundaries. Idempotent.
+  void Join();
+
+ private:
+  static constexpr size_t kExternal = static_cast<size_t>(-1);
+
+  /// @brief A staging argument standing in for a value from elsewhere.
+  struct Input {
+    sir::Value* proxy;
+    size_t source;           // Defining partition, or kExternal.
+    size_t escape;           // Index into the source's yield.
+    sir::Value* external;    // The value itself when source is kExternal.
+  };
+
+  /// @brief An operand of a trailing terminator detached while split.
+  struct TailUse {
+    sir::Operation* op;
+    size_t slot;
+    size_t source;
+    size_t escape;
+  };
+
+  struct Part {
+    std::unique_ptr<sir::Block> block;
+    std::vector<Input> inputs;
+    std::vector<sir::Value*> escapes;  // Yielded values, in first-use order.
+    std::unordered_map<const sir::Value*, size_t> escape_index;
+    sir::Operation* yield = nullptr;
+  };
+
+  size_t OwnerOf(const sir::Value* v) const;
+  size_t Escape(size_t part, sir::Value* v);
+
+  sir::Block& parent_;
+  std::vector<Part> parts_;
+  std::unordered_map<const sir::Block*, size_t> part_of_;
+  std::vector<sir::OwnedOp> tail_;
+  std::vector<TailUse> tail_uses_;
+  bool joined_ = false;
+};
+
+}  // namespace seecpp::middle_end
+
+#endif  // SEECPP_MIDDLE_END_GRAPH_PARTITIONER_H_
@@ -0,0 +1,62 @@
+#ifndef SEECPP_MIDDLE_END_PASS_H_
+#define SEECPP_MIDDLE_END_PASS_H_
+
+#include <cstdint>
+#include <string_view>
+
+#include "seecpp/sir/sir.h"
+
+namespace seecpp::middle_end {
+
+/// @brief How much of the IR a pass touches, which decides whether the
+/// PassManager may run it on several threads.
+enum class PassScope : uint8_t {
+  /// Needs the whole block at once. Always runs on the calling thread.
+  kBlock,
+  /// Reads and writes only the ops of the block it is handed, and may create
+  /// or erase ops there. The manager may split the block into partitions
+  /// and run the pass on each concurrently. Values defined in another
+  /// partition arrive as block arguments, and values used by another
+  /// partition are kept alive by a trailing sc_high.yield. Run() is then
+  /// called on several blocks at once, so any member it writes needs a lock.
+  kPartition,
+  /// Visits each op on its own through RunOnOperation and may change only
+  /// that op's attributes. Ops are spread across threads in chunks, so
+  /// RunOnOperation() must not write to members either.
+  kOperation,
+};
+
+/// @brief A transformation or analysis over one SIR block.
+class Pass {
+ public:
+  virtual ~Pass() = default;
+
+  virtual std::string_view name() const = 0;
+
+  /// @return True if the pass mutated the IR.
+  virtual bool Run(sir::Block& block) = 0;
+
+  virtual PassScope scope() const { return PassScope::kBlock; }
+
+  /// @brief Entry point for kOperation passes; see OperationPass.
+  virtual bool RunOnOperation(sir::Operation& /*op*/) { return false; }
+};
+
+/// @brief Base for op-local passes. Run() visits every op serially, so the
+/// pass behaves the same with or without a PassManager.
+class OperationPass : public Pass {
+ public:
+  PassScope scope() const final { return PassScope::kOperation; }
+
+  bool Run(sir::Block& block) final {
+    bool changed = false;
+    for (sir::Operation* op : block.operations()) changed |= RunOnOperation(*op);
+    return changed;
+  }
+
+  bool RunOnOperation(sir::Operation& op) override = 0;
+};
+
+}  // namespace seecpp::middle_end
+
+#endif  // SEECPP_MIDDLE_END_PASS_H_
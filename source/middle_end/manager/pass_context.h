@@ -0,0 +1,33 @@
+#ifndef SEECPP_MIDDLE_END_PASS_CONTEXT_H_
+#define SEECPP_MIDDLE_END_PASS_CONTEXT_H_
+
+#include <cstddef>
+
+#include "seecpp/diagnostics/diagnostics_engine.h"
+
+namespace seecpp::middle_end {
+
+/// @brief Pipeline-wide settings handed to the PassManager.
+struct PassContext {
+  bool verify_each = false;
+  bool print_ir_after_all = false;
+  diagnostics::DiagnosticsEngine* diags = nullptr;
+
+  /// Threads used for kPartition and kOperation passes, including the
+  /// caller. One runs everything serially; zero selects the hardware
+  /// concurrency.
+  size_t num_threads = 1;
+  /// kOperation passes spread their ops over this many chunks per thread; a
+  /// few extra chunks let uneven ones balance out.
+  size_t chunks_per_thread = 4;
+  /// Blocks are split for kPartition passes into at most this many
+  /// partitions. The split depends only on the block, never on num_threads,
+  /// so a pipeline produces the same IR at any thread count.
+  size_t max_partitions = 32;
+  /// Partitions smaller than this are not worth a task of their own.
+  size_t min_partition_ops = 2048;
+};
+
+}  // namespace seecpp::middle_end
+
+#endif  // SEECPP_MIDDLE_END_PASS_CONTEXT_H_
@@ -1,13 +1,28 @@
 #include "source/middle_end/pass_manager.h"
 
+#include <algorithm>
 #include <chrono>
 #include <format>
 #include <iostream>
+#include <optional>
 
 #include "include/utility/logger.hpp"
+#include "seecpp/utility/compilation_context.h"
+#include "source/middle_end/manager/graph_partitioner.h"
 
 namespace seecpp::middle_end {
 
+PassManager::PassManager(PassContext context,
+                         utility::CompilationContext* compilation)
+    : context_(std::move(context)), compilation_(compilation) {
+  if (context_.num_threads != 1) {
+    pool_ = std::make_unique<utility::ThreadPool>(context_.num_threads);
+    if (pool_->size() == 1) pool_.reset();
+  }
+}
+
+PassManager::~PassManager() = default;
+
 void PassManager::AddPass(std::unique_ptr<Pass> pass) {
   if (pass != nullptr) {
     passes_.push_back(std::move(pass));
@@ -21,14 +36,57 @@ std::expected<bool, PassError> PassManager::Run(sir::Block& block) {
       "PassManager: Initiating pipeline execution ({} registered passes).",
       passes_.size()));
 
-  for (const auto& pass : passes_) {
+  // Consecutive kPartition passes share one split, which ends at `split_end`.
+  std::optional<PartitionedBlock> split;
+  size_t split_end = 0;
+
+  utility::TimeReport* report =
+      compilation_ ? &compilation_->time_report() : nullptr;
+
+  for (size_t i = 0; i < passes_.size(); ++i) {
+    Pass* pass = passes_[i].get();
     const std::string_view pass_name = pass->name();
 
-    // 1. Instrumentation: Start high-resolution timer
+    // 1. Instrumentation: Start high-resolution timer. The report counts the
+    // block only while it is whole; a split charges its cost to the first
+    // pass of the group and the join to the last.
     const auto start_time = std::chrono::high_resolution_clock::now();
+    utility::TimeReport::Scope timer(report, pass_name, "pass",
+                                     split ? nullptr : &block);
 
     // 2. Execution
-    const bool pass_mutated_ir = pass->Run(block);
+    // Split even without a pool: a kPartition pass cannot see across the
+    // cuts, so skipping them at one thread would change the result.
+    if (!split && pass->scope() == PassScope::kPartition) {
+      const auto ranges = PartitionBlock(block, context_.max_partitions,
+                                         context_.min_partition_ops);
+      if (ranges.size() > 1) {
+        split.emplace(block, ranges);
+        split_end = i + 1;
+        // Dumps and verification need the joined block after every pass.
+        if (!context_.print_ir_after_all && !context_.verify_each) {
+          while (split_end < passes_.size() &&
+                 passes_[split_end]->scope() == PassScope::kPartition) {
+            ++split_end;
+          }
+        }
+      }
+    }
+
+    bool pass_mutated_ir;
+    if (split) {
+      pass_mutated_ir = RunOnPartitions(*pass, *split);
+      if (i + 1 == split_end) {
+        split.reset();  // Joins back into `block`.
+        timer.set_block(&block);
+      } else {
+        timer.set_block(nullptr);
+      }
+    } else if (pool_ && pass->scope() == PassScope::kOperation) {
+      pass_mutated_ir = RunOnOperations(*pass, block);
+    } else {
+      pass_mutated_ir = pass->Run(block);
+    }
     graph_changed_overall |= pass_mutated_ir;
 
     // 3. Instrumentation: Calculate duration
@@ -59,7 +117,13 @@ std::expected<bool, PassError> PassManager::Run(sir::Block& block) {
     // 5. Verification: Enforce structural invariants
     if (context_.verify_each) {
       if (!block.Verify(context_.diags)) {
-        if (context_.diags) {
+        // A compilation records the failure and carries on to its caller;
+        // a bare pipeline has only the pass diagnostics to stop it.
+        if (compilation_) {
+          compilation_->diagnostics().Report(
+              utility::DiagnosticSeverity::kError, pass_name,
+              "Verification failed after pass");
+        } else if (context_.diags) {
           context_.diags->Report(diagnostics::Level::Fatal)
               << "Verification failed after pass: " << pass_name;
         }
@@ -73,4 +137,43 @@ std::expected<bool, PassError> PassManager::Run(sir::Block& block) {
   return graph_changed_overall;
 }
 
+bool PassManager::RunOnPartitions(Pass& pass, PartitionedBlock& partitions) {
+  // One lane per partition rather than per thread: each partition then
+  // allocates the same way regardless of which worker picks it up.
+  sir::Arena& arena = partitions.parent().arena();
+  std::vector<uint8_t> mutated(partitions.size(), 0);
+  const auto run = [&](size_t k) {
+    sir::Arena::LaneScope lane(arena, k);
+    mutated[k] = pass.Run(partitions.partition(k));
+  };
+  if (pool_) {
+    pool_->ParallelFor(partitions.size(), run);
+  } else {
+    for (size_t k = 0; k < partitions.size(); ++k) run(k);
+  }
+  return std::any_of(mutated.begin(), mutated.end(),
+                     [](uint8_t m) { return m != 0; });
+}
+
+bool PassManager::RunOnOperations(Pass& pass, sir::Block& block) {
+  std::vector<sir::Operation*> ops;
+  ops.reserve(block.numOps());
+  for (sir::Operation* op : block.operations()) ops.push_back(op);
+
+  const size_t num_chunks = std::min(
+      ops.size(), pool_->size() * context_.chunks_per_thread);
+  std::vector<uint8_t> mutated(num_chunks, 0);
+  pool_->ParallelFor(num_chunks, [&](size_t c) {
+    // Attribute updates may spill into the arena.
+    sir::Arena::LaneScope lane(block.arena(), c);
+    const size_t begin = c * ops.size() / num_chunks;
+    const size_t end = (c + 1) * ops.size() / num_chunks;
+    bool changed = false;
+    for (size_t i = begin; i < end; ++i) changed |= pass.RunOnOperation(*ops[i]);
+    mutated[c] = changed;
+  });
+  return std::any_of(mutated.begin(), mutated.end(),
+                     [](uint8_t m) { return m != 0; });
+}
+
 }  // namespace seecpp::middle_end
@@ -11,6 +11,11 @@
 #include "seecpp/middle_end/passes/pass.h"
 #include "seecpp/sir/sir.h"
 #include "seecpp/utility/result.h" // <-- C++20 Fallback
+#include "seecpp/utility/thread_pool.h"
+
+namespace seecpp::utility {
+class CompilationContext;
+}
 
 namespace seecpp::middle_end {
 
@@ -20,10 +25,24 @@ enum class PassError {
   kInitializationFailed
 };
 
+class PartitionedBlock;
+
+/// @brief Runs a pipeline of passes over a block.
+///
+/// kPartition passes run on the partitions of a large block, concurrently
+/// when `PassContext::num_threads` is above one and one after another
+/// otherwise; kOperation passes run on chunks of its ops. The cuts depend
+/// only on the block, and partitions are spliced back in program order, so
+/// the resulting IR does not depend on the thread count or on scheduling.
+/// Consecutive kPartition passes share one split unless IR dumps or
+/// verification need the joined block after every pass.
 class PassManager {
  public:
-  explicit PassManager(PassContext context) : context_(std::move(context)) {}
-  ~PassManager() = default;
+  /// @param compilation Optional owning compilation; failures are recorded in
+  ///        its diagnostics so concurrent compiles report independently.
+  explicit PassManager(PassContext context,
+                       utility::CompilationContext* compilation = nullptr);
+  ~PassManager();
 
   PassManager(const PassManager&) = delete;
   PassManager& operator=(const PassManager&) = delete;
@@ -41,8 +60,13 @@ class PassManager {
   [[nodiscard]] utility::Result<bool, PassError> Run(sir::Block& block);
 
  private:
+  bool RunOnPartitions(Pass& pass, PartitionedBlock& partitions);
+  bool RunOnOperations(Pass& pass, sir::Block& block);
+
   std::vector<std::unique_ptr<Pass>> passes_;
   PassContext context_;
+  utility::CompilationContext* compilation_;
+  std::unique_ptr<utility::ThreadPool> pool_;  // Null when running serially.
 };
 
 }  // namespace seecpp::middle_end
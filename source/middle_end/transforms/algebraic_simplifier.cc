@@ -1,158 +1,163 @@
 #include "source/middle_end/transforms/algebraic_simplifier.h"
 
-#include <string>
-#include <string_view>
+#include <format>
+#include <optional>
+#include <type_traits>
+#include <variant>
 #include <vector>
 
-#include "include/utility/logger.hpp"
+#include "include/utility/logger.h"
 #include "seecpp/sir/sir.h"
 
 namespace seecpp::middle_end::transforms {
 
-bool AlgebraicSimplifier::Run(sir::Block& block) {
-  bool graph_changed = false;
-  bool pass_changed;
-
-  // Fixed-point iteration: continue applying rules until the graph converges.
-  // This ensures cascaded optimizations (e.g., (x * 1) + 0 -> x + 0 -> x)
-  // are fully resolved.
-  do {
-    pass_changed = false;
-    
-    // Snapshot the operations to safely iterate. Modifying the block directly
-    // during traversal would invalidate standard iterators.
-    std::vector<sir::Operation> current_ops = block.operations();
-
-    for (auto& op : current_ops) {
-      // If the operation was already erased in this specific pass, skip it.
-      if (!block.HasOperation(op.name())) continue;
-
-      std::string_view mnemonic = op.mnemonic();
-      bool op_changed = false;
-
-      if (mnemonic == "Add") {
-        op_changed = TrySimplifyAdd(op, block);
-      } else if (mnemonic == "Mul") {
-        op_changed = TrySimplifyMul(op, block);
-      } else if (mnemonic == "Pow") {
-        op_changed = TrySimplifyPow(op, block);
-      }
-
-      if (op_changed) {
-        pass_changed = true;
-        graph_changed = true;
-      }
+using sir::ApplyPatternsGreedily;
+using sir::PatternRewriter;
+using sir::RewritePattern;
+using sir::RewriteStats;
+
+namespace {
+
+/// @brief The value of `v` if it is produced by a single-element constant.
+std::optional<double> ScalarConstant(const sir::Value* v) {
+  const sir::Operation* producer = v->definingOp();
+  if (!producer || !producer->is(sir::op::kConstant)) return std::nullopt;
+
+  const sir::AttributeValue* payload =
+      producer->getAttribute(sir::attr::kValue);
+  if (!payload) return std::nullopt;
+
+  return std::visit([](const auto& val) -> std::optional<double> {
+    using T = std::decay_t<decltype(val)>;
+    if constexpr (std::is_arithmetic_v<T>) {
+      return static_cast<double>(val);
+    } else if constexpr (std::is_same_v<T, std::vector<int64_t>> ||
+                         std::is_same_v<T, std::vector<float>>) {
+      if (val.size() == 1) return static_cast<double>(val[0]);
+      return std::nullopt;
+    } else {
+      return std::nullopt;
     }
-  } while (pass_changed);
-
-  if (graph_changed) {
-    utility::Logger::debug("AlgebraicSimplifier: Optimization converged.");
-  }
-  
-  return graph_changed;
+  }, *payload);
 }
 
-bool AlgebraicSimplifier::TrySimplifyAdd(sir::Operation& op,
-                                         sir::Block& block) {
-  const auto& operands = op.operand_names();
-  if (operands.size() != 2) return false;
-
-  std::string lhs = operands[0];
-  std::string rhs = operands[1];
-  std::string simplified_node;
+bool IsScalarConstant(const sir::Value* v, double expected) {
+  auto c = ScalarConstant(v);
+  return c && *c == expected;
+}
 
-  // Identity Removal: x + 0 -> x
-  if (IsScalarConstant(rhs, block, 0.0f)) {
-    simplified_node = lhs;
-  } else if (IsScalarConstant(lhs, block, 0.0f)) {
-    simplified_node = rhs;
-  }
+/// @brief A value can stand in for an op's result only if no broadcast was
+/// hiding behind the identity.
+bool SameType(const sir::Value* a, const sir::Value* b) {
+  return a->dtype() == b->dtype() && a->shape() == b->shape();
+}
 
-  if (!simplified_node.empty()) {
-    // Rewire all downstream consumers to point to the simplified node,
-    // then safely prune the redundant addition from the graph.
-    block.ReplaceAllUsesWith(op.name(), simplified_node);
-    block.EraseOperation(op.name());
-    return true;
-  }
-  
-  return false;
+/// @brief Replaces `op` with `v` when the types allow it.
+bool ForwardOperand(sir::Operation* op, sir::Value* v,
+                    PatternRewriter& rewriter) {
+  if (!SameType(op->result(), v)) return false;
+  rewriter.ReplaceOp(op, {v});
+  return true;
 }
 
-bool AlgebraicSimplifier::TrySimplifyMul(sir::Operation& op,
-                                         sir::Block& block) {
-  const auto& operands = op.operand_names();
-  if (operands.size() != 2) return false;
+// Identity Removal: x + 0 -> x
+class AddZero final : public RewritePattern {
+ public:
+  AddZero() : RewritePattern(sir::op::kAdd) {}
 
-  std::string lhs = operands[0];
-  std::string rhs = operands[1];
-  std::string simplified_node;
+  bool MatchAndRewrite(sir::Operation* op,
+                       PatternRewriter& rewriter) const override {
+    if (op->numOperands() != 2 || op->numResults() != 1) return false;
+    sir::Value* lhs = op->operand(0);
+    sir::Value* rhs = op->operand(1);
 
-  // Identity Removal: x * 1 -> x
-  if (IsScalarConstant(rhs, block, 1.0f)) {
-    simplified_node = lhs;
-  } else if (IsScalarConstant(lhs, block, 1.0f)) {
-    simplified_node = rhs;
-  }
-  // Zero Property: x * 0 -> 0
-  else if (IsScalarConstant(rhs, block, 0.0f)) {
-    simplified_node = rhs;
-  } else if (IsScalarConstant(lhs, block, 0.0f)) {
-    simplified_node = lhs;
+    if (IsScalarConstant(rhs, 0.0)) return ForwardOperand(op, lhs, rewriter);
+    if (IsScalarConstant(lhs, 0.0)) return ForwardOperand(op, rhs, rewriter);
+    return false;
   }
-
-  if (!simplified_node.empty()) {
-    block.ReplaceAllUsesWith(op.name(), simplified_node);
-    block.EraseOperation(op.name());
-    return true;
+};
+
+// Identity Removal: x * 1 -> x
+// Zero Property:    x * 0 -> 0
+class MulIdentity final : public RewritePattern {
+ public:
+  MulIdentity() : RewritePattern(sir::op::kMul) {}
+
+  bool MatchAndRewrite(sir::Operation* op,
+                       PatternRewriter& rewriter) const override {
+    if (op->numOperands() != 2 || op->numResults() != 1) return false;
+    sir::Value* lhs = op->operand(0);
+    sir::Value* rhs = op->operand(1);
+
+    if (IsScalarConstant(rhs, 1.0)) return ForwardOperand(op, lhs, rewriter);
+    if (IsScalarConstant(lhs, 1.0)) return ForwardOperand(op, rhs, rewriter);
+    if (IsScalarConstant(rhs, 0.0)) return ForwardOperand(op, rhs, rewriter);
+    if (IsScalarConstant(lhs, 0.0)) return ForwardOperand(op, lhs, rewriter);
+    return false;
   }
-  
-  return false;
-}
-
-bool AlgebraicSimplifier::TrySimplifyPow(sir::Operation& op,
-                                         sir::Block& block) {
-  const auto& operands = op.operand_names();
-  if (operands.size() != 2) return false;
-
-  std::string base = operands[0];
-  std::string exp = operands[1];
-
-  // Strength Reduction: x^2 -> x * x
-  if (IsScalarConstant(exp, block, 2.0f)) {
-    // Replace the expensive Power operation with a cheap Multiply operation.
-    // We reuse the name of the Pow node so downstream dependencies naturally
-    // pick up the new instruction without needing a full Re-Use wiring.
-    sir::Operation new_mul =
-        sir::Operation::Create(op.name(), "Mul", {base, base});
-    block.ReplaceOperation(op.name(), new_mul);
-    return true;
+};
+
+// Strength Reduction: x ^ 2 -> x * x
+// Identity Removal:   x ^ 1 -> x
+class PowReduction final : public RewritePattern {
+ public:
+  PowReduction() : RewritePattern(sir::op::kPow) {}
+
+  bool MatchAndRewrite(sir::Operation* op,
+                       PatternRewriter& rewriter) const override {
+    if (op->numOperands() != 2 || op->numResults() != 1) return false;
+    sir::Value* base = op->operand(0);
+    sir::Value* exp = op->operand(1);
+
+    if (IsScalarConstant(exp, 1.0)) return ForwardOperand(op, base, rewriter);
+
+    if (IsScalarConstant(exp, 2.0)) {
+      // Replace the expensive Power operation with a cheap Multiply operation.
+      const sir::Value* out = op->result();
+      sir::Operation* mul = rewriter.CreateOp(
+          sir::op::kMul, {base, base}, {out->dtype()}, {out->shape()});
+      rewriter.ReplaceOp(op, {mul->result()});
+      return true;
+    }
+    return false;
   }
+};
 
-  // Identity Removal: x^1 -> x
-  if (IsScalarConstant(exp, block, 1.0f)) {
-    block.ReplaceAllUsesWith(op.name(), base);
-    block.EraseOperation(op.name());
-    return true;
-  }
+}  // namespace
 
-  return false;
+AlgebraicSimplifier::AlgebraicSimplifier() {
+  patterns_.Add<AddZero>();
+  patterns_.Add<MulIdentity>();
+  patterns_.Add<PowReduction>();
 }
 
-bool AlgebraicSimplifier::IsScalarConstant(std::string_view node_name,
-                                           const sir::Block& block,
-                                           float expected_value) const {
-  const sir::Operation* producer = block.GetOperation(std::string(node_name));
-  
-  // To match a pattern, the producing node must exist and be a 'Constant'
-  if (!producer || producer->mnemonic() != "Constant") {
-    return false;
+bool AlgebraicSimplifier::Run(sir::Block& block) {
+  // Cascaded optimizations (e.g., (x * 1) + 0 -> x + 0 -> x) are resolved by
+  // the worklist: replacing x * 1 re-queues the add that consumed it.
+  const RewriteStats stats = ApplyPatternsGreedily(block, patterns_);
+
+  if (!stats.converged) {
+    utility::Logger::Warn(std::format(
+        "AlgebraicSimplifier: Stopped after {} rewrite(s) without converging.",
+        stats.rewrites));
+  } else if (stats.rewrites > 0) {
+    utility::Logger::Debug(std::format(
+        "AlgebraicSimplifier: {} rewrite(s), {} op visit(s) in {} us.",
+        stats.rewrites, stats.visits, stats.elapsed.count()));
   }
 
-  // NOTE: This assumes the 'Constant' operation in the SIR supports querying
-  // its payload. In a fully wired compiler, this might bridge to the
-  // previously built `ConstantFolder` or `WeightBuffer`.
-  return producer->GetScalarValueAsFloat() == expected_value;
+  // Partitions run concurrently; this is the only state they share.
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  stats_.rewrites += stats.rewrites;
+  stats_.visits += stats.visits;
+  stats_.converged = stats_.converged && stats.converged;
+  stats_.elapsed += stats.elapsed;
+  return stats.rewrites > 0;
+}
+
+RewriteStats AlgebraicSimplifier::stats() const {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  return stats_;
 }
 
 }  // namespace seecpp::middle_end::transforms
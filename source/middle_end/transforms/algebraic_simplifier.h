@@ -1,8 +1,11 @@
 #ifndef SEECPP_MIDDLE_END_TRANSFORMS_ALGEBRAIC_SIMPLIFIER_H_
 #define SEECPP_MIDDLE_END_TRANSFORMS_ALGEBRAIC_SIMPLIFIER_H_
 
+#include <mutex>
 #include <string_view>
 
+#include "seecpp/middle_end/passes/pass.h"
+#include "seecpp/sir/rewrite_driver.h"
 #include "seecpp/sir/sir.h"
 
 namespace seecpp::middle_end::transforms {
@@ -10,31 +13,38 @@ namespace seecpp::middle_end::transforms {
 /// @brief Executes peephole optimizations on the SIR graph.
 /// Applies algebraic identities and strength reduction to simplify the
 /// computational graph for optimal backend performance.
-class AlgebraicSimplifier {
+///
+/// Every pattern looks only at an op and its operands' producers, so the
+/// pass runs per partition. An identity whose constant was defined in
+/// another partition arrives as a block argument and is left alone.
+class AlgebraicSimplifier : public Pass {
  public:
-  AlgebraicSimplifier() = default;
-  ~AlgebraicSimplifier() = default;
+  AlgebraicSimplifier();
+  ~AlgebraicSimplifier() override = default;
 
   AlgebraicSimplifier(const AlgebraicSimplifier&) = delete;
   AlgebraicSimplifier& operator=(const AlgebraicSimplifier&) = delete;
 
+  std::string_view name() const override { return "algebraic-simplifier"; }
+  PassScope scope() const override { return PassScope::kPartition; }
+
   /// @brief Runs the algebraic simplification pass over the block until it
   /// reaches a fixed point (convergence).
   /// @param block The SIR block to optimize.
   /// @return True if the block was modified at all, false otherwise.
-  bool Run(sir::Block& block);
+  bool Run(sir::Block& block) override;
+
+  /// @brief Statistics summed over every Run() since construction; the
+  /// partitions of a split block each add their share.
+  sir::RewriteStats stats() const;
 
  private:
-  // Pattern matchers that return true if a transformation was applied.
-  bool TrySimplifyAdd(sir::Operation& op, sir::Block& block);
-  bool TrySimplifyMul(sir::Operation& op, sir::Block& block);
-  bool TrySimplifyPow(sir::Operation& op, sir::Block& block);
-
-  /// @brief Utility to check if a node represents a specific scalar constant.
-  /// This interfaces with the constant environment to verify static values.
-  [[nodiscard]] bool IsScalarConstant(std::string_view node_name,
-                                      const sir::Block& block,
-                                      float expected_value) const;
+  // Identity removal (x + 0, x * 1, x ^ 1), the zero property (x * 0) and
+  // strength reduction (x ^ 2 -> x * x), indexed by root opcode.
+  sir::RewritePatternSet patterns_;
+
+  mutable std::mutex stats_mutex_;
+  sir::RewriteStats stats_;
 };
 
 }  // namespace seecpp::middle_end::transforms
@@ -0,0 +1,188 @@
+#include "source/middle_end/transforms/common_subexpression_elimination.h"
+
+#include <bit>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+
+#include "include/utility/logger.h"
+
+namespace seecpp::middle_end::transforms {
+
+namespace {
+
+size_t HashCombine(size_t seed, size_t v) {
+  return seed ^ (v + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+}
+
+// Floating-point attributes are hashed and compared by bit pattern, so 0.0
+// and -0.0 stay distinct and a NaN payload still matches itself.
+template <typename T>
+size_t HashScalar(T v) {
+  if constexpr (std::is_same_v<T, float>) {
+    return std::hash<uint32_t>{}(std::bit_cast<uint32_t>(v));
+  } else if constexpr (std::is_same_v<T, double>) {
+    return std::hash<uint64_t>{}(std::bit_cast<uint64_t>(v));
+  } else {
+    return std::hash<T>{}(v);
+  }
+}
+
+template <typename T>
+bool ScalarEqual(T a, T b) {
+  if constexpr (std::is_same_v<T, float>) {
+    return std::bit_cast<uint32_t>(a) == std::bit_cast<uint32_t>(b);
+  } else if constexpr (std::is_same_v<T, double>) {
+    return std::bit_cast<uint64_t>(a) == std::bit_cast<uint64_t>(b);
+  } else {
+    return a == b;
+  }
+}
+
+size_t HashAttribute(const sir::AttributeValue& value) {
+  const size_t payload = std::visit([](const auto& v) -> size_t {
+    using T = std::decay_t<decltype(v)>;
+    if constexpr (std::is_same_v<T, std::vector<int64_t>> ||
+                  std::is_same_v<T, std::vector<float>>) {
+      size_t h = v.size();
+      for (auto e : v) h = HashCombine(h, HashScalar(e));
+      return h;
+    } else {
+      return HashScalar(v);
+    }
+  }, value);
+  return HashCombine(value.index(), payload);
+}
+
+bool AttributeEqual(const sir::AttributeValue& a,
+                    const sir::AttributeValue& b) {
+  if (a.index() != b.index()) return false;
+  return std::visit([&b](const auto& lhs) -> bool {
+    using T = std::decay_t<decltype(lhs)>;
+    const T& rhs = std::get<T>(b);
+    if constexpr (std::is_same_v<T, std::vector<int64_t>> ||
+                  std::is_same_v<T, std::vector<float>>) {
+      if (lhs.size() != rhs.size()) return false;
+      for (size_t i = 0; i < lhs.size(); ++i)
+        if (!ScalarEqual(lhs[i], rhs[i])) return false;
+      return true;
+    } else {
+      return ScalarEqual(lhs, rhs);
+    }
+  }, a);
+}
+
+size_t HashOp(const sir::Operation* op) {
+  size_t h = std::hash<sir::OpId>{}(op->opId());
+  for (const sir::Value* operand : op->operands())
+    h = HashCombine(h, std::hash<const sir::Value*>{}(operand));
+  // AttributeList keeps entries sorted by AttrId, so equal sets hash equally.
+  // Source info is skipped: the surviving op keeps its own.
+  for (const auto& [key, value] : op->attributes().entries()) {
+    if (sir::attr::isSourceInfo(key)) continue;
+    h = HashCombine(HashCombine(h, key), HashAttribute(value));
+  }
+  for (const sir::Value* result : op->results()) {
+    h = HashCombine(h, static_cast<size_t>(result->dtype()));
+    for (int64_t d : result->shape().dims) h = HashCombine(h, HashScalar(d));
+  }
+  return h;
+}
+
+bool OpEqual(const sir::Operation* a, const sir::Operation* b) {
+  if (a->opId() != b->opId() || a->numOperands() != b->numOperands() ||
+      a->numResults() != b->numResults()) {
+    return false;
+  }
+  for (size_t i = 0; i < a->numOperands(); ++i)
+    if (a->operand(i) != b->operand(i)) return false;
+
+  const auto a_attrs = a->attributes().entries();
+  const auto b_attrs = b->attributes().entries();
+  size_t ai = 0, bi = 0;
+  while (true) {
+    while (ai < a_attrs.size() && sir::attr::isSourceInfo(a_attrs[ai].first)) ++ai;
+    while (bi < b_attrs.size() && sir::attr::isSourceInfo(b_attrs[bi].first)) ++bi;
+    if (ai == a_attrs.size() || bi == b_attrs.size()) break;
+    if (a_attrs[ai].first != b_attrs[bi].first ||
+        !AttributeEqual(a_attrs[ai].second, b_attrs[bi].second)) {
+      return false;
+    }
+    ++ai;
+    ++bi;
+  }
+  if (ai != a_attrs.size() || bi != b_attrs.size()) return false;
+
+  for (size_t i = 0; i < a->numResults(); ++i) {
+    const sir::Value* ra = a->result(i);
+    const sir::Value* rb = b->result(i);
+    if (ra->dtype() != rb->dtype() || ra->shape() != rb->shape()) return false;
+  }
+  return true;
+}
+
+/// @brief An op with its structural hash, computed once on lookup.
+struct OpKey {
+  sir::Operation* op;
+  size_t hash;
+};
+
+struct OpKeyHash {
+  size_t operator()(const OpKey& key) const { return key.hash; }
+};
+
+struct OpKeyEqual {
+  bool operator()(const OpKey& a, const OpKey& b) const {
+    return a.hash == b.hash && OpEqual(a.op, b.op);
+  }
+};
+
+}  // namespace
+
+bool CommonSubexpressionElimination::Run(sir::Block& block) {
+  last_stats_ = {};
+  const size_t bytes_before = block.arena().bytesInUse();
+
+  std::unordered_set<OpKey, OpKeyHash, OpKeyEqual> known;
+  known.reserve(block.numOps());
+
+  block.walk([&](sir::Operation* op) {
+    if (!IsCandidate(op)) return;
+
+    auto [it, inserted] = known.insert(OpKey{op, HashOp(op)});
+    if (inserted) return;
+
+    // `it->op` precedes `op`, so it dominates every use being redirected.
+    for (size_t i = 0; i < op->numResults(); ++i)
+      op->result(i)->replaceAllUsesWith(it->op->result(i));
+    block.removeOp(op);
+    ++last_stats_.ops_erased;
+  });
+
+  if (last_stats_.ops_erased == 0) return false;
+
+  // Redirected uses can grow the survivors' user lists by more than the
+  // erased ops gave back.
+  const size_t bytes_after = block.arena().bytesInUse();
+  last_stats_.bytes_freed =
+      bytes_before > bytes_after ? bytes_before - bytes_after : 0;
+  utility::Logger::Debug(std::format(
+      "CommonSubexpressionElimination: erased {} duplicate op(s), "
+      "freed {} arena byte(s).",
+      last_stats_.ops_erased, last_stats_.bytes_freed));
+  return true;
+}
+
+bool CommonSubexpressionElimination::IsCandidate(const sir::Operation* op) {
+  if (op->numResults() == 0) return false;
+  if (!op->isHighLevel() && !op->isLowLevel()) return false;
+  return !op->is(sir::op::kReturn) && !op->is(sir::op::kYield) &&
+         !op->is(sir::op::kLowReturn);
+}
+
+}  // namespace seecpp::middle_end::transforms
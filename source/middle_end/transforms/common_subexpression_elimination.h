@@ -0,0 +1,54 @@
+#ifndef SEECPP_MIDDLE_END_TRANSFORMS_COMMON_SUBEXPRESSION_ELIMINATION_H_
+#define SEECPP_MIDDLE_END_TRANSFORMS_COMMON_SUBEXPRESSION_ELIMINATION_H_
+
+#include <cstddef>
+
+#include "seecpp/sir/sir.h"
+
+namespace seecpp::middle_end::transforms {
+
+struct CseStats {
+  size_t ops_erased = 0;    // Duplicate ops folded into an earlier twin.
+  size_t bytes_freed = 0;   // Arena bytes released by the erased ops.
+};
+
+/// @brief Merges structurally identical pure operations.
+///
+/// Two ops are equivalent when they share an opcode, the same operand
+/// values, equal attributes and equal result types. The block is walked in
+/// program order, so the first op of each equivalence class dominates the
+/// rest and absorbs their uses. Operands are compared after earlier merges
+/// have been applied, which lets chains of duplicates (e.g. a view_cast of
+/// a duplicated transpose) collapse in a single sweep.
+///
+/// Reads the arena totals for its statistics, so it must not run while
+/// other tasks allocate from the same arena, e.g. inside a partition.
+class CommonSubexpressionElimination {
+ public:
+  CommonSubexpressionElimination() = default;
+  ~CommonSubexpressionElimination() = default;
+
+  CommonSubexpressionElimination(const CommonSubexpressionElimination&) =
+      delete;
+  CommonSubexpressionElimination& operator=(
+      const CommonSubexpressionElimination&) = delete;
+
+  /// @brief Executes the CSE pass over the block.
+  /// @return True if any duplicate operations were removed.
+  bool Run(sir::Block& block);
+
+  /// @brief Statistics of the most recent Run().
+  const CseStats& last_stats() const { return last_stats_; }
+
+ private:
+  /// @brief Only ops without side effects may be merged: high- and low-level
+  /// compute ops that produce results. Memory, control-flow, terminator and
+  /// unregistered ops are left untouched.
+  [[nodiscard]] static bool IsCandidate(const sir::Operation* op);
+
+  CseStats last_stats_;
+};
+
+}  // namespace seecpp::middle_end::transforms
+
+#endif  // SEECPP_MIDDLE_END_TRANSFORMS_COMMON_SUBEXPRESSION_ELIMINATION_H_
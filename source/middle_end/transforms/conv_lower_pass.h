@@ -5,24 +5,30 @@
 #include <unordered_set>
 
 #include "seecpp/diagnostics/diagnostics_engine.h"
+#include "seecpp/middle_end/passes/pass.h"
 #include "seecpp/sir/sir.h"
 
 namespace seecpp::middle_end::transforms::lowering {
 
 /// @brief Lowers high-level spatial convolution operations (forward and backward)
 /// into hardware-aligned linear algebra primitives (im2col, col2im, matmul).
-class ConvLowering {
+/// Each conv expands in place, but the pass runs on the whole block: it
+/// reports through the shared diagnostics engine and finishes with a CSE
+/// sweep, neither of which may run on several partitions at once.
+class ConvLowering : public Pass {
  public:
   explicit ConvLowering(diagnostics::DiagnosticsEngine* diags = nullptr)
       : diags_(diags) {}
-  ~ConvLowering() = default;
+  ~ConvLowering() override = default;
 
   ConvLowering(const ConvLowering&) = delete;
   ConvLowering& operator=(const ConvLowering&) = delete;
 
+  std::string_view name() const override { return "conv-lowering"; }
+
   /// @brief Executes the lowering pass over the block.
   /// @return True if any operations were lowered.
-  bool Run(sir::Block& block);
+  bool Run(sir::Block& block) override;
 
  private:
   bool LowerForward(sir::Block& block, sir::Operation* op);
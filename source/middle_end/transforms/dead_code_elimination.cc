@@ -61,8 +61,7 @@ bool DeadCodeElimination::Run(sir::Block& block) {
 
 bool DeadCodeElimination::IsRootOperation(const sir::Operation* op) const {
   // Explicitly guard return/yield nodes alongside memory and control flow
-  std::string_view mnem = op->mnemonic();
-  if (mnem == "sc_high.return" || mnem == "sc_low.return" || mnem == "sc_high.yield") {
+  if (op->is(sir::op::kReturn) || op->is(sir::op::kLowReturn) || op->is(sir::op::kYield)) {
     return true;
   }
   
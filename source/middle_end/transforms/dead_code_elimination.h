@@ -1,26 +1,36 @@
 #ifndef SEECPP_MIDDLE_END_TRANSFORMS_DEAD_CODE_ELIMINATION_H_
 #define SEECPP_MIDDLE_END_TRANSFORMS_DEAD_CODE_ELIMINATION_H_
 
+#include <string_view>
+
 #include "seecpp/diagnostics/diagnostics_engine.h"
+#include "seecpp/middle_end/passes/pass.h"
 #include "seecpp/sir/sir.h"
 
 namespace seecpp::middle_end::transforms {
 
 /// @brief Removes unreachable or unused operations using a backward 
 /// mark-and-sweep algorithm.
-class DeadCodeElimination {
+///
+/// Runs on the whole block. Inside a partition every escaping value is kept
+/// alive by the yield, so a dead chain crossing a partition boundary would
+/// survive; on the joined block the yield proxies are gone and liveness is
+/// exact.
+class DeadCodeElimination : public Pass {
  public:
   explicit DeadCodeElimination(diagnostics::DiagnosticsEngine* diags = nullptr)
       : diags_(diags) {}
-  ~DeadCodeElimination() = default;
+  ~DeadCodeElimination() override = default;
 
   DeadCodeElimination(const DeadCodeElimination&) = delete;
   DeadCodeElimination& operator=(const DeadCodeElimination&) = delete;
 
+  std::string_view name() const override { return "dce"; }
+
   /// @brief Executes the DCE pass over the block.
   /// @param block The SIR block to clean.
   /// @return True if any dead operations were removed.
-  bool Run(sir::Block& block);
+  bool Run(sir::Block& block) override;
 
  private:
   /// @brief Determines if an operation is a mandatory root (e.g., returns, 
@@ -11,14 +11,32 @@
 namespace seecpp::middle_end::transforms {
 
 namespace {
-// Centralized definitions prevent string-literal typos and make it easier 
-// to map operations during the initial Protobuf/ONNX ingestion phase.
-constexpr std::string_view kOpConv2d = "sc_high.conv2d";
-constexpr std::string_view kOpBatchNorm = "sc_high.batch_norm";
-constexpr std::string_view kOpReluHigh = "sc_high.relu";
-constexpr std::string_view kOpReluLow = "sc_low.relu";
-constexpr std::string_view kOpConstant = "sc_high.constant";
-constexpr std::string_view kOpFusedEw = "sc_high.fused_ew";
+bool IsElementwise(const sir::Operation* op) {
+  switch (op->opId()) {
+    case sir::op::kAdd:
+    case sir::op::kMul:
+    case sir::op::kSub:
+    case sir::op::kDiv:
+    case sir::op::kFusedEw:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// A fused op stands for both source nodes folded into it: "conv1+bn1".
+void MergeSourceInfo(sir::Operation* into, const sir::Operation* first,
+                     const sir::Operation* second) {
+  for (sir::AttrId id : {sir::attr::kSourceNode, sir::attr::kSourceOpType}) {
+    auto a = first->getAttrAs<std::string>(id);
+    auto b = second->getAttrAs<std::string>(id);
+    if (a && b) {
+      into->setAttribute(id, std::format("{}+{}", *a, *b));
+    } else if (a || b) {
+      into->setAttribute(id, a ? *a : *b);
+    }
+  }
+}
 }  // namespace
 
 bool KernelFuser::Run(sir::Block& block) {
@@ -42,7 +60,7 @@ bool KernelFuser::FoldConvBatchNorm(sir::Block& block) {
   std::vector<sir::Operation*> to_delete;
 
   block.walk([&](sir::Operation* op) {
-    if (op->mnemonic() == kOpBatchNorm) bn_ops.push_back(op);
+    if (op->is(sir::op::kBatchNorm)) bn_ops.push_back(op);
   });
 
   for (auto* bn : bn_ops) {
@@ -69,11 +87,7 @@ bool KernelFuser::FuseElementwiseChains(sir::Block& block) {
     std::vector<sir::Operation*> to_delete;
 
     block.walk([&](sir::Operation* op) {
-      std::string_view mn = op->mnemonic();
-      if (mn == "sc_high.add" || mn == "sc_high.mul" ||
-          mn == "sc_high.sub" || mn == "sc_high.div" || mn == kOpFusedEw) {
-        ew_ops.push_back(op);
-      }
+      if (IsElementwise(op)) ew_ops.push_back(op);
     });
 
     for (auto* consumer : ew_ops) {
@@ -106,7 +120,7 @@ bool KernelFuser::TryFoldConvBatchNorm(
   sir::Value* bn_input = bn_op->operand(0);
   sir::Operation* conv_op = bn_input->definingOp();
 
-  if (!conv_op || conv_op->mnemonic() != kOpConv2d) return false;
+  if (!conv_op || !conv_op->is(sir::op::kConv2d)) return false;
   
   if (!bn_input->hasOneUse()) {
     if (diags_) {
@@ -117,7 +131,7 @@ bool KernelFuser::TryFoldConvBatchNorm(
   }
 
   auto is_constant = [](sir::Value* v) -> bool {
-    return v && v->definingOp() && v->definingOp()->mnemonic() == kOpConstant;
+    return v && v->definingOp() && v->definingOp()->is(sir::op::kConstant);
   };
 
   if (!is_constant(bn_op->operand(1)) || !is_constant(bn_op->operand(2)) || 
@@ -125,15 +139,16 @@ bool KernelFuser::TryFoldConvBatchNorm(
     return false;
   }
 
-  float epsilon = bn_op->getAttrAs<float>("epsilon").value_or(1e-5f);
+  float epsilon = bn_op->getAttrAs<float>(sir::attr::kEpsilon).value_or(1e-5f);
 
   // Directly embed the batch norm constants into the Convolution's static footprint.
-  conv_op->setAttribute("fused_bn", int64_t(1));
-  conv_op->setAttribute("bn_epsilon", epsilon);
-  conv_op->setAttribute("bn_scale_id", std::string(bn_op->operand(1)->id()));
-  conv_op->setAttribute("bn_bias_id", std::string(bn_op->operand(2)->id()));
-  conv_op->setAttribute("bn_mean_id", std::string(bn_op->operand(3)->id()));
-  conv_op->setAttribute("bn_var_id", std::string(bn_op->operand(4)->id()));
+  conv_op->setAttribute(sir::attr::kFusedBn, int64_t(1));
+  conv_op->setAttribute(sir::attr::kBnEpsilon, epsilon);
+  conv_op->setAttribute(sir::attr::kBnScaleId, std::string(bn_op->operand(1)->id()));
+  conv_op->setAttribute(sir::attr::kBnBiasId, std::string(bn_op->operand(2)->id()));
+  conv_op->setAttribute(sir::attr::kBnMeanId, std::string(bn_op->operand(3)->id()));
+  conv_op->setAttribute(sir::attr::kBnVarId, std::string(bn_op->operand(4)->id()));
+  MergeSourceInfo(conv_op, conv_op, bn_op);
 
   bn_op->result(0)->replaceAllUsesWith(conv_op->result(0));
   
@@ -152,24 +167,20 @@ bool KernelFuser::TryFuseElementwisePair(
     
     if (!producer || dead_ids.count(producer->id())) continue;
 
-    std::string_view pmn = producer->mnemonic();
-    bool is_ew_producer = (
-        pmn == "sc_high.add" || pmn == "sc_high.mul" ||
-        pmn == "sc_high.sub" || pmn == "sc_high.div" || pmn == kOpFusedEw);
-
-    if (!is_ew_producer || !v->hasOneUse()) continue;
+    if (!IsElementwise(producer) || !v->hasOneUse()) continue;
 
-    std::string p_seq = (pmn == kOpFusedEw) 
-        ? producer->getAttrAs<std::string>("op_sequence").value_or("unknown")
-        : std::string(pmn);
+    std::string p_seq = producer->is(sir::op::kFusedEw)
+        ? producer->getAttrAs<std::string>(sir::attr::kOpSequence).value_or("unknown")
+        : std::string(producer->mnemonic());
 
-    std::string c_seq = (consumer_op->mnemonic() == kOpFusedEw)
-        ? consumer_op->getAttrAs<std::string>("op_sequence").value_or("unknown")
+    std::string c_seq = consumer_op->is(sir::op::kFusedEw)
+        ? consumer_op->getAttrAs<std::string>(sir::attr::kOpSequence).value_or("unknown")
         : std::string(consumer_op->mnemonic());
 
     // Topological insertion keeps the graph strictly ordered for the backend generator.
-    auto fused_op = block.insertOpBefore(std::string(kOpFusedEw), consumer_op);
-    fused_op->setAttribute("op_sequence", std::format("{}+{}", p_seq, c_seq));
+    auto fused_op = block.insertOpBefore(sir::op::kFusedEw, consumer_op);
+    fused_op->setAttribute(sir::attr::kOpSequence, std::format("{}+{}", p_seq, c_seq));
+    MergeSourceInfo(fused_op, producer, consumer_op);
 
     for (size_t j = 0; j < producer->numOperands(); ++j) {
       fused_op->addOperand(producer->operand(j));
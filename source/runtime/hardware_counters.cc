@@ -0,0 +1,228 @@
+#include "src/runtime/hardware_counters.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <format>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace seecpp::runtime {
+
+namespace {
+
+#if defined(__linux__)
+struct EventConfig {
+    uint32_t type;
+    uint64_t config;
+};
+
+constexpr uint64_t CacheReadMiss(uint64_t cache) {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+constexpr std::array<EventConfig, kNumHwEvents> kEventConfigs = {{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, CacheReadMiss(PERF_COUNT_HW_CACHE_L1D)},
+    {PERF_TYPE_HW_CACHE, CacheReadMiss(PERF_COUNT_HW_CACHE_LL)},
+    {PERF_TYPE_HW_CACHE, CacheReadMiss(PERF_COUNT_HW_CACHE_DTLB)},
+}};
+
+int OpenEvent(const EventConfig& event, int group_fd) {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = event.type;
+    attr.config = event.config;
+    attr.disabled = group_fd == -1 ? 1 : 0;  // The leader starts the group.
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                       PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // pid 0, cpu -1: the calling thread, on whichever CPU it runs.
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+#endif
+
+}  // namespace
+
+std::string_view HwEventName(HwEvent event) {
+    switch (event) {
+        case HwEvent::kCycles:       return "cycles";
+        case HwEvent::kInstructions: return "instructions";
+        case HwEvent::kL1dMisses:    return "L1D-read-misses";
+        case HwEvent::kLlcMisses:    return "LLC-read-misses";
+        case HwEvent::kDtlbMisses:   return "dTLB-read-misses";
+    }
+    return "unknown";
+}
+
+// --- PerfCounterGroup ---
+
+std::expected<std::unique_ptr<PerfCounterGroup>, std::string> PerfCounterGroup::Open() {
+#if defined(__linux__)
+    std::unique_ptr<PerfCounterGroup> group(new PerfCounterGroup());
+    std::string first_error;
+    for (size_t e = 0; e < kNumHwEvents; ++e) {
+        const int fd = OpenEvent(kEventConfigs[e], group->leader_);
+        if (fd == -1) {
+            if (first_error.empty()) {
+                first_error = std::format("perf_event_open({}): {}",
+                                          HwEventName(static_cast<HwEvent>(e)), std::strerror(errno));
+            }
+            continue;
+        }
+        if (group->leader_ == -1) group->leader_ = fd;
+        group->slot_[e] = static_cast<int>(group->fds_.size());
+        group->fds_.push_back(fd);
+    }
+    if (group->leader_ == -1) return std::unexpected(first_error);
+
+    ioctl(group->leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(group->leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return group;
+#else
+    return std::unexpected(std::string("perf_event_open is only available on Linux"));
+#endif
+}
+
+PerfCounterGroup::~PerfCounterGroup() {
+#if defined(__linux__)
+    for (int fd : fds_) close(fd);
+#endif
+}
+
+bool PerfCounterGroup::Read(HwReading& out) const {
+#if defined(__linux__)
+    // { nr, time_enabled, time_running, value[nr] }
+    uint64_t buffer[3 + kNumHwEvents];
+    const ssize_t want = static_cast<ssize_t>((3 + fds_.size()) * sizeof(uint64_t));
+    if (read(leader_, buffer, sizeof(buffer)) != want) return false;
+
+    const uint64_t enabled = buffer[1];
+    const uint64_t running = buffer[2];
+    for (size_t e = 0; e < kNumHwEvents; ++e) {
+        if (slot_[e] < 0) continue;
+        uint64_t value = buffer[3 + slot_[e]];
+        // Scale up if the PMU had more events than counters and time-sliced them.
+        if (running != 0 && running < enabled) {
+            value = static_cast<uint64_t>(static_cast<double>(value) * enabled / running);
+        }
+        out[e] = value;
+    }
+    return true;
+#else
+    (void)out;
+    return false;
+#endif
+}
+
+// --- HwOpcodeStats ---
+
+double HwOpcodeStats::ipc() const {
+    const uint64_t cycles = counts[static_cast<size_t>(HwEvent::kCycles)];
+    return cycles ? static_cast<double>(counts[static_cast<size_t>(HwEvent::kInstructions)]) / cycles : 0.0;
+}
+
+double HwOpcodeStats::misses_per_kib(HwEvent event) const {
+    return bytes ? static_cast<double>(counts[static_cast<size_t>(event)]) * 1024.0 / bytes : 0.0;
+}
+
+// --- HardwareCounterProfiler ---
+
+HardwareCounterProfiler::HardwareCounterProfiler(std::vector<uint16_t> opcodes,
+                                                 std::vector<uint64_t> bytes,
+                                                 HwCounterOptions options)
+    : opcodes_(std::move(opcodes)),
+      bytes_(std::move(bytes)),
+      options_(options),
+      accumulators_(opcodes_.size()) {
+    options_.sample_period = std::max<size_t>(options_.sample_period, 1);
+}
+
+PerfCounterGroup* HardwareCounterProfiler::ThreadGroup() {
+    const std::thread::id self = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(groups_mutex_);
+    for (auto& [thread, group] : groups_) {
+        if (thread == self) return group.get();
+    }
+
+    auto opened = PerfCounterGroup::Open();
+    if (!opened) {
+        open_error_ = opened.error();
+        groups_.emplace_back(self, nullptr);
+        return nullptr;
+    }
+    groups_.emplace_back(self, std::move(*opened));
+    return groups_.back().second.get();
+}
+
+std::string HardwareCounterProfiler::unavailable_reason() const {
+    std::lock_guard<std::mutex> lock(groups_mutex_);
+    const bool any = std::any_of(groups_.begin(), groups_.end(),
+                                 [](const auto& g) { return g.second != nullptr; });
+    return any ? std::string() : open_error_;
+}
+
+std::vector<HwEvent> HardwareCounterProfiler::MissingEvents() const {
+    std::lock_guard<std::mutex> lock(groups_mutex_);
+    std::vector<HwEvent> missing;
+    for (size_t e = 0; e < kNumHwEvents; ++e) {
+        const auto event = static_cast<HwEvent>(e);
+        const bool opened = std::any_of(groups_.begin(), groups_.end(), [&](const auto& g) {
+            return g.second && g.second->has(event);
+        });
+        if (!opened) missing.push_back(event);
+    }
+    return missing;
+}
+
+std::vector<HwOpcodeStats> HardwareCounterProfiler::Summarize() const {
+    std::vector<HwOpcodeStats> stats;
+    for (size_t i = 0; i < accumulators_.size(); ++i) {
+        const Accumulator& acc = accumulators_[i];
+        if (acc.samples == 0) continue;
+        auto it = std::find_if(stats.begin(), stats.end(),
+                               [&](const HwOpcodeStats& s) { return s.opcode == opcodes_[i]; });
+        if (it == stats.end()) {
+            stats.push_back(HwOpcodeStats{opcodes_[i]});
+            it = stats.end() - 1;
+        }
+        it->samples += acc.samples;
+        it->bytes += acc.samples * bytes_[i];
+        for (size_t e = 0; e < kNumHwEvents; ++e) it->counts[e] += acc.counts[e];
+    }
+    std::sort(stats.begin(), stats.end(), [](const HwOpcodeStats& a, const HwOpcodeStats& b) {
+        const size_t cycles = static_cast<size_t>(HwEvent::kCycles);
+        return a.counts[cycles] != b.counts[cycles] ? a.counts[cycles] > b.counts[cycles]
+                                                    : a.opcode < b.opcode;
+    });
+    return stats;
+}
+
+std::string HardwareCounterProfiler::Report() const {
+    if (const std::string reason = unavailable_reason(); !reason.empty()) {
+        return "Hardware counters unavailable: " + reason + "\n";
+    }
+
+    std::string out = std::format("{:>8} {:>10} {:>6} {:>14} {:>14} {:>15}\n",
+                                  "opcode", "samples", "IPC", "L1D miss/KiB", "LLC miss/KiB",
+                                  "dTLB miss/KiB");
+    for (const HwOpcodeStats& s : Summarize()) {
+        out += std::format("{:>8} {:>10} {:>6.2f} {:>14.2f} {:>14.2f} {:>15.3f}\n",
+                           s.opcode, s.samples, s.ipc(), s.misses_per_kib(HwEvent::kL1dMisses),
+                           s.misses_per_kib(HwEvent::kLlcMisses),
+                           s.misses_per_kib(HwEvent::kDtlbMisses));
+    }
+    for (HwEvent event : MissingEvents()) {
+        out += std::format("(not supported here: {})\n", HwEventName(event));
+    }
+    return out;
+}
+
+}  // namespace seecpp::runtime
@@ -0,0 +1,143 @@
+#ifndef SEECPP_RUNTIME_HARDWARE_COUNTERS_H_
+#define SEECPP_RUNTIME_HARDWARE_COUNTERS_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace seecpp::runtime {
+
+/// @brief The hardware events sampled around instructions.
+enum class HwEvent : uint8_t {
+    kCycles,
+    kInstructions,
+    kL1dMisses,
+    kLlcMisses,
+    kDtlbMisses,
+};
+inline constexpr size_t kNumHwEvents = 5;
+
+std::string_view HwEventName(HwEvent event);
+
+struct HwCounterOptions {
+    /// @brief Read the counters around every N-th instruction. Each reading
+    /// is a read() syscall of roughly half a microsecond, which slows small
+    /// ops many times over at N = 1. The counts exclude the kernel, so they
+    /// stay meaningful; raise N to keep whole-step timings realistic.
+    size_t sample_period = 1;
+};
+
+/// @brief Scaled counter values at one point in time. Events that could not
+/// be opened stay zero.
+using HwReading = std::array<uint64_t, kNumHwEvents>;
+
+/// @brief A perf_event_open counter group bound to the thread that opened it.
+class PerfCounterGroup {
+ public:
+    /// @brief Opens every HwEvent the kernel and CPU support for the calling
+    /// thread, user space only. Returns an error naming the first failure if
+    /// none can be opened (no PMU in a VM, perf_event_paranoid, seccomp).
+    static std::expected<std::unique_ptr<PerfCounterGroup>, std::string> Open();
+    ~PerfCounterGroup();
+
+    PerfCounterGroup(const PerfCounterGroup&) = delete;
+    PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+
+    /// @brief Reads all counters with one syscall, scaled up if the kernel had
+    /// to multiplex them. Returns false if the read fails.
+    bool Read(HwReading& out) const;
+
+    bool has(HwEvent event) const { return slot_[static_cast<size_t>(event)] >= 0; }
+
+ private:
+    PerfCounterGroup() { slot_.fill(-1); }
+
+    int leader_ = -1;
+    std::vector<int> fds_;
+    // Position of each event in the group's read format, or -1 if absent.
+    std::array<int, kNumHwEvents> slot_;
+};
+
+/// @brief Per-opcode totals of every sampled execution.
+struct HwOpcodeStats {
+    uint16_t opcode = 0;
+    uint64_t samples = 0;
+    /// Bytes the sampled executions read and wrote, from operand shapes.
+    uint64_t bytes = 0;
+    HwReading counts{};
+
+    double ipc() const;
+    double misses_per_kib(HwEvent event) const;
+};
+
+/// @brief Attributes hardware counter deltas to the instructions the
+/// RuntimeEngine executes, and reports IPC and misses per byte per opcode.
+///
+/// Counter groups count only their own thread, so one is opened lazily for
+/// every thread that calls Invoke(). Accumulators are allocated up front,
+/// one per instruction of the text section; like the engine's arena, they
+/// assume Invoke() calls on one engine do not overlap.
+class HardwareCounterProfiler {
+ public:
+    /// @param opcodes The opcode of every instruction in the text section.
+    /// @param bytes The bytes each instruction reads and writes.
+    HardwareCounterProfiler(std::vector<uint16_t> opcodes, std::vector<uint64_t> bytes,
+                            HwCounterOptions options = {});
+
+    HardwareCounterProfiler(const HardwareCounterProfiler&) = delete;
+    HardwareCounterProfiler& operator=(const HardwareCounterProfiler&) = delete;
+
+    /// @brief The calling thread's group, opened on first use. Null if the
+    /// counters are unavailable; see unavailable_reason().
+    PerfCounterGroup* ThreadGroup();
+
+    size_t sample_period() const { return options_.sample_period; }
+
+    void Record(uint32_t instruction, const HwReading& before, const HwReading& after) {
+        Accumulator& acc = accumulators_[instruction];
+        ++acc.samples;
+        // Multiplexed readings are scaled estimates and can go backwards.
+        for (size_t e = 0; e < kNumHwEvents; ++e) {
+            if (after[e] > before[e]) acc.counts[e] += after[e] - before[e];
+        }
+    }
+
+    /// @brief Why no thread could open any counters; empty if one could.
+    std::string unavailable_reason() const;
+    /// @brief Events missing from every opened group, e.g. dTLB on some CPUs.
+    std::vector<HwEvent> MissingEvents() const;
+
+    /// @brief Most cycles first.
+    std::vector<HwOpcodeStats> Summarize() const;
+
+    /// @brief A text table of Summarize(), or why there is nothing to show.
+    std::string Report() const;
+
+ private:
+    struct Accumulator {
+        uint64_t samples = 0;
+        HwReading counts{};
+    };
+
+    std::vector<uint16_t> opcodes_;
+    std::vector<uint64_t> bytes_;
+    HwCounterOptions options_;
+    std::vector<Accumulator> accumulators_;
+
+    // Null groups remember threads that failed, so they are not retried.
+    mutable std::mutex groups_mutex_;
+    std::vector<std::pair<std::thread::id, std::unique_ptr<PerfCounterGroup>>> groups_;
+    std::string open_error_;
+};
+
+}  // namespace seecpp::runtime
+
+#endif  // SEECPP_RUNTIME_HARDWARE_COUNTERS_H_
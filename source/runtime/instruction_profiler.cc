@@ -0,0 +1,185 @@
+#include "src/runtime/instruction_profiler.h"
+#include "src/serialization/schema.h"
+#include "include/utility/json_writer.h"
+
+#include <algorithm>
+#include <bit>
+#include <format>
+#include <unordered_map>
+
+namespace seecpp::runtime {
+
+namespace {
+
+struct WorkTotals {
+    double flops = 0;
+    double bytes = 0;
+};
+
+void SetThroughput(ProfileEntry& e, const WorkTotals& work, const MachineRoofline& roofline) {
+    if (e.total_ns <= 0) return;
+    // FLOPs (bytes) per nanosecond are GFLOP/s (GB/s).
+    e.gflops = work.flops / e.total_ns;
+    e.gbps = work.bytes / e.total_ns;
+    double ceiling = 0;
+    if (work.flops > 0) {
+        ceiling = work.bytes > 0 ? roofline.Attainable(work.flops / work.bytes) : roofline.peak_gflops;
+        e.roofline_fraction = ceiling > 0 ? e.gflops / ceiling : 0;
+    } else {
+        e.roofline_fraction = roofline.peak_gbps > 0 ? e.gbps / roofline.peak_gbps : 0;
+    }
+}
+
+}  // namespace
+
+InstructionProfiler::InstructionProfiler(std::vector<uint16_t> opcodes, ProfilingOptions options)
+    : opcodes_(std::move(opcodes)),
+      ring_(std::bit_ceil(std::max<size_t>(options.ring_capacity, 1))),
+      mask_(ring_.size() - 1),
+      counters_(opcodes_.size()),
+      origin_ticks_(ReadTimestamp()),
+      origin_time_(std::chrono::steady_clock::now()) {}
+
+void InstructionProfiler::SetWork(std::vector<InstructionWork> work, MachineRoofline roofline) {
+    work_ = std::move(work);
+    work_.resize(opcodes_.size());
+    roofline_ = roofline;
+}
+
+void InstructionProfiler::Reset() {
+    head_ = 0;
+    step_ = 0;
+    std::fill(counters_.begin(), counters_.end(), Counters{});
+}
+
+double InstructionProfiler::TicksPerNs() const {
+    // Short lifetimes give a noisy ratio; stretch the window to a few ms.
+    constexpr auto kMinWindow = std::chrono::milliseconds(5);
+    auto now = std::chrono::steady_clock::now();
+    while (now - origin_time_ < kMinWindow) now = std::chrono::steady_clock::now();
+    const uint64_t ticks = ReadTimestamp() - origin_ticks_;
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - origin_time_).count();
+    return static_cast<double>(ticks) / static_cast<double>(ns);
+}
+
+std::vector<InstructionSample> InstructionProfiler::Samples() const {
+    const uint64_t count = std::min<uint64_t>(head_, ring_.size());
+    std::vector<InstructionSample> samples;
+    samples.reserve(count);
+    for (uint64_t i = head_ - count; i < head_; ++i) samples.push_back(ring_[i & mask_]);
+    return samples;
+}
+
+ProfileSummary InstructionProfiler::Summarize() const {
+    const double ns_per_tick = 1.0 / TicksPerNs();
+
+    ProfileSummary summary;
+    summary.steps = step_;
+    summary.has_work = !work_.empty();
+    summary.roofline = roofline_;
+    std::unordered_map<uint16_t, std::pair<ProfileEntry, WorkTotals>> by_opcode;
+    for (uint32_t i = 0; i < counters_.size(); ++i) {
+        const Counters& c = counters_[i];
+        if (c.calls == 0) continue;
+        const uint16_t opcode = opcodes_[i];
+        ProfileEntry node{i, opcode, c.calls, c.ticks * ns_per_tick, c.max_ticks * ns_per_tick};
+        summary.total_ns += node.total_ns;
+        WorkTotals work;
+        if (summary.has_work) {
+            work = {static_cast<double>(work_[i].flops) * c.calls,
+                    static_cast<double>(work_[i].bytes) * c.calls};
+            SetThroughput(node, work, roofline_);
+        }
+
+        auto [it, inserted] = by_opcode.try_emplace(opcode, ProfileEntry{opcode, opcode}, WorkTotals{});
+        auto& [op, op_work] = it->second;
+        op.calls += node.calls;
+        op.total_ns += node.total_ns;
+        op.max_ns = std::max(op.max_ns, node.max_ns);
+        op_work.flops += work.flops;
+        op_work.bytes += work.bytes;
+        summary.by_node.push_back(node);
+    }
+    for (auto& [opcode, entry] : by_opcode) {
+        if (summary.has_work) SetThroughput(entry.first, entry.second, roofline_);
+        summary.by_opcode.push_back(entry.first);
+    }
+
+    const auto by_cost = [](const ProfileEntry& a, const ProfileEntry& b) {
+        return a.total_ns != b.total_ns ? a.total_ns > b.total_ns : a.key < b.key;
+    };
+    for (auto* entries : {&summary.by_opcode, &summary.by_node}) {
+        std::sort(entries->begin(), entries->end(), by_cost);
+        for (ProfileEntry& e : *entries) {
+            e.share = summary.total_ns > 0 ? e.total_ns / summary.total_ns : 0.0;
+        }
+    }
+    return summary;
+}
+
+std::string InstructionProfiler::ToChromeTrace(
+    const std::function<std::string(uint32_t instruction)>& node_name) const {
+    const std::vector<InstructionSample> samples = Samples();
+    const double us_per_tick = 1.0 / (TicksPerNs() * 1e3);
+    const uint64_t base = samples.empty() ? 0 : samples.front().start;
+
+    // The interpreter is single-threaded, so every sample lands on one track.
+    std::string out = "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    for (size_t i = 0; i < samples.size(); ++i) {
+        const InstructionSample& s = samples[i];
+        const uint16_t opcode = opcodes_[s.instruction];
+        const std::string name = node_name
+            ? node_name(s.instruction)
+            : std::format("{}#{}", OpcodeName(opcode), s.instruction);
+        out += i == 0 ? "\n  {\"name\": " : ",\n  {\"name\": ";
+        utility::AppendJsonString(out, name);
+        out += std::format(
+            ", \"cat\": \"{}\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1, \"ts\": {:.3f}, \"dur\": {:.3f}, "
+            "\"args\": {{\"instruction\": {}, \"opcode\": {}, \"step\": {}}}}}",
+            OpcodeName(opcode), static_cast<double>(s.start - base) * us_per_tick,
+            static_cast<double>(s.end - s.start) * us_per_tick, s.instruction, opcode, s.step);
+    }
+    out += "\n]}\n";
+    return out;
+}
+
+std::string InstructionProfiler::RooflineReport(
+    const std::function<std::string(uint32_t instruction)>& node_name) const {
+    const ProfileSummary summary = Summarize();
+    if (!summary.has_work) {
+        return "No instruction costs: recompile the model to embed its cost table.\n";
+    }
+
+    std::vector<ProfileEntry> nodes = summary.by_node;
+    const auto lost_ns = [](const ProfileEntry& e) {
+        return e.total_ns * std::max(0.0, 1.0 - e.roofline_fraction);
+    };
+    std::stable_sort(nodes.begin(), nodes.end(), [&](const ProfileEntry& a, const ProfileEntry& b) {
+        return lost_ns(a) > lost_ns(b);
+    });
+
+    const MachineRoofline& roofline = summary.roofline;
+    std::string out = std::format(
+        "Roofline: {:.1f} GFLOP/s peak, {:.1f} GB/s peak, ridge at {:.2f} FLOP/byte\n"
+        "{:<24} {:>8} {:>7} {:>10} {:>9} {:>8} {:>8} {:>9}\n",
+        roofline.peak_gflops, roofline.peak_gbps, roofline.ridge(),
+        "node", "calls", "time%", "GFLOP/s", "GB/s", "FLOP/B", "bound", "roofline%");
+    for (const ProfileEntry& e : nodes) {
+        const std::string name = node_name
+            ? node_name(e.key)
+            : std::format("{}#{}", OpcodeName(e.opcode), e.key);
+        const double intensity = e.gbps > 0 ? e.gflops / e.gbps : 0;
+        out += std::format("{:<24} {:>8} {:>6.1f}% {:>10.2f} {:>9.2f} {:>8.2f} {:>8} {:>8.1f}%\n",
+                           name, e.calls, 100.0 * e.share, e.gflops, e.gbps, intensity,
+                           intensity >= roofline.ridge() ? "compute" : "memory",
+                           100.0 * e.roofline_fraction);
+    }
+    return out;
+}
+
+std::string_view InstructionProfiler::OpcodeName(uint16_t opcode) {
+    const backend::OpcodeInfo* info = backend::FindOpcode(opcode);
+    return info ? info->name : "unknown";
+}
+
+}  // namespace seecpp::runtime
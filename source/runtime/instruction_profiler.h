@@ -0,0 +1,171 @@
+#ifndef SEECPP_RUNTIME_INSTRUCTION_PROFILER_H_
+#define SEECPP_RUNTIME_INSTRUCTION_PROFILER_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "src/runtime/roofline.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#endif
+
+namespace seecpp::runtime {
+
+/// @brief True when the runtime was built with -DSEECPP_RUNTIME_PROFILING=ON.
+/// Without it the interpreter contains no profiling code at all.
+#if defined(SEECPP_RUNTIME_PROFILING)
+inline constexpr bool kProfilingCompiledIn = true;
+#else
+inline constexpr bool kProfilingCompiledIn = false;
+#endif
+
+struct ProfilingOptions {
+    /// @brief Instruction executions kept for the trace. Older ones are
+    /// overwritten; aggregates cover every execution regardless. Rounded up
+    /// to a power of two.
+    size_t ring_capacity = size_t{1} << 16;
+};
+
+/// @brief Reads the CPU's invariant timestamp counter (rdtsc on x86-64,
+/// cntvct_el0 on AArch64), or steady_clock nanoseconds elsewhere.
+inline uint64_t ReadTimestamp() {
+#if defined(__x86_64__) || defined(_M_X64)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t ticks;
+    asm volatile("isb; mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/// @brief One execution of one instruction, in timestamp ticks.
+struct InstructionSample {
+    uint32_t instruction;
+    uint32_t step;
+    uint64_t start;
+    uint64_t end;
+};
+
+/// @brief Time spent in one opcode, or in one instruction of the text
+/// section (i.e. one lowered source node), across all recorded steps.
+struct ProfileEntry {
+    uint32_t key;       // Opcode, or instruction index.
+    uint16_t opcode;
+    uint64_t calls = 0;
+    double total_ns = 0;
+    double max_ns = 0;
+    double share = 0;   // Fraction of all recorded instruction time.
+
+    // Achieved throughput; zero unless the .see file carries a cost table.
+    double gflops = 0;
+    double gbps = 0;
+    /// Achieved GFLOP/s over what the roofline allows at this entry's
+    /// arithmetic intensity, or achieved over peak GB/s for ops that do no
+    /// arithmetic. Low values mark kernels worth a closer look.
+    double roofline_fraction = 0;
+};
+
+/// @brief The compile-time cost of one instruction, from the .see file.
+struct InstructionWork {
+    uint64_t flops = 0;
+    uint64_t bytes = 0;  // Read plus written.
+};
+
+struct ProfileSummary {
+    uint64_t steps = 0;
+    double total_ns = 0;
+    /// Set when the throughput fields of the entries are filled in.
+    bool has_work = false;
+    MachineRoofline roofline;
+    std::vector<ProfileEntry> by_opcode;  // Most expensive first.
+    std::vector<ProfileEntry> by_node;    // Most expensive first.
+};
+
+/// @brief Records a start/end timestamp pair for every instruction the
+/// RuntimeEngine executes.
+///
+/// All storage is allocated up front: a ring of the most recent samples for
+/// the trace, and per-instruction call/total/max counters for the
+/// aggregates. Record() only stores into them. Not thread-safe; one
+/// profiler per engine, driven by the thread calling Invoke().
+class InstructionProfiler {
+ public:
+    /// @param opcodes The opcode of every instruction in the text section.
+    InstructionProfiler(std::vector<uint16_t> opcodes, ProfilingOptions options = {});
+
+    InstructionProfiler(const InstructionProfiler&) = delete;
+    InstructionProfiler& operator=(const InstructionProfiler&) = delete;
+
+    void Record(uint32_t instruction, uint64_t start, uint64_t end) {
+        ring_[head_++ & mask_] = InstructionSample{instruction, step_, start, end};
+        Counters& c = counters_[instruction];
+        const uint64_t ticks = end - start;
+        ++c.calls;
+        c.ticks += ticks;
+        if (ticks > c.max_ticks) c.max_ticks = ticks;
+    }
+
+    void OnStepEnd() { ++step_; }
+
+    /// @brief Supplies each instruction's FLOPs and bytes, which turns on
+    /// the throughput and roofline fields of Summarize().
+    void SetWork(std::vector<InstructionWork> work, MachineRoofline roofline);
+
+    /// @brief Clears all samples and counters, e.g. after warm-up steps.
+    void Reset();
+
+    ProfileSummary Summarize() const;
+
+    /// @brief The retained samples as Trace Event Format JSON for
+    /// chrome://tracing or Perfetto. Events are named by `node_name`, which
+    /// defaults to "<opcode>#<instruction>".
+    std::string ToChromeTrace(
+        const std::function<std::string(uint32_t instruction)>& node_name = {}) const;
+
+    /// @brief A text table of the nodes ordered by time lost to the roofline,
+    /// total_ns * (1 - roofline_fraction), so the kernels that most deserve
+    /// tuning come first. Without costs it says how to get them.
+    std::string RooflineReport(
+        const std::function<std::string(uint32_t instruction)>& node_name = {}) const;
+
+    /// @brief Samples still in the ring, oldest first.
+    std::vector<InstructionSample> Samples() const;
+
+    static std::string_view OpcodeName(uint16_t opcode);
+
+ private:
+    struct Counters {
+        uint64_t calls = 0;
+        uint64_t ticks = 0;
+        uint64_t max_ticks = 0;
+    };
+
+    /// @brief Timestamp ticks per nanosecond, measured against steady_clock
+    /// over the profiler's lifetime (at least a few milliseconds).
+    double TicksPerNs() const;
+
+    std::vector<uint16_t> opcodes_;
+    std::vector<InstructionSample> ring_;
+    uint64_t mask_;
+    uint64_t head_ = 0;
+    uint32_t step_ = 0;
+    std::vector<Counters> counters_;
+    std::vector<InstructionWork> work_;
+    MachineRoofline roofline_;
+
+    uint64_t origin_ticks_;
+    std::chrono::steady_clock::time_point origin_time_;
+};
+
+}  // namespace seecpp::runtime
+
+#endif  // SEECPP_RUNTIME_INSTRUCTION_PROFILER_H_
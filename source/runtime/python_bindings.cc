@@ -5,6 +5,12 @@
 namespace py = pybind11;
 using namespace seecpp::runtime;
 
+// Names profile entries after ONNX nodes when the file carries source info.
+static std::function<std::string(uint32_t)> NodeNames(const RuntimeEngine& self) {
+    if (!self.SourceOf(0)) return {};
+    return [&self](uint32_t instruction) { return self.InstructionName(instruction); };
+}
+
 PYBIND11_MODULE(seecpp, m) {
     // Submodule for runtime
     py::module_ runtime_m = m.def_submodule("runtime", "SeeC++ Execution VM");
@@ -13,9 +19,46 @@ PYBIND11_MODULE(seecpp, m) {
         .def(py::init<>())
         
         // Wrap Load (Translate std::expected to Python Exceptions)
-        .def("load", [](RuntimeEngine& self, std::string_view path) {
-            auto result = self.Load(path);
+        .def("load", [](RuntimeEngine& self, std::string_view path, bool verify_checksums, bool jit) {
+            auto result = self.Load(path, LoadOptions{.verify_checksums = verify_checksums, .jit = jit});
+            if (!result) throw std::runtime_error(result.error().message);
+        }, py::arg("path"), py::arg("verify_checksums") = false, py::arg("jit") = false)
+
+        // Wrap EnableWeightStreaming (lookahead in instructions)
+        .def("enable_weight_streaming", [](RuntimeEngine& self, size_t lookahead) {
+            auto result = self.EnableWeightStreaming(StreamingOptions{lookahead});
+            if (!result) throw std::runtime_error(result.error().message);
+        }, py::arg("lookahead") = StreamingOptions{}.lookahead)
+
+        // Wrap EnableProfiling (requires a SEECPP_RUNTIME_PROFILING build)
+        .def("enable_profiling", [](RuntimeEngine& self, size_t ring_capacity) {
+            auto result = self.EnableProfiling(ProfilingOptions{ring_capacity});
             if (!result) throw std::runtime_error(result.error().message);
+        }, py::arg("ring_capacity") = ProfilingOptions{}.ring_capacity)
+
+        // Chrome trace of the most recent instruction executions
+        .def("profile_trace", [](const RuntimeEngine& self) {
+            if (!self.profiler()) throw std::runtime_error("Profiling is not enabled.");
+            return self.profiler()->ToChromeTrace(NodeNames(self));
+        })
+
+        // Achieved GFLOP/s and GB/s per node against the host roofline
+        .def("profile_report", [](const RuntimeEngine& self) {
+            if (!self.profiler()) throw std::runtime_error("Profiling is not enabled.");
+            return self.profiler()->RooflineReport(NodeNames(self));
+        })
+
+        // The ONNX node an instruction was compiled from, or None
+        .def("instruction_source", [](const RuntimeEngine& self, uint64_t instruction) -> py::object {
+            auto source = self.SourceOf(instruction);
+            if (!source) return py::none();
+            py::dict d;
+            d["node_name"] = std::string(source->node_name);
+            d["op_type"] = std::string(source->op_type);
+            d["sir_op"] = std::string(source->sir_op);
+            d["op_sequence"] = std::string(source->op_sequence);
+            d["shapes"] = std::string(source->shapes);
+            return d;
         })
 
         // Wrap SetInput (Accept a numpy array)
@@ -0,0 +1,102 @@
+#include "src/runtime/roofline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace seecpp::runtime {
+
+namespace {
+
+// The target's SIMD register file, as {registers, bytes per register}.
+#if defined(__AVX512F__)
+constexpr int kVectorRegisters = 32, kVectorBytes = 64;
+#elif defined(__AVX__)
+constexpr int kVectorRegisters = 16, kVectorBytes = 32;
+#elif defined(__aarch64__)
+constexpr int kVectorRegisters = 32, kVectorBytes = 16;
+#elif defined(__x86_64__) || defined(__SSE2__)
+constexpr int kVectorRegisters = 16, kVectorBytes = 16;
+#else
+constexpr int kVectorRegisters = 8, kVectorBytes = 16;
+#endif
+
+// One native register of floats: 4 on SSE and NEON, 8 on AVX, 16 on AVX-512.
+// A wider type would be split across registers and, on SSE, kept in memory.
+typedef float Vec __attribute__((vector_size(kVectorBytes)));
+
+// Enough independent chains to hide a 4-cycle FMA latency on two ports, but
+// no more than fit in the register file beside the two constant operands.
+constexpr int kChains = std::min(12, kVectorRegisters - 2);
+
+volatile float g_sink;
+
+double Seconds(std::chrono::steady_clock::duration d) {
+    return std::chrono::duration<double>(d).count();
+}
+
+template <typename Fn>
+double BestOfThree(Fn&& fn) {
+    double best = 0;
+    for (int rep = 0; rep < 3; ++rep) {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        const double s = Seconds(std::chrono::steady_clock::now() - start);
+        if (rep == 0 || s < best) best = s;
+    }
+    return best;
+}
+
+// Kept out of line so the accumulators live in registers, not in a lambda's
+// captured array.
+__attribute__((noinline)) float MultiplyAddLoop(uint64_t iterations) {
+    Vec acc[kChains];
+    for (int c = 0; c < kChains; ++c) acc[c] = Vec{} + static_cast<float>(c);
+    const Vec a = Vec{} + 0.999999f;
+    const Vec b = Vec{} + 1e-7f;
+    for (uint64_t i = 0; i < iterations; ++i) {
+#pragma GCC unroll 12
+        for (int c = 0; c < kChains; ++c) acc[c] = acc[c] * a + b;
+    }
+    // Without -ffast-math the recurrence cannot be folded, only kept alive.
+    float sum = 0;
+    for (int c = 0; c < kChains; ++c) sum += acc[c][0];
+    return sum;
+}
+
+double MeasurePeakGflops() {
+    constexpr uint64_t kIterations = 1'000'000;
+    const double seconds = BestOfThree([] { g_sink = MultiplyAddLoop(kIterations); });
+    const double flops = 2.0 * kIterations * kChains * (sizeof(Vec) / sizeof(float));
+    return flops / seconds * 1e-9;
+}
+
+double MeasurePeakGbps() {
+    constexpr size_t kBytes = size_t{32} << 20;
+    auto src = std::make_unique<uint8_t[]>(kBytes);
+    auto dst = std::make_unique<uint8_t[]>(kBytes);
+    // Fault both buffers in before timing.
+    std::memset(src.get(), 1, kBytes);
+    std::memset(dst.get(), 0, kBytes);
+
+    const double seconds = BestOfThree([&] {
+        std::memcpy(dst.get(), src.get(), kBytes);
+        asm volatile("" : : "r"(dst.get()) : "memory");
+    });
+    return 2.0 * kBytes / seconds * 1e-9;
+}
+
+}  // namespace
+
+MachineRoofline MeasureRoofline() {
+    return MachineRoofline{MeasurePeakGflops(), MeasurePeakGbps()};
+}
+
+const MachineRoofline& HostRoofline() {
+    static const MachineRoofline roofline = MeasureRoofline();
+    return roofline;
+}
+
+}  // namespace seecpp::runtime
@@ -0,0 +1,35 @@
+#ifndef SEECPP_RUNTIME_ROOFLINE_H_
+#define SEECPP_RUNTIME_ROOFLINE_H_
+
+#include <algorithm>
+
+namespace seecpp::runtime {
+
+/// @brief The two ceilings of a roofline model of this machine, single core.
+struct MachineRoofline {
+    /// Multiply-add throughput of a register-resident loop.
+    double peak_gflops = 0;
+    /// Copy bandwidth (bytes read plus bytes written) of a buffer larger
+    /// than the last-level cache.
+    double peak_gbps = 0;
+
+    /// @brief The best GFLOP/s reachable at `intensity` FLOPs per byte.
+    double Attainable(double intensity) const {
+        return std::min(peak_gflops, intensity * peak_gbps);
+    }
+    /// @brief The intensity above which an instruction is compute bound.
+    double ridge() const { return peak_gbps > 0 ? peak_gflops / peak_gbps : 0; }
+};
+
+/// @brief Measures both ceilings; takes about 0.2 s and briefly
+/// allocates 64 MiB. The compute loop uses 8-wide float vectors compiled for
+/// the runtime's baseline ISA, so kernels built for a wider one (AVX-512) can
+/// exceed it.
+MachineRoofline MeasureRoofline();
+
+/// @brief MeasureRoofline(), run once per process on first use.
+const MachineRoofline& HostRoofline();
+
+}  // namespace seecpp::runtime
+
+#endif  // SEECPP_RUNTIME_ROOFLINE_H_
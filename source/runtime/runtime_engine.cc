@@ -1,23 +1,178 @@
 #include "src/runtime/runtime_engine.h"
 #include "src/serialization/schema.h"
 #include "src/runtime/kernels.h" // the Gemv kernel we built
+#include "include/utility/crc32c.h"
 #include "include/utility/logger.h"
+#include "include/utility/thread_pool.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
 #include <format>
 #include <cstdlib>
 #include <cstring>
+#include <span>
+#include <utility>
+#include <vector>
 
 // POSIX Memory Mapping
 #include <fcntl.h>
-#include <sys/mmap.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
 namespace seecpp::runtime {
 
+namespace {
+
+bool IsKnownSection(uint32_t type) {
+    return type >= static_cast<uint32_t>(backend::SectionType::kText) &&
+           type <= static_cast<uint32_t>(backend::SectionType::kWeightNames);
+}
+
+/// @brief An instruction's opcode and operands, whichever encoding it came from.
+struct InstructionView {
+    uint16_t opcode;
+    const uint64_t* inputs;
+    const uint64_t* outputs;
+};
+
+/// @brief Decodes the fixed 64-byte encoding.
+struct FixedText {
+    const backend::SerializedInstruction* text;
+
+    InstructionView operator[](uint64_t i) const {
+        // .text is 64-byte aligned, so the packed operand arrays are aligned too.
+        const auto* inst = reinterpret_cast<const uint8_t*>(text + i);
+        return {text[i].opcode,
+                reinterpret_cast<const uint64_t*>(inst + offsetof(backend::SerializedInstruction, inputs)),
+                reinterpret_cast<const uint64_t*>(inst + offsetof(backend::SerializedInstruction, outputs))};
+    }
+};
+
+/// @brief Decodes the compact encoding: no branches, one load of the 8-byte
+/// instruction and two adds.
+struct CompactText {
+    const backend::CompactInstruction* text;
+    const uint64_t* pool;
+
+    InstructionView operator[](uint64_t i) const {
+        const backend::CompactInstruction inst = text[i];
+        const uint64_t* inputs = pool + inst.operand_index;
+        return {inst.opcode, inputs, inputs + inst.num_inputs};
+    }
+};
+
+// Reads exactly `size` bytes at `offset`; false on error or a short file.
+bool ReadAt(int fd, void* dst, size_t size, uint64_t offset) {
+    auto* out = static_cast<uint8_t*>(dst);
+    while (size > 0) {
+        const ssize_t n = pread(fd, out, size, static_cast<off_t>(offset));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        out += n;
+        size -= static_cast<size_t>(n);
+        offset += static_cast<uint64_t>(n);
+    }
+    return true;
+}
+
+/// @brief The section table of a version 1 file, which fixed .text, the 
+/// WeightRef table and .rodata in its header.
+std::vector<backend::SectionEntry> LegacySections(const backend::LegacyFileHeader& legacy) {
+    using backend::SectionType;
+    // Counts are untrusted; saturate so an overflowing one fails the bounds check.
+    const auto bytes = [](uint64_t count, size_t record_size) {
+        return count > UINT64_MAX / record_size ? UINT64_MAX : count * record_size;
+    };
+    std::vector<backend::SectionEntry> sections;
+    sections.push_back({static_cast<uint32_t>(SectionType::kText), backend::kSectionRequired,
+                        legacy.text_offset, bytes(legacy.text_size, sizeof(backend::SerializedInstruction)), 64, 0});
+    if (legacy.weight_refs_count > 0) {
+        sections.push_back({static_cast<uint32_t>(SectionType::kWeightRefs), 0, legacy.weight_refs_offset,
+                            bytes(legacy.weight_refs_count, sizeof(backend::WeightRef)), 8, 0});
+    }
+    sections.push_back({static_cast<uint32_t>(SectionType::kRodata), backend::kSectionRequired,
+                        legacy.rodata_offset, legacy.rodata_size, 64, 0});
+    return sections;
+}
+
+/// @brief The NUL-terminated string at `offset` of the string table, or an
+/// empty view if it would run past the table.
+std::string_view TableString(std::span<const uint8_t> table, uint32_t offset) {
+    if (offset >= table.size()) return {};
+    const auto* begin = reinterpret_cast<const char*>(table.data() + offset);
+    const void* end = std::memchr(begin, '\0', table.size() - offset);
+    return end ? std::string_view(begin, static_cast<const char*>(end) - begin) : std::string_view{};
+}
+
+/// @brief The operands Invoke() reads for an opcode, as {inputs, outputs}.
+std::pair<uint8_t, uint8_t> MinOperands(uint16_t opcode) {
+    const backend::OpcodeInfo* info = backend::FindOpcode(opcode);
+    return info ? std::pair{info->min_inputs, info->min_outputs} : std::pair<uint8_t, uint8_t>{0, 0};
+}
+
+/// @brief backend::kRelu, in place. A function of its own so that threaded code
+/// can call it like any kernel.
+void Relu(float* data, size_t count) {
+    for (size_t j = 0; j < count; ++j) {
+        if (data[j] < 0.0f) data[j] = 0.0f;
+    }
+}
+
+/// @brief backend::kGemv operands. Weights are .rodata offsets, activations
+/// arena offsets.
+struct GemvOperands {
+    uint64_t weights, x, bias, y;
+    size_t m, n;
+};
+
+GemvOperands DecodeGemv(const InstructionView& inst) {
+    // The shapes are bit-packed into inputs[3]: m in the upper 32 bits, n in the lower.
+    return {inst.inputs[0], inst.inputs[1], inst.inputs[2], inst.outputs[0],
+            static_cast<size_t>(inst.inputs[3] >> 32), static_cast<size_t>(inst.inputs[3] & 0xFFFFFFFF)};
+}
+
+/// @brief backend::kRelu operands: an arena offset and an element count.
+struct ReluOperands {
+    uint64_t data;
+    size_t count;
+};
+
+ReluOperands DecodeRelu(const InstructionView& inst) {
+    return {inst.inputs[0], static_cast<size_t>(inst.inputs[1])};
+}
+
+/// @brief Bytes an instruction reads and writes, from the operands Invoke() decodes.
+uint64_t InstructionBytes(const InstructionView& inst) {
+    switch (inst.opcode) {
+        case backend::kGemv: {  // A, x, bias in; y out
+            const GemvOperands g = DecodeGemv(inst);
+            return (g.m * g.n + g.n + 2 * g.m) * sizeof(float);
+        }
+        case backend::kRelu:  // In place
+            return 2 * DecodeRelu(inst).count * sizeof(float);
+        default:
+            return 0;
+    }
+}
+
+}  // namespace
+
+template <typename Fn>
+decltype(auto) RuntimeEngine::WithText(Fn&& fn) const {
+    return compact_text_ ? fn(CompactText{compact_text_, operand_pool_}) : fn(FixedText{text_});
+}
+
 RuntimeEngine::~RuntimeEngine() {
+    // The streamer's helper thread issues madvise() on the mapping; stop it first.
+    streamer_.reset();
+    for (const LazyMapping& mapping : lazy_mappings_) {
+        if (mapping.base != nullptr) munmap(mapping.base, mapping.length);
+    }
     if (mmap_ptr_ != nullptr && mmap_ptr_ != MAP_FAILED) {
-        munmap(const_cast<uint8_t*>(mmap_ptr_), file_size_);
+        munmap(const_cast<uint8_t*>(mmap_ptr_), mapped_size_);
     }
     if (fd_ != -1) {
         close(fd_);
@@ -27,7 +182,9 @@ RuntimeEngine::~RuntimeEngine() {
     }
 }
 
-std::expected<void, RuntimeError> RuntimeEngine::Load(std::string_view file_path) {
+std::expected<void, RuntimeError> RuntimeEngine::Load(std::string_view file_path, LoadOptions options) {
+    load_options_ = options;
+
     // 1. Open the file
     fd_ = open(file_path.data(), O_RDONLY);
     if (fd_ == -1) {
@@ -41,34 +198,286 @@ std::expected<void, RuntimeError> RuntimeEngine::Load(std::string_view file_path
     }
     file_size_ = sb.st_size;
 
-    // 3. Memory Map (Zero-copy, directly from disk to RAM)
-    mmap_ptr_ = static_cast<const uint8_t*>(mmap(nullptr, file_size_, PROT_READ, MAP_PRIVATE, fd_, 0));
+    // 3. Validate Schema Header and read the Section Table
+    // Both are read rather than mapped, so nothing is mapped that no section needs.
+    backend::FileHeader header;
+    if (!ReadAt(fd_, &header, sizeof(header), 0) || header.magic != backend::kSeeMagic) {
+        return std::unexpected(RuntimeError{"Invalid .see file magic bytes."});
+    }
+    if (header.version == backend::kLegacyVersion) {
+        backend::LegacyFileHeader legacy;
+        std::memcpy(&legacy, &header, sizeof(legacy));
+        sections_ = LegacySections(legacy);
+        instruction_count_ = legacy.text_size;
+    } else if (header.version == backend::kCurrentVersion) {
+        if (header.section_table_offset > file_size_ ||
+            header.section_count > (file_size_ - header.section_table_offset) / sizeof(backend::SectionEntry)) {
+            return std::unexpected(RuntimeError{"Section table runs past the end of the file."});
+        }
+        sections_.resize(header.section_count);
+        if (!ReadAt(fd_, sections_.data(), sections_.size() * sizeof(backend::SectionEntry),
+                    header.section_table_offset)) {
+            return std::unexpected(RuntimeError{"Failed to read the section table."});
+        }
+        instruction_count_ = header.instruction_count;
+    } else {
+        return std::unexpected(RuntimeError{std::format(
+            "Unsupported .see version {} (this runtime reads {} and {}).",
+            header.version, backend::kLegacyVersion, backend::kCurrentVersion)});
+    }
+
+    // 4. Check every entry; only the required ones decide what gets mapped
+    mapped_size_ = sizeof(backend::FileHeader);
+    size_t skipped = 0;
+    for (const backend::SectionEntry& section : sections_) {
+        if (section.size > file_size_ || section.offset > file_size_ - section.size) {
+            return std::unexpected(RuntimeError{std::format(
+                "Section of type {} ({} bytes at offset {}) lies outside the file.",
+                section.type, section.size, section.offset)});
+        }
+        const bool required = (section.flags & backend::kSectionRequired) != 0;
+        if (!IsKnownSection(section.type)) {
+            if (required) {
+                return std::unexpected(RuntimeError{std::format(
+                    "File requires section type {}, which this runtime does not support.", section.type)});
+            }
+            ++skipped;
+            continue;
+        }
+        if (required) mapped_size_ = std::max<size_t>(mapped_size_, section.offset + section.size);
+    }
+
+    // Exactly one instruction encoding, plus .rodata
+    const auto find_required = [this](backend::SectionType type) -> const backend::SectionEntry* {
+        const backend::SectionEntry* section = backend::FindSection(sections_, type);
+        return section && (section->flags & backend::kSectionRequired) ? section : nullptr;
+    };
+    const backend::SectionEntry* text = find_required(backend::SectionType::kText);
+    const backend::SectionEntry* compact = find_required(backend::SectionType::kCompactText);
+    const backend::SectionEntry* pool = find_required(backend::SectionType::kOperandPool);
+    const backend::SectionEntry* rodata = find_required(backend::SectionType::kRodata);
+    // Divide rather than multiply: instruction_count_ comes from the file and
+    // instruction_count_ * record_size could wrap to match a small section.
+    const auto holds_text = [this](const backend::SectionEntry* section, size_t record_size) {
+        return section->size % record_size == 0 && section->size / record_size == instruction_count_;
+    };
+    const bool fixed_ok = text && !compact && holds_text(text, sizeof(backend::SerializedInstruction));
+    const bool compact_ok = compact && pool && !text &&
+        holds_text(compact, sizeof(backend::CompactInstruction)) &&
+        pool->offset % alignof(uint64_t) == 0 && pool->size % sizeof(uint64_t) == 0;
+    if (!rodata || !(fixed_ok || compact_ok)) {
+        return std::unexpected(RuntimeError{"Missing or malformed instruction or .rodata section."});
+    }
+
+    // 5. Memory Map the required sections (Zero-copy, directly from disk to RAM)
+    mmap_ptr_ = static_cast<const uint8_t*>(mmap(nullptr, mapped_size_, PROT_READ, MAP_PRIVATE, fd_, 0));
     if (mmap_ptr_ == MAP_FAILED) {
+        mmap_ptr_ = nullptr;
         return std::unexpected(RuntimeError{"Failed to mmap file."});
     }
+    if (compact) {
+        compact_text_ = reinterpret_cast<const backend::CompactInstruction*>(mmap_ptr_ + compact->offset);
+        operand_pool_ = reinterpret_cast<const uint64_t*>(mmap_ptr_ + pool->offset);
+        // Invoke() decodes without bounds checks, so check every operand range once.
+        const uint64_t pool_count = pool->size / sizeof(uint64_t);
+        for (uint64_t i = 0; i < instruction_count_; ++i) {
+            const backend::CompactInstruction& inst = compact_text_[i];
+            const auto [min_inputs, min_outputs] = MinOperands(inst.opcode);
+            if (inst.num_inputs < min_inputs || inst.num_outputs < min_outputs ||
+                uint64_t{inst.operand_index} + inst.num_inputs + inst.num_outputs > pool_count) {
+                return std::unexpected(RuntimeError{std::format(
+                    "Instruction {} (opcode {}) has a malformed operand range.", i, inst.opcode)});
+            }
+        }
+    } else {
+        text_ = reinterpret_cast<const backend::SerializedInstruction*>(mmap_ptr_ + text->offset);
+    }
+    rodata_ = mmap_ptr_ + rodata->offset;
+    rodata_size_ = rodata->size;
 
-    // 4. Validate Schema Header
-    const auto* header = reinterpret_cast<const backend::FileHeader*>(mmap_ptr_);
-    if (header->magic != backend::kSeeMagic || header->version != backend::kCurrentVersion) {
-        return std::unexpected(RuntimeError{"Invalid .see file magic bytes or unsupported version."});
+    // 6. Verify Checksums of the mapped sections (opt-in)
+    if (options.verify_checksums) {
+        utility::ThreadPool pool(options.verify_threads);
+        uint64_t verified = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (const backend::SectionEntry& section : sections_) {
+            if (!(section.flags & backend::kSectionChecksummed) || !IsKnownSection(section.type) ||
+                section.offset + section.size > mapped_size_) {
+                continue;
+            }
+            const uint32_t crc = utility::Crc32cParallel({mmap_ptr_ + section.offset, section.size}, &pool);
+            if (crc != section.checksum) {
+                return std::unexpected(RuntimeError{std::format(
+                    "Checksum mismatch in section of type {} ({} bytes at offset {}): "
+                    "stored {:08x}, computed {:08x}. The file is corrupt or truncated.",
+                    section.type, section.size, section.offset, section.checksum, crc)});
+            }
+            verified += section.size;
+        }
+        utility::Logger::Info(std::format(
+            "Runtime: Verified {} bytes in {:.1f} ms on {} thread(s){}.", verified,
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(),
+            pool.size(), utility::Crc32cIsHardwareAccelerated() ? " with CRC instructions" : ""
+        ));
     }
 
-    // 5. Allocate the hardware-aligned Memory Arena (Calculated earlier by OffsetBinder)
-    arena_size_ = header->arena_size;
+    // 7. Allocate the hardware-aligned Memory Arena (Calculated earlier by OffsetBinder)
+    arena_size_ = header.arena_size;
     // 64-byte alignment for AVX-512 / cache lines
     arena_ = static_cast<uint8_t*>(std::aligned_alloc(64, arena_size_)); 
     if (!arena_) {
         return std::unexpected(RuntimeError{"Failed to allocate aligned execution arena."});
     }
 
+    // 8. Optionally emit the stream as threaded code, now that the arena exists
+    if (options.jit) CompileThreadedCode();
+
     utility::Logger::Info(std::format(
-        "Runtime: Loaded '{}'. Mapped {} bytes. Allocated Arena: {} bytes.",
-        file_path, file_size_, arena_size_
+        "Runtime: Loaded '{}' (version {}). Mapped {} of {} bytes, {} section(s), {} unknown skipped. "
+        "Allocated Arena: {} bytes.",
+        file_path, header.version, mapped_size_, file_size_, sections_.size(), skipped, arena_size_
     ));
 
     return {};
 }
 
+std::span<const uint8_t> RuntimeEngine::Section(backend::SectionType type) const {
+    const backend::SectionEntry* section = backend::FindSection(sections_, type);
+    if (!mmap_ptr_ || !section || section->size == 0) return {};
+    if (section->offset + section->size <= mapped_size_) {
+        return {mmap_ptr_ + section->offset, section->size};
+    }
+
+    std::lock_guard<std::mutex> lock(lazy_mutex_);
+    for (const LazyMapping& mapping : lazy_mappings_) {
+        if (mapping.type == section->type) return mapping.bytes;
+    }
+    // mmap() offsets must be page-aligned; start at the page holding the section.
+    const auto page = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    const uint64_t start = section->offset & ~(page - 1);
+    const size_t length = section->offset + section->size - start;
+    void* base = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd_, static_cast<off_t>(start));
+    if (base == MAP_FAILED) return {};
+    const std::span<const uint8_t> bytes(static_cast<const uint8_t*>(base) + (section->offset - start),
+                                         section->size);
+    if (load_options_.verify_checksums && (section->flags & backend::kSectionChecksummed) &&
+        utility::Crc32c(bytes) != section->checksum) {
+        munmap(base, length);
+        utility::Logger::Error(std::format(
+            "Runtime: Checksum mismatch in section of type {}; ignoring it.", section->type));
+        // Remember the failure so later lookups neither remap nor log again.
+        lazy_mappings_.push_back({section->type, nullptr, 0, {}});
+        return {};
+    }
+    lazy_mappings_.push_back({section->type, base, length, bytes});
+    return bytes;
+}
+
+std::vector<InstructionWork> RuntimeEngine::LoadInstructionWork() const {
+    const std::span<const uint8_t> blob = Section(backend::SectionType::kInstructionCost);
+    if (blob.size() != instruction_count_ * sizeof(backend::InstructionCost)) return {};
+
+    std::vector<InstructionWork> work(instruction_count_);
+    for (uint64_t i = 0; i < instruction_count_; ++i) {
+        backend::InstructionCost cost;
+        std::memcpy(&cost, blob.data() + i * sizeof(cost), sizeof(cost));
+        work[i] = {cost.flops, cost.bytes_read + cost.bytes_written};
+    }
+    return work;
+}
+
+std::expected<void, RuntimeError> RuntimeEngine::EnableWeightStreaming(StreamingOptions options) {
+    if (!mmap_ptr_) return std::unexpected(RuntimeError{"Model not loaded."});
+
+    const std::span<const uint8_t> refs_bytes = Section(backend::SectionType::kWeightRefs);
+    if (refs_bytes.empty()) {
+        return std::unexpected(RuntimeError{
+            "Weight streaming requires a WeightRef table. Recompile the model."});
+    }
+    const std::span<const backend::WeightRef> refs(
+        reinterpret_cast<const backend::WeightRef*>(refs_bytes.data()),
+        refs_bytes.size() / sizeof(backend::WeightRef)
+    );
+
+    // The streamer owns residency from here on; stop the kernel's own readahead 
+    // from faulting in neighbouring weights behind its back.
+    const auto page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const auto rodata_page = reinterpret_cast<uintptr_t>(rodata_) & ~(page - 1);
+    madvise(reinterpret_cast<void*>(rodata_page), 
+            reinterpret_cast<uintptr_t>(rodata_ + rodata_size_) - rodata_page, MADV_RANDOM);
+
+    streamer_.reset();
+    streamer_ = std::make_unique<WeightStreamer>(rodata_, refs, instruction_count_, options);
+
+    utility::Logger::Info(std::format(
+        "Runtime: Weight streaming enabled ({} weight reference(s), lookahead {} instruction(s)).",
+        refs.size(), options.lookahead
+    ));
+    return {};
+}
+
+std::expected<void, RuntimeError> RuntimeEngine::EnableProfiling(ProfilingOptions options) {
+    if constexpr (!kProfilingCompiledIn) {
+        return std::unexpected(RuntimeError{
+            "Profiling is compiled out. Rebuild with -DSEECPP_RUNTIME_PROFILING=ON."});
+    }
+    if (!mmap_ptr_) return std::unexpected(RuntimeError{"Model not loaded."});
+
+    std::vector<uint16_t> opcodes(instruction_count_);
+    WithText([&](const auto& text) {
+        for (uint64_t i = 0; i < instruction_count_; ++i) opcodes[i] = text[i].opcode;
+    });
+
+    profiler_ = std::make_unique<InstructionProfiler>(std::move(opcodes), options);
+    utility::Logger::Info(std::format(
+        "Runtime: Profiling enabled ({} instruction(s), {} sample ring).",
+        instruction_count_, options.ring_capacity
+    ));
+
+    // Throughput needs the compiler's cost table; the roofline is measured once.
+    std::vector<InstructionWork> work = LoadInstructionWork();
+    if (work.empty()) {
+        utility::Logger::Info("Runtime: No instruction cost table; roofline report disabled.");
+        return {};
+    }
+    const MachineRoofline& roofline = HostRoofline();
+    profiler_->SetWork(std::move(work), roofline);
+    utility::Logger::Info(std::format(
+        "Runtime: Roofline {:.1f} GFLOP/s, {:.1f} GB/s.", roofline.peak_gflops, roofline.peak_gbps
+    ));
+    return {};
+}
+
+std::expected<void, RuntimeError> RuntimeEngine::EnableHardwareCounters(HwCounterOptions options) {
+    if constexpr (!kProfilingCompiledIn) {
+        return std::unexpected(RuntimeError{
+            "Profiling is compiled out. Rebuild with -DSEECPP_RUNTIME_PROFILING=ON."});
+    }
+    if (!mmap_ptr_) return std::unexpected(RuntimeError{"Model not loaded."});
+
+    // Prefer the compiler's byte counts; decode the operands of older files.
+    const std::vector<InstructionWork> work = LoadInstructionWork();
+    std::vector<uint16_t> opcodes(instruction_count_);
+    std::vector<uint64_t> bytes(instruction_count_);
+    WithText([&](const auto& text) {
+        for (uint64_t i = 0; i < instruction_count_; ++i) {
+            const InstructionView inst = text[i];
+            opcodes[i] = inst.opcode;
+            bytes[i] = work.empty() ? InstructionBytes(inst) : work[i].bytes;
+        }
+    });
+    hw_counters_ = std::make_unique<HardwareCounterProfiler>(std::move(opcodes), std::move(bytes), options);
+
+    // Open the caller's group now so an unusable PMU is reported up front.
+    if (!hw_counters_->ThreadGroup()) {
+        utility::Logger::Warn(std::format(
+            "Runtime: Hardware counters unavailable ({}); continuing without them.",
+            hw_counters_->unavailable_reason()
+        ));
+    }
+    return {};
+}
+
 std::expected<void, RuntimeError> RuntimeEngine::SetInput(const float* data, size_t num_elements) {
     if (!arena_) return std::unexpected(RuntimeError{"Model not loaded."});
     
@@ -82,61 +491,176 @@ std::expected<void, RuntimeError> RuntimeEngine::Invoke() {
         return std::unexpected(RuntimeError{"Cannot invoke: Model not loaded."});
     }
 
-    const auto* header = reinterpret_cast<const backend::FileHeader*>(mmap_ptr_);
-    
-    // Resolve absolute pointers from the mmap base
-    const auto* instructions = reinterpret_cast<const backend::SerializedInstruction*>(
-        mmap_ptr_ + header->text_offset
-    );
-    const uint8_t* rodata_base = mmap_ptr_ + header->rodata_offset;
+    // The threaded code has no hooks for the streamer or the profilers.
+    if (threaded_code_ && !streamer_ && !profiler_ && !hw_counters_) {
+        threaded_code_->Run();
+        return {};
+    }
+    return WithText([this](const auto& text) { return Execute(text); });
+}
+
+void RuntimeEngine::CompileThreadedCode() {
+    if (!ThreadedCode::Supported()) {
+        utility::Logger::Warn("Runtime: Threaded code is not supported on this host; interpreting.");
+        return;
+    }
+
+    std::vector<KernelCall> calls;
+    calls.reserve(instruction_count_);
+    const uint64_t unsupported = WithText([&](const auto& text) -> uint64_t {
+        for (uint64_t i = 0; i < instruction_count_; ++i) {
+            const InstructionView inst = text[i];
+            switch (inst.opcode) {
+                case backend::kGemv: {
+                    const GemvOperands g = DecodeGemv(inst);
+                    calls.push_back({reinterpret_cast<const void*>(&kernels::Gemv),
+                                     {reinterpret_cast<uint64_t>(rodata_ + g.weights),
+                                      reinterpret_cast<uint64_t>(arena_ + g.x),
+                                      reinterpret_cast<uint64_t>(rodata_ + g.bias),
+                                      reinterpret_cast<uint64_t>(arena_ + g.y), g.m, g.n},
+                                     6});
+                    break;
+                }
+                case backend::kRelu: {
+                    const ReluOperands r = DecodeRelu(inst);
+                    calls.push_back({reinterpret_cast<const void*>(&Relu),
+                                     {reinterpret_cast<uint64_t>(arena_ + r.data), r.count},
+                                     2});
+                    break;
+                }
+                default:
+                    return i;
+            }
+        }
+        return instruction_count_;
+    });
+    if (unsupported != instruction_count_) {
+        // Leave the error to Invoke(), which reports it with the node's origin.
+        utility::Logger::Warn(std::format(
+            "Runtime: Threaded code does not cover the opcode of instruction {}; interpreting.", unsupported));
+        return;
+    }
+
+    auto code = ThreadedCode::Compile(calls);
+    if (!code) {
+        utility::Logger::Warn(std::format("Runtime: Threaded code failed ({}); interpreting.", code.error()));
+        return;
+    }
+    threaded_code_ = std::move(*code);
+    utility::Logger::Info(std::format(
+        "Runtime: Emitted {} bytes of threaded code for {} instruction(s).",
+        threaded_code_->code_size(), instruction_count_));
+}
+
+template <typename Text>
+std::expected<void, RuntimeError> RuntimeEngine::Execute(const Text& instructions) {
+    // Resolved by Load() from the section table
+    const uint8_t* const rodata_base = rodata_;
+
+#if defined(SEECPP_RUNTIME_PROFILING)
+    InstructionProfiler* const profiler = profiler_.get();
+    PerfCounterGroup* const counters = hw_counters_ ? hw_counters_->ThreadGroup() : nullptr;
+    size_t until_sample = 0;
+    HwReading hw_before{};
+    HwReading hw_after{};
+#endif
 
     // =========================================================================
     // THE EXECUTION LOOP
     // This entirely replaces your legacy `cpu_code.cpp` logic.
     // =========================================================================
-    for (uint64_t i = 0; i < header->text_size; ++i) {
-        const auto& inst = instructions[i];
+    for (uint64_t i = 0; i < instruction_count_; ++i) {
+        const InstructionView inst = instructions[i];
+        if (streamer_) streamer_->OnInstruction(i);
+#if defined(SEECPP_RUNTIME_PROFILING)
+        // Counter reads bracket the timestamps so their syscalls stay untimed.
+        bool sample_hw = false;
+        if (counters && until_sample-- == 0) {
+            until_sample = hw_counters_->sample_period() - 1;
+            sample_hw = counters->Read(hw_before);
+        }
+        const uint64_t start = profiler ? ReadTimestamp() : 0;
+#endif
 
         switch (inst.opcode) {
             // Example Opcode: GEMV (General Matrix-Vector Multiply)
-            case 10: { // Assuming 10 is backend::Opcode::kGemv
+            case backend::kGemv: {
                 // Decode offsets. Weights come from rodata, activations from arena.
-                const float* A_weights = reinterpret_cast<const float*>(rodata_base + inst.inputs[0]);
-                const float* x_vector  = reinterpret_cast<const float*>(arena_ + inst.inputs[1]);
-                const float* bias      = reinterpret_cast<const float*>(rodata_base + inst.inputs[2]);
-                float* y_output        = reinterpret_cast<float*>(arena_ + inst.outputs[0]);
-
-                // The shapes would either be baked into the instruction struct, 
-                // or read from a tiny metadata header preceding the weight blob.
-                // For this example, let's assume they were packed into inputs[3].
-                size_t m = inst.inputs[3] >> 32;       // Upper 32 bits
-                size_t n = inst.inputs[3] & 0xFFFFFFFF; // Lower 32 bits
+                const GemvOperands g = DecodeGemv(inst);
+                const float* A_weights = reinterpret_cast<const float*>(rodata_base + g.weights);
+                const float* x_vector  = reinterpret_cast<const float*>(arena_ + g.x);
+                const float* bias      = reinterpret_cast<const float*>(rodata_base + g.bias);
+                float* y_output        = reinterpret_cast<float*>(arena_ + g.y);
 
                 // Dispatch to the AVX-512 or NEON kernel we wrote earlier!
-                kernels::Gemv(A_weights, x_vector, bias, y_output, m, n);
+                kernels::Gemv(A_weights, x_vector, bias, y_output, g.m, g.n);
                 break;
             }
 
             // Example Opcode: RELU
-            case 11: {
-                float* data = reinterpret_cast<float*>(arena_ + inst.inputs[0]);
-                size_t count = inst.inputs[1];
-                for (size_t j = 0; j < count; ++j) {
-                    if (data[j] < 0.0f) data[j] = 0.0f;
-                }
+            case backend::kRelu: {
+                const ReluOperands r = DecodeRelu(inst);
+                Relu(reinterpret_cast<float*>(arena_ + r.data), r.count);
                 break;
             }
 
             default:
-                return std::unexpected(RuntimeError{
-                    std::format("Encountered unknown hardware opcode: {}", inst.opcode)
-                });
+                return std::unexpected(RuntimeError{std::format(
+                    "Encountered unknown hardware opcode {} at instruction {} ({})",
+                    inst.opcode, i, DescribeInstruction(i))});
+        }
+
+#if defined(SEECPP_RUNTIME_PROFILING)
+        if (profiler) profiler->Record(static_cast<uint32_t>(i), start, ReadTimestamp());
+        if (sample_hw && counters->Read(hw_after)) {
+            hw_counters_->Record(static_cast<uint32_t>(i), hw_before, hw_after);
         }
+#endif
     }
 
+    if (streamer_) streamer_->OnStepEnd();
+#if defined(SEECPP_RUNTIME_PROFILING)
+    if (profiler) profiler->OnStepEnd();
+#endif
     return {};
 }
 
+std::optional<InstructionSource> RuntimeEngine::SourceOf(uint64_t instruction) const {
+    if (!mmap_ptr_) return std::nullopt;
+    if (instruction >= instruction_count_) return std::nullopt;
+
+    const std::span<const uint8_t> records = Section(backend::SectionType::kSourceInfo);
+    const std::span<const uint8_t> strings = Section(backend::SectionType::kStringTable);
+    if (records.size() != instruction_count_ * sizeof(backend::SourceInfo)) return std::nullopt;
+
+    backend::SourceInfo info;
+    std::memcpy(&info, records.data() + instruction * sizeof(info), sizeof(info));
+    return InstructionSource{
+        TableString(strings, info.node_name),
+        TableString(strings, info.op_type),
+        TableString(strings, info.sir_op),
+        TableString(strings, info.op_sequence),
+        TableString(strings, info.shapes),
+    };
+}
+
+std::string RuntimeEngine::InstructionName(uint64_t instruction) const {
+    const std::optional<InstructionSource> source = SourceOf(instruction);
+    if (source && !source->node_name.empty()) return std::string(source->node_name);
+    if (source && !source->sir_op.empty()) return std::format("{}#{}", source->sir_op, instruction);
+    return std::format("#{}", instruction);
+}
+
+std::string RuntimeEngine::DescribeInstruction(uint64_t instruction) const {
+    const std::optional<InstructionSource> source = SourceOf(instruction);
+    if (!source) return "no source info in this file";
+    std::string out = std::format("node '{}', {} lowered to {}", source->node_name,
+                                  source->op_type, source->sir_op);
+    if (!source->op_sequence.empty()) out += std::format(" [{}]", source->op_sequence);
+    if (!source->shapes.empty()) out += std::format(", {}", source->shapes);
+    return out;
+}
+
 const float* RuntimeEngine::GetOutput(size_t offset) const {
     if (!arena_ || offset >= arena_size_) return nullptr;
     return reinterpret_cast<const float*>(arena_ + offset);
@@ -3,8 +3,19 @@
 
 #include <cstdint>
 #include <expected>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <string>
 #include <string_view>
+#include <vector>
+
+#include "src/serialization/schema.h"
+#include "src/runtime/hardware_counters.h"
+#include "src/runtime/instruction_profiler.h"
+#include "src/runtime/threaded_code.h"
+#include "src/runtime/weight_streamer.h"
 
 namespace seecpp::runtime {
 
@@ -12,6 +23,37 @@ struct RuntimeError {
     std::string message;
 };
 
+struct LoadOptions {
+    /// @brief Check the CRC32C the compiler stored for each section before
+    /// using it: sections mapped by Load() there, the rest when Section()
+    /// first maps them. Reads every byte of .rodata, so weights that would
+    /// have been paged in on demand are paged in up front.
+    bool verify_checksums = false;
+
+    /// @brief Threads that verify, including the caller. Zero selects
+    /// std::thread::hardware_concurrency().
+    size_t verify_threads = 0;
+
+    /// @brief Emit the instruction stream as one straight-line function of
+    /// direct kernel calls with every pointer and shape baked in, and run
+    /// that instead of the interpreter loop. Invoke() falls back to the
+    /// interpreter while streaming or profiling, and Load() does if the host
+    /// or an opcode is not supported. Pays off when kernels are short; a
+    /// stream whose code (~20 bytes per call) outgrows the instruction cache
+    /// can run slower than the interpreter loop.
+    bool jit = false;
+};
+
+/// @brief Where an instruction came from, as recorded by the compiler. The
+/// views point into the mapped file and live as long as the loaded model.
+struct InstructionSource {
+    std::string_view node_name;    // ONNX node name(s), "+"-joined when fused
+    std::string_view op_type;      // ONNX op type(s)
+    std::string_view sir_op;       // SIR mnemonic the instruction was selected from
+    std::string_view op_sequence;  // Fused elementwise chain, empty unless fused
+    std::string_view shapes;       // "f32[1,64], f32[64,10] -> f32[1,10]"
+};
+
 /// @brief The ultra-fast virtual machine for executing .see binaries.
 class RuntimeEngine {
  public:
@@ -22,8 +64,62 @@ class RuntimeEngine {
     RuntimeEngine(const RuntimeEngine&) = delete;
     RuntimeEngine& operator=(const RuntimeEngine&) = delete;
 
-    /// @brief Memory-maps the binary and allocates the required dynamic arena.
-    [[nodiscard]] std::expected<void, RuntimeError> Load(std::string_view file_path);
+    /// @brief Reads the header and section table, memory-maps the required
+    /// sections, and allocates the dynamic arena. Optional sections are left
+    /// unmapped until Section() asks for them, and unknown ones are skipped,
+    /// so their number and size do not affect load time. Also accepts the
+    /// version 1 layout, which has no optional sections.
+    [[nodiscard]] std::expected<void, RuntimeError> Load(std::string_view file_path,
+                                                         LoadOptions options = {});
+
+    /// @brief Switches to streaming mode: weights are prefetched a few instructions 
+    /// ahead of execution and dropped after their last use in each step.
+    /// Must be called after Load(); requires a .see file with a WeightRef table.
+    [[nodiscard]] std::expected<void, RuntimeError> EnableWeightStreaming(
+        StreamingOptions options = {});
+
+    /// @brief Times every instruction of subsequent Invoke() calls. Must be
+    /// called after Load(). Fails unless the runtime was built with
+    /// SEECPP_RUNTIME_PROFILING; without it Invoke() carries no profiling code.
+    /// If the file carries a cost table, the host roofline is measured (once
+    /// per process, ~0.2 s) and profiler()->RooflineReport() becomes available.
+    [[nodiscard]] std::expected<void, RuntimeError> EnableProfiling(
+        ProfilingOptions options = {});
+
+    /// @brief Samples CPU cycles, instructions and L1D/LLC/dTLB misses around
+    /// instructions of subsequent Invoke() calls, for per-opcode IPC and
+    /// misses per byte. Needs a SEECPP_RUNTIME_PROFILING build. Succeeds even
+    /// where perf_event_open is unavailable; hardware_counters()->Report()
+    /// then says why.
+    [[nodiscard]] std::expected<void, RuntimeError> EnableHardwareCounters(
+        HwCounterOptions options = {});
+
+    [[nodiscard]] const HardwareCounterProfiler* hardware_counters() const {
+        return hw_counters_.get();
+    }
+
+    /// @brief The code emitted for LoadOptions::jit, or nullptr if Invoke()
+    /// interprets the instruction stream.
+    [[nodiscard]] const ThreadedCode* threaded_code() const { return threaded_code_.get(); }
+
+    /// @brief The bytes of a section, or an empty span if the file has none
+    /// (or, when verifying checksums, if its checksum does not match).
+    /// Optional sections are mapped on first request and stay mapped until
+    /// the engine is destroyed. Thread-safe.
+    [[nodiscard]] std::span<const uint8_t> Section(backend::SectionType type) const;
+
+    /// @brief The active profiler, or nullptr if profiling is not enabled.
+    [[nodiscard]] const InstructionProfiler* profiler() const { return profiler_.get(); }
+    [[nodiscard]] InstructionProfiler* profiler() { return profiler_.get(); }
+
+    /// @brief Looks up the source-info section, which Load() and Invoke() never
+    /// touch, so it is only mapped when this is first called. Empty if the
+    /// file has none (stripped, or compiled before it existed).
+    [[nodiscard]] std::optional<InstructionSource> SourceOf(uint64_t instruction) const;
+
+    /// @brief The ONNX node name of an instruction for reports and traces,
+    /// falling back to "<sir op>#<index>" and then to "#<index>".
+    [[nodiscard]] std::string InstructionName(uint64_t instruction) const;
 
     /// @brief Injects the user's raw input data into the start of the memory arena.
     [[nodiscard]] std::expected<void, RuntimeError> SetInput(const float* data, size_t num_elements);
@@ -35,14 +131,67 @@ class RuntimeEngine {
     [[nodiscard]] const float* GetOutput(size_t offset) const;
 
  private:
-    // Memory mapped file state
+    /// @brief A one-line description of an instruction's origin for errors.
+    std::string DescribeInstruction(uint64_t instruction) const;
+
+    /// @brief Each instruction's compile-time cost, or an empty vector if the
+    /// file has no complete cost table.
+    std::vector<InstructionWork> LoadInstructionWork() const;
+
+    /// @brief Calls `fn` with a decoder for the loaded instruction encoding, so
+    /// loops over the text are compiled once per encoding with no per-
+    /// instruction branch on it.
+    template <typename Fn>
+    decltype(auto) WithText(Fn&& fn) const;
+
+    /// @brief The interpreter loop, instantiated for each encoding.
+    template <typename Text>
+    std::expected<void, RuntimeError> Execute(const Text& text);
+
+    /// @brief Resolves every instruction to a KernelCall against rodata_ and
+    /// arena_ and emits them; on any failure logs why and leaves the
+    /// interpreter in charge.
+    void CompileThreadedCode();
+
+    // Memory mapped file state: [0, mapped_size_) covers every required section
     int fd_ = -1;
     size_t file_size_ = 0;
+    size_t mapped_size_ = 0;
     const uint8_t* mmap_ptr_ = nullptr;
+    std::vector<backend::SectionEntry> sections_;
+    LoadOptions load_options_;
+
+    // Resolved once by Load(); text_ is null for the compact encoding
+    const backend::SerializedInstruction* text_ = nullptr;
+    const backend::CompactInstruction* compact_text_ = nullptr;
+    const uint64_t* operand_pool_ = nullptr;
+    uint64_t instruction_count_ = 0;
+    const uint8_t* rodata_ = nullptr;
+    uint64_t rodata_size_ = 0;
+
+    // Optional sections mapped on demand by Section()
+    struct LazyMapping {
+        uint32_t type;
+        void* base;
+        size_t length;
+        std::span<const uint8_t> bytes;
+    };
+    mutable std::mutex lazy_mutex_;
+    mutable std::vector<LazyMapping> lazy_mappings_;
 
     // Dynamic execution memory
     uint8_t* arena_ = nullptr;
     size_t arena_size_ = 0;
+
+    // Call-threaded code for the whole stream (nullptr when interpreting)
+    std::unique_ptr<ThreadedCode> threaded_code_;
+
+    // Optional layer-ahead weight prefetch/eviction (nullptr when disabled)
+    std::unique_ptr<WeightStreamer> streamer_;
+
+    // Per-instruction timing (nullptr when disabled)
+    std::unique_ptr<InstructionProfiler> profiler_;
+    std::unique_ptr<HardwareCounterProfiler> hw_counters_;
 };
 
 }  // namespace seecpp::runtime
@@ -0,0 +1,196 @@
+#include "src/runtime/threaded_code.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <optional>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace seecpp::runtime {
+
+namespace {
+
+#if (defined(__x86_64__) || defined(__aarch64__)) && defined(__linux__)
+#define SEECPP_THREADED_CODE 1
+#endif
+
+#if defined(SEECPP_THREADED_CODE)
+class Emitter {
+ public:
+    void Byte(uint8_t b) { code_.push_back(b); }
+    void Bytes(std::initializer_list<uint8_t> bytes) { code_.insert(code_.end(), bytes); }
+    void U32(uint32_t v) {
+        for (int i = 0; i < 4; ++i) Byte(static_cast<uint8_t>(v >> (8 * i)));
+    }
+    void U64(uint64_t v) {
+        for (int i = 0; i < 8; ++i) Byte(static_cast<uint8_t>(v >> (8 * i)));
+    }
+    size_t size() const { return code_.size(); }
+    const std::vector<uint8_t>& code() const { return code_; }
+
+ private:
+    std::vector<uint8_t> code_;
+};
+
+// Distance from `from` to `target` if it fits in a signed field of `bits`.
+std::optional<int64_t> Displacement(uint64_t from, uint64_t target, int bits) {
+    const auto delta = static_cast<int64_t>(target - from);
+    const int64_t limit = int64_t{1} << (bits - 1);
+    if (delta < -limit || delta >= limit) return std::nullopt;
+    return delta;
+}
+
+#if defined(__x86_64__)
+// System V argument registers rdi, rsi, rdx, rcx, r8, r9, as the REX prefix
+// (0 for none) and opcode byte of `mov r32, imm32`; REX.W turns it into
+// `mov r64, imm64`.
+constexpr uint8_t kArgRex[6] = {0, 0, 0, 0, 0x41, 0x41};
+constexpr uint8_t kArgMov[6] = {0xBF, 0xBE, 0xBA, 0xB9, 0xB8, 0xB9};
+
+// Emits the function as if it started at `base`. A zero base assumes every
+// kernel is out of direct-call range, which gives the largest size.
+void Emit(Emitter& e, std::span<const KernelCall> calls, uint64_t base) {
+    e.Bytes({0x48, 0x83, 0xEC, 0x08});  // sub rsp, 8: realign to 16 for the calls
+    for (const KernelCall& call : calls) {
+        for (uint8_t i = 0; i < call.num_args; ++i) {
+            const uint64_t value = call.args[i];
+            if (value <= UINT32_MAX) {  // Writing the low half zero-extends.
+                if (kArgRex[i] != 0) e.Byte(kArgRex[i]);
+                e.Byte(kArgMov[i]);
+                e.U32(static_cast<uint32_t>(value));
+            } else {
+                e.Bytes({static_cast<uint8_t>(kArgRex[i] | 0x48), kArgMov[i]});
+                e.U64(value);
+            }
+        }
+        const auto target = reinterpret_cast<uint64_t>(call.function);
+        const std::optional<int64_t> rel =
+            base != 0 ? Displacement(base + e.size() + 5, target, 32) : std::nullopt;
+        if (rel) {
+            e.Byte(0xE8);  // call rel32
+            e.U32(static_cast<uint32_t>(*rel));
+        } else {
+            e.Bytes({0x48, 0xB8});  // mov rax, imm64
+            e.U64(target);
+            e.Bytes({0xFF, 0xD0});  // call rax
+        }
+    }
+    e.Bytes({0x48, 0x83, 0xC4, 0x08});  // add rsp, 8
+    e.Byte(0xC3);                       // ret
+}
+
+// How far a direct call reaches from the code.
+constexpr uint64_t kDirectReach = uint64_t{1} << 31;
+#elif defined(__aarch64__)
+// movz/movk xN, #imm16, lsl #(16 * k) for the non-zero halfwords of `value`.
+void MoveImmediate(Emitter& e, uint32_t reg, uint64_t value) {
+    e.U32(0xD2800000 | (static_cast<uint32_t>(value & 0xFFFF) << 5) | reg);
+    for (uint32_t k = 1; k < 4; ++k) {
+        const uint32_t half = static_cast<uint32_t>(value >> (16 * k)) & 0xFFFF;
+        if (half != 0) e.U32(0xF2800000 | (k << 21) | (half << 5) | reg);
+    }
+}
+
+void Emit(Emitter& e, std::span<const KernelCall> calls, uint64_t base) {
+    e.U32(0xA9BF7BFD);  // stp x29, x30, [sp, #-16]!
+    e.U32(0x910003FD);  // mov x29, sp
+    for (const KernelCall& call : calls) {
+        for (uint8_t i = 0; i < call.num_args; ++i) MoveImmediate(e, i, call.args[i]);
+        const auto target = reinterpret_cast<uint64_t>(call.function);
+        const std::optional<int64_t> rel =
+            base != 0 ? Displacement(base + e.size(), target, 28) : std::nullopt;
+        if (rel) {
+            e.U32(0x94000000 | (static_cast<uint32_t>(*rel >> 2) & 0x03FFFFFF));  // bl
+        } else {
+            MoveImmediate(e, 16, target);
+            e.U32(0xD63F0200);  // blr x16
+        }
+    }
+    e.U32(0xA8C17BFD);  // ldp x29, x30, [sp], #16
+    e.U32(0xD65F03C0);  // ret
+}
+
+constexpr uint64_t kDirectReach = uint64_t{1} << 27;
+#endif
+
+// Maps `size` bytes RW, preferably within direct-call reach of [low, high).
+// Shared objects usually land near other mappings anyway; the hint matters
+// for a position-independent executable, whose text the kernel places far
+// from the mmap area. Just below the kernels is normally free.
+void* MapNear(size_t size, uint64_t low, uint64_t high, size_t page) {
+    void* hint = nullptr;
+    if (low <= high && high - low < kDirectReach / 2 && low > kDirectReach / 4) {
+        hint = reinterpret_cast<void*>((low - kDirectReach / 4) & ~(uint64_t{page} - 1));
+    }
+    return mmap(hint, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+}
+#endif
+
+}  // namespace
+
+bool ThreadedCode::Supported() {
+#if defined(SEECPP_THREADED_CODE)
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::expected<std::unique_ptr<ThreadedCode>, std::string> ThreadedCode::Compile(
+    std::span<const KernelCall> calls) {
+#if defined(SEECPP_THREADED_CODE)
+    for (const KernelCall& call : calls) {
+        if (call.function == nullptr || call.num_args > call.args.size()) {
+            return std::unexpected("kernel call without a target or with more than six arguments");
+        }
+    }
+    uint64_t low = UINT64_MAX, high = 0;
+    for (const KernelCall& call : calls) {
+        low = std::min(low, reinterpret_cast<uint64_t>(call.function));
+        high = std::max(high, reinterpret_cast<uint64_t>(call.function));
+    }
+    Emitter far;
+    Emit(far, calls, 0);
+
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t mapping_size = (far.size() + page - 1) / page * page;
+    void* mapping = MapNear(mapping_size, low, high, page);
+    if (mapping == MAP_FAILED) {
+        return std::unexpected(std::format("mmap of {} bytes failed: {}", mapping_size,
+                                           std::strerror(errno)));
+    }
+    // Now that the address is known, call directly wherever the kernel is in reach.
+    Emitter emitter;
+    Emit(emitter, calls, reinterpret_cast<uint64_t>(mapping));
+    const std::vector<uint8_t>& code = emitter.code();
+    std::memcpy(mapping, code.data(), code.size());
+    // Never writable and executable at once.
+    if (mprotect(mapping, mapping_size, PROT_READ | PROT_EXEC) != 0) {
+        const int error = errno;
+        munmap(mapping, mapping_size);
+        return std::unexpected(std::format("mprotect(PROT_EXEC) failed: {}", std::strerror(error)));
+    }
+    char* begin = static_cast<char*>(mapping);
+    __builtin___clear_cache(begin, begin + code.size());
+    return std::unique_ptr<ThreadedCode>(new ThreadedCode(mapping, mapping_size, code.size()));
+#else
+    (void)calls;
+    return std::unexpected("threaded code needs x86-64 or AArch64 Linux");
+#endif
+}
+
+ThreadedCode::ThreadedCode(void* mapping, size_t mapping_size, size_t code_size)
+    : mapping_(mapping),
+      mapping_size_(mapping_size),
+      code_size_(code_size),
+      entry_(reinterpret_cast<void (*)()>(mapping)) {}
+
+ThreadedCode::~ThreadedCode() {
+    munmap(mapping_, mapping_size_);
+}
+
+}  // namespace seecpp::runtime
@@ -0,0 +1,63 @@
+#ifndef SEECPP_RUNTIME_THREADED_CODE_H_
+#define SEECPP_RUNTIME_THREADED_CODE_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace seecpp::runtime {
+
+/// @brief One call into the kernel library, with every argument already
+/// resolved to an absolute pointer or size.
+struct KernelCall {
+    /// Address of a function taking up to six integer or pointer arguments.
+    const void* function;
+    std::array<uint64_t, 6> args{};
+    uint8_t num_args = 0;
+};
+
+/// @brief A straight-line function, emitted at load time, that makes the
+/// kernel calls of one whole step in order: call-threaded code.
+///
+/// Each call loads its arguments as immediates into the argument registers
+/// and calls the kernel directly, so a step costs no decoding and no
+/// indirect branch per instruction beyond the calls themselves. The code
+/// lives in its own mapping, written while RW and then flipped to RX.
+/// Supported on x86-64 (System V) and AArch64 Linux.
+class ThreadedCode {
+ public:
+    /// @brief True if Compile() can emit code for this host.
+    static bool Supported();
+
+    /// @brief Emits a function performing `calls` in order.
+    static std::expected<std::unique_ptr<ThreadedCode>, std::string> Compile(
+        std::span<const KernelCall> calls);
+
+    ~ThreadedCode();
+
+    ThreadedCode(const ThreadedCode&) = delete;
+    ThreadedCode& operator=(const ThreadedCode&) = delete;
+
+    /// @brief Runs every call once. Like Invoke(), not reentrant: the baked
+    /// pointers address the one arena of the engine that compiled it.
+    void Run() const { entry_(); }
+
+    /// @brief Bytes of machine code emitted, excluding page rounding.
+    size_t code_size() const { return code_size_; }
+
+ private:
+    ThreadedCode(void* mapping, size_t mapping_size, size_t code_size);
+
+    void* mapping_;
+    size_t mapping_size_;
+    size_t code_size_;
+    void (*entry_)();
+};
+
+}  // namespace seecpp::runtime
+
+#endif  // SEECPP_RUNTIME_THREADED_CODE_H_
@@ -0,0 +1,132 @@
+#include "src/runtime/weight_streamer.h"
+#include "src/serialization/schema.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include <unistd.h>
+
+namespace seecpp::runtime {
+
+WeightStreamer::WeightStreamer(const uint8_t* rodata,
+                               std::span<const backend::WeightRef> refs,
+                               size_t num_instructions,
+                               StreamingOptions options)
+    : rodata_(rodata),
+      num_instructions_(num_instructions),
+      options_(options),
+      page_size_(static_cast<size_t>(sysconf(_SC_PAGESIZE))) {
+    // 1. Collapse the per-instruction references into distinct rodata extents,
+    // recording the first and last instruction of the step that reads each one.
+    std::unordered_map<uint64_t, uint32_t> extent_by_offset;
+    refs_begin_.assign(num_instructions_ + 1, 0);
+    refs_.reserve(refs.size());
+
+    for (const auto& ref : refs) {
+        auto [it, inserted] = extent_by_offset.try_emplace(
+            ref.rodata_offset, static_cast<uint32_t>(extents_.size()));
+        if (inserted) {
+            extents_.push_back({ref.rodata_offset, ref.size, ref.instruction, ref.instruction});
+        }
+        extents_[it->second].last_use = ref.instruction;
+        refs_.push_back(it->second);
+        ++refs_begin_[ref.instruction + 1];
+    }
+    for (size_t i = 0; i < num_instructions_; ++i) refs_begin_[i + 1] += refs_begin_[i];
+
+    // 2. Order extents by their last use so eviction is a single forward sweep.
+    eviction_order_.resize(extents_.size());
+    for (uint32_t i = 0; i < eviction_order_.size(); ++i) eviction_order_[i] = i;
+    std::sort(eviction_order_.begin(), eviction_order_.end(), [&](uint32_t a, uint32_t b) {
+        return extents_[a].last_use < extents_[b].last_use;
+    });
+
+    // 3. Instructions at which the helper has work. Reaching `i` brings
+    // i + lookahead into the window, and passes the last use at i - 1.
+    wake_.assign(num_instructions_, 0);
+    const size_t ahead = num_instructions_ ? options_.lookahead % num_instructions_ : 0;
+    for (size_t i = 0; i < num_instructions_; ++i) {
+        if (refs_begin_[i] == refs_begin_[i + 1]) continue;
+        wake_[(i + num_instructions_ - ahead) % num_instructions_] = 1;
+    }
+    for (const Extent& e : extents_) {
+        if (e.last_use + 1 < num_instructions_) wake_[e.last_use + 1] = 1;
+    }
+
+    if (num_instructions_ > 0) {
+        helper_ = std::thread([this] { HelperLoop(); });
+    }
+}
+
+WeightStreamer::~WeightStreamer() {
+    if (!helper_.joinable()) return;
+    stop_.store(true, std::memory_order_release);
+    // Bump the counter so a helper parked in wait() observes a change.
+    progress_.fetch_add(1, std::memory_order_release);
+    progress_.notify_one();
+    helper_.join();
+}
+
+void WeightStreamer::HelperLoop() {
+    const size_t n = num_instructions_;
+    uint64_t prefetched = 0;   // Next global sequence number to prefetch
+    uint64_t evict_step = 0;   // Step whose eviction sweep is in progress
+    size_t evict_cursor = 0;   // Position within eviction_order_
+
+    // Evicts every extent whose last use precedes `pos`, unless the wrapped
+    // lookahead would immediately bring it back for the next step.
+    auto sweep = [&](size_t pos) {
+        for (; evict_cursor < eviction_order_.size(); ++evict_cursor) {
+            const Extent& e = extents_[eviction_order_[evict_cursor]];
+            if (e.last_use >= pos) break;
+            if ((n - pos) + e.first_use > options_.lookahead) Evict(e);
+        }
+    };
+
+    uint64_t seen = progress_.load(std::memory_order_acquire);
+    while (!stop_.load(std::memory_order_acquire)) {
+        const uint64_t step = seen / n;
+        const size_t pos = static_cast<size_t>(seen % n);
+
+        // 1. Eviction. If the interpreter has moved to a new step, finish the
+        // previous one first; everything it read is now past its last use.
+        if (evict_step < step) {
+            sweep(n);
+            evict_step = step;
+            evict_cursor = 0;
+        }
+        sweep(pos);
+
+        // 2. Prefetch the window [seen, seen + lookahead], wrapping into the next step.
+        prefetched = std::max(prefetched, seen);
+        for (; prefetched <= seen + options_.lookahead; ++prefetched) {
+            Prefetch(static_cast<size_t>(prefetched % n));
+        }
+
+        // 3. Park until the interpreter advances.
+        progress_.wait(seen, std::memory_order_acquire);
+        seen = progress_.load(std::memory_order_acquire);
+    }
+}
+
+void WeightStreamer::Prefetch(size_t instruction) {
+    for (uint32_t r = refs_begin_[instruction]; r < refs_begin_[instruction + 1]; ++r) {
+        const Extent& e = extents_[refs_[r]];
+        // Round outward: over-fetching a neighbour's page is harmless.
+        const auto begin = reinterpret_cast<uintptr_t>(rodata_ + e.offset) & ~(page_size_ - 1);
+        const auto end = reinterpret_cast<uintptr_t>(rodata_ + e.offset + e.size);
+        options_.advise(reinterpret_cast<void*>(begin), end - begin, MADV_WILLNEED);
+    }
+}
+
+void WeightStreamer::Evict(const Extent& e) {
+    // Round inward: never drop a page that a neighbouring tensor still shares.
+    // Page-aligned packing (see PackingOptions) makes this exact for large tensors.
+    const auto addr = reinterpret_cast<uintptr_t>(rodata_ + e.offset);
+    const uintptr_t begin = (addr + page_size_ - 1) & ~(page_size_ - 1);
+    const uintptr_t end = (addr + e.size) & ~(page_size_ - 1);
+    if (end <= begin) return;
+    options_.advise(reinterpret_cast<void*>(begin), end - begin, MADV_DONTNEED);
+}
+
+}  // namespace seecpp::runtime
@@ -0,0 +1,105 @@
+#ifndef SEECPP_RUNTIME_WEIGHT_STREAMER_H_
+#define SEECPP_RUNTIME_WEIGHT_STREAMER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <sys/mman.h>
+
+namespace seecpp::backend {
+struct WeightRef;
+}
+
+namespace seecpp::runtime {
+
+/// @brief Tuning knobs for weight streaming.
+struct StreamingOptions {
+    /// @brief How many instructions ahead of the interpreter to issue
+    /// MADV_WILLNEED for. Larger values hide more I/O latency but keep more
+    /// weights resident at once.
+    size_t lookahead = 8;
+
+    /// @brief Issues the memory advice. Replaceable so tests can observe the
+    /// prefetch and eviction order.
+    int (*advise)(void* addr, size_t length, int advice) = ::madvise;
+};
+
+/// @brief Keeps only a sliding window of the rodata section resident, for
+/// models that are close to or larger than physical memory.
+///
+/// A helper thread follows the interpreter's progress through the text
+/// section. It prefetches the weights of the next `lookahead` instructions and
+/// drops the pages of weights whose last use in the current step has passed.
+/// The lookahead wraps across step boundaries so the first layers of the next
+/// step are already in flight while the current step finishes.
+class WeightStreamer {
+ public:
+    /// @param rodata Base of the mmap()ed rodata section.
+    /// @param refs The file's WeightRef table, sorted by instruction index.
+    /// @param num_instructions Length of the text section.
+    WeightStreamer(const uint8_t* rodata,
+                   std::span<const backend::WeightRef> refs,
+                   size_t num_instructions,
+                   StreamingOptions options);
+    ~WeightStreamer();
+
+    WeightStreamer(const WeightStreamer&) = delete;
+    WeightStreamer& operator=(const WeightStreamer&) = delete;
+
+    /// @brief Publishes that the interpreter is about to execute instruction
+    /// `index` of the current step. Called from the hot loop; never blocks,
+    /// and wakes the helper only where it has something to prefetch or evict.
+    void OnInstruction(size_t index) {
+        progress_.store(step_base_ + index, std::memory_order_release);
+        if (wake_[index]) progress_.notify_one();
+    }
+
+    /// @brief Marks the end of a step so the helper evicts what remains.
+    void OnStepEnd() {
+        step_base_ += num_instructions_;
+        progress_.store(step_base_, std::memory_order_release);
+        progress_.notify_one();
+    }
+
+ private:
+    /// @brief A distinct rodata range and the span of the step that reads it.
+    struct Extent {
+        uint64_t offset;
+        uint64_t size;
+        size_t first_use;
+        size_t last_use;
+    };
+
+    void HelperLoop();
+    void Prefetch(size_t instruction);
+    void Evict(const Extent& extent);
+
+    const uint8_t* rodata_;
+    size_t num_instructions_;
+    StreamingOptions options_;
+    size_t page_size_;
+
+    // refs_begin_[i]..refs_begin_[i + 1] indexes the extents read by instruction i.
+    std::vector<uint32_t> refs_begin_;
+    std::vector<uint32_t> refs_;
+    std::vector<Extent> extents_;
+    // Extent indices sorted by last_use, consumed front-to-back each step.
+    std::vector<uint32_t> eviction_order_;
+    // Nonzero at the instructions where the prefetch window reaches a weight
+    // or a weight's last use has just passed.
+    std::vector<uint8_t> wake_;
+
+    // Global instruction sequence number: step * num_instructions + index.
+    uint64_t step_base_ = 0;
+    std::atomic<uint64_t> progress_{0};
+    std::atomic<bool> stop_{false};
+    std::thread helper_;
+};
+
+}  // namespace seecpp::runtime
+
+#endif  // SEECPP_RUNTIME_WEIGHT_STREAMER_H_
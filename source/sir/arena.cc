@@ -0,0 +1,130 @@
+#include "seecpp/sir/arena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace seecpp::sir {
+
+namespace {
+
+std::byte* alignUp(std::byte* p, size_t alignment) {
+    const auto addr = reinterpret_cast<uintptr_t>(p);
+    return p + ((alignment - addr % alignment) % alignment);
+}
+
+// The lane the current thread's requests on `owner` are redirected to.
+struct LaneRoute {
+    const Arena* owner = nullptr;
+    Arena* lane = nullptr;
+};
+thread_local LaneRoute t_route;
+
+} // namespace
+
+Arena::LaneScope::LaneScope(Arena& arena, size_t index)
+    : prev_owner_(t_route.owner), prev_lane_(t_route.lane) {
+    Arena* lane;
+    {
+        std::lock_guard<std::mutex> lock(arena.lanes_mutex_);
+        if (arena.lanes_.size() <= index) arena.lanes_.resize(index + 1);
+        if (!arena.lanes_[index]) arena.lanes_[index] = std::make_unique<Arena>();
+        lane = arena.lanes_[index].get();
+    }
+    t_route = {&arena, lane};
+}
+
+Arena::LaneScope::~LaneScope() {
+    t_route = {prev_owner_, prev_lane_};
+}
+
+size_t Arena::bytesAllocated() const {
+    std::lock_guard<std::mutex> lock(lanes_mutex_);
+    size_t total = bytes_allocated_;
+    for (const auto& lane : lanes_) total += lane ? lane->bytesAllocated() : 0;
+    return total;
+}
+
+size_t Arena::bytesReserved() const {
+    std::lock_guard<std::mutex> lock(lanes_mutex_);
+    size_t total = bytes_reserved_;
+    for (const auto& lane : lanes_) total += lane ? lane->bytesReserved() : 0;
+    return total;
+}
+
+size_t Arena::bytesInUse() const {
+    std::lock_guard<std::mutex> lock(lanes_mutex_);
+    size_t total = bytes_in_use_;
+    for (const auto& lane : lanes_) total += lane ? lane->bytesInUse() : 0;
+    return total;
+}
+
+Arena::~Arena() {
+    while (slabs_) {
+        Slab* prev = slabs_->prev;
+        ::operator delete(slabs_, slabs_->size);
+        slabs_ = prev;
+    }
+}
+
+void* Arena::do_allocate(size_t bytes, size_t alignment) {
+    if (t_route.owner == this) return t_route.lane->allocate(bytes, alignment);
+
+    const size_t cls = sizeClass(bytes, alignment);
+    if (cls < kNumSizeClasses) {
+        if (FreeBlock* block = free_lists_[cls]) {
+            free_lists_[cls] = block->next;
+            bytes_in_use_ += (cls + 1) * kSizeClassBytes;
+            return block;
+        }
+        // Round up so the block can later serve any request of its class.
+        bytes = (cls + 1) * kSizeClassBytes;
+        alignment = kSizeClassBytes;
+    }
+
+    std::byte* p = alignUp(cursor_, alignment);
+    if (!cursor_ || p + bytes > end_) {
+        addSlab(bytes, alignment);
+        p = alignUp(cursor_, alignment);
+    }
+    bytes_allocated_ += static_cast<size_t>(p + bytes - cursor_);
+    bytes_in_use_ += bytes;
+    cursor_ = p + bytes;
+    return p;
+}
+
+void Arena::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    // Every lane's slabs live as long as this arena, so a block may be
+    // recycled by whichever lane frees it.
+    if (t_route.owner == this) return t_route.lane->deallocate(p, bytes, alignment);
+
+    const size_t cls = sizeClass(bytes, alignment);
+    if (cls == kNumSizeClasses) {
+        bytes_in_use_ -= bytes;
+        return;  // Reclaimed with its slab.
+    }
+    bytes_in_use_ -= (cls + 1) * kSizeClassBytes;
+    auto* block = static_cast<FreeBlock*>(p);
+    block->next = free_lists_[cls];
+    free_lists_[cls] = block;
+}
+
+void Arena::addSlab(size_t min_bytes, size_t alignment) {
+    // Oversized requests get a slab of their own rather than skipping ahead
+    // in the doubling schedule.
+    const size_t needed = sizeof(Slab) + min_bytes + alignment;
+    const size_t size = std::max(next_slab_bytes_, needed);
+    if (size == next_slab_bytes_)
+        next_slab_bytes_ = std::min(next_slab_bytes_ * 2, kMaxSlabBytes);
+
+    auto* slab = static_cast<Slab*>(::operator new(size));
+    slab->prev = slabs_;
+    slab->size = size;
+    slabs_ = slab;
+    bytes_reserved_ += size;
+
+    cursor_ = reinterpret_cast<std::byte*>(slab + 1);
+    end_ = reinterpret_cast<std::byte*>(slab) + size;
+}
+
+} // namespace seecpp::sir
@@ -0,0 +1,113 @@
+#ifndef SEECPP_SIR_ARENA_H_
+#define SEECPP_SIR_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace seecpp::sir {
+
+/// @brief Bump-pointer allocator that owns all IR storage of one Block.
+///
+/// Memory is carved from a chain of slabs whose size doubles up to
+/// kMaxSlabBytes and is released at once when the arena is destroyed. Small
+/// blocks that are freed early (erased ops, outgrown operand arrays) go onto
+/// per-size free lists, so rewrite-heavy passes reuse warm memory instead of
+/// touching fresh pages. Because it is a std::pmr::memory_resource, the IR's
+/// operand, result, user and attribute arrays can grow inside it as well.
+/// Not thread-safe; concurrent tasks each bind a lane with a LaneScope.
+class Arena final : public std::pmr::memory_resource {
+ public:
+    static constexpr size_t kFirstSlabBytes = 16 * 1024;
+    static constexpr size_t kMaxSlabBytes = 4 * 1024 * 1024;
+    static constexpr size_t kSizeClassBytes = 16;
+    static constexpr size_t kMaxRecycledBytes = 512;
+
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    ~Arena() override;
+
+    /// @brief Constructs a T in the arena. Nested pmr containers in T should be
+    /// given `this` as their resource so they allocate here too.
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        return std::pmr::polymorphic_allocator<>(this).new_object<T>(std::forward<Args>(args)...);
+    }
+
+    /// @brief Routes the calling thread's allocations and frees on `arena` to
+    /// its `index`-th lane while the scope is alive.
+    ///
+    /// A lane is a child arena owned by the parent and released with it, so
+    /// memory obtained through a lane may end up in the parent's IR. Tasks
+    /// that run concurrently must use distinct indices; lanes are created on
+    /// first use and reused by later scopes with the same index.
+    class LaneScope {
+     public:
+        LaneScope(Arena& arena, size_t index);
+        ~LaneScope();
+        LaneScope(const LaneScope&) = delete;
+        LaneScope& operator=(const LaneScope&) = delete;
+
+     private:
+        const Arena* prev_owner_;
+        Arena* prev_lane_;
+    };
+
+    // The counters below include lanes. Read them only while no LaneScope on
+    // this arena is active.
+
+    /// @brief Bytes handed out so far, including alignment padding.
+    size_t bytesAllocated() const;
+    /// @brief Bytes obtained from the system for slabs.
+    size_t bytesReserved() const;
+    /// @brief Bytes held by live allocations, i.e. not yet freed back to the
+    /// arena. Recycled blocks count at their size-class size.
+    size_t bytesInUse() const;
+
+ private:
+    struct Slab {
+        Slab* prev;
+        size_t size;
+    };
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static constexpr size_t kNumSizeClasses = kMaxRecycledBytes / kSizeClassBytes;
+
+    /// @brief Free-list index for a request, or kNumSizeClasses if it is not recycled.
+    static size_t sizeClass(size_t bytes, size_t alignment) {
+        if (bytes == 0 || bytes > kMaxRecycledBytes || alignment > kSizeClassBytes) return kNumSizeClasses;
+        return (bytes - 1) / kSizeClassBytes;
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    void addSlab(size_t min_bytes, size_t alignment);
+
+    FreeBlock* free_lists_[kNumSizeClasses] = {};
+    Slab* slabs_ = nullptr;
+    std::byte* cursor_ = nullptr;
+    std::byte* end_ = nullptr;
+    size_t next_slab_bytes_ = kFirstSlabBytes;
+    size_t bytes_allocated_ = 0;
+    size_t bytes_reserved_ = 0;
+    // A block may be freed through a different lane than the one that
+    // allocated it, so a single lane's count can wrap; the sum stays exact.
+    size_t bytes_in_use_ = 0;
+
+    mutable std::mutex lanes_mutex_;  // Guards lanes_ itself, not the lanes
+    std::vector<std::unique_ptr<Arena>> lanes_;
+};
+
+} // namespace seecpp::sir
+
+#endif // SEECPP_SIR_ARENA_H_
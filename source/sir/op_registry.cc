@@ -0,0 +1,74 @@
+#include "seecpp/sir/op_registry.h"
+
+#include <cassert>
+#include <mutex>
+
+namespace seecpp::sir {
+
+namespace {
+
+#define SEECPP_SIR_NAME(name, str) str,
+constexpr std::string_view kBuiltinOpNames[] = { SEECPP_SIR_BUILTIN_OPS(SEECPP_SIR_NAME) };
+constexpr std::string_view kBuiltinAttrNames[] = { SEECPP_SIR_BUILTIN_ATTRS(SEECPP_SIR_NAME) };
+#undef SEECPP_SIR_NAME
+
+Dialect classify(std::string_view mnemonic) {
+    if (mnemonic.starts_with("sc_high.")) return Dialect::kHigh;
+    if (mnemonic.starts_with("sc_low."))  return Dialect::kLow;
+    if (mnemonic.starts_with("sc_mem."))  return Dialect::kMemory;
+    if (mnemonic.starts_with("sc_ctrl.")) return Dialect::kControl;
+    return Dialect::kOther;
+}
+
+} // namespace
+
+OpRegistry& OpRegistry::Get() {
+    static OpRegistry registry;
+    return registry;
+}
+
+OpRegistry::OpRegistry() {
+    // Interning in declaration order makes each ID equal its sir::op / sir::attr constant.
+    for (std::string_view name : kBuiltinOpNames) InternOp(name);
+    for (std::string_view name : kBuiltinAttrNames) InternAttr(name);
+    assert(ops_.names.size() == op::kNumBuiltins);
+    assert(attrs_.names.size() == attr::kNumBuiltins);
+    for (OpId id = 0; id < op::kNumBuiltins; ++id) builtin_infos_[id] = &op_infos_[id];
+}
+
+const OpInfo& OpRegistry::GetOpInfo(OpId id) const {
+    // Builtins make up nearly every op, and their entries are immutable.
+    if (id < op::kNumBuiltins) return *builtin_infos_[id];
+    std::shared_lock lock(mutex_);
+    return op_infos_.at(id);
+}
+
+uint32_t OpRegistry::Intern(Table& table, std::string_view name) {
+    {
+        std::shared_lock lock(mutex_);
+        if (auto it = table.ids.find(name); it != table.ids.end()) return it->second;
+    }
+
+    std::unique_lock lock(mutex_);
+    // Another thread may have interned the name between the two locks.
+    if (auto it = table.ids.find(name); it != table.ids.end()) return it->second;
+
+    const auto id = static_cast<uint32_t>(table.names.size());
+    const std::string& stored = table.names.emplace_back(name);
+    table.ids.emplace(stored, id);
+    if (&table == &ops_) op_infos_.push_back(OpInfo{id, classify(stored), stored});
+    return id;
+}
+
+std::optional<uint32_t> OpRegistry::Lookup(const Table& table, std::string_view name) const {
+    std::shared_lock lock(mutex_);
+    if (auto it = table.ids.find(name); it != table.ids.end()) return it->second;
+    return std::nullopt;
+}
+
+std::string_view OpRegistry::Name(const Table& table, uint32_t id) const {
+    std::shared_lock lock(mutex_);
+    return table.names.at(id);
+}
+
+} // namespace seecpp::sir
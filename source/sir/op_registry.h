@@ -0,0 +1,168 @@
+#ifndef SEECPP_SIR_OP_REGISTRY_H_
+#define SEECPP_SIR_OP_REGISTRY_H_
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace seecpp::sir {
+
+/// @brief Interned identifier of an operation mnemonic.
+using OpId = uint32_t;
+/// @brief Interned identifier of an attribute name.
+using AttrId = uint32_t;
+
+/// @brief The mnemonic prefix of an op, resolved once at interning time.
+enum class Dialect : uint8_t {
+    kHigh,     // sc_high.*
+    kLow,      // sc_low.*
+    kMemory,   // sc_mem.*
+    kControl,  // sc_ctrl.*
+    kOther
+};
+
+// Mnemonics known to the compiler itself. They are interned first, in this
+// order, so passes can compare against the compile-time constants in sir::op.
+#define SEECPP_SIR_BUILTIN_OPS(X)                                   \
+    X(kConstant,          "sc_high.constant")                       \
+    X(kAdd,               "sc_high.add")                            \
+    X(kSub,               "sc_high.sub")                            \
+    X(kMul,               "sc_high.mul")                            \
+    X(kDiv,               "sc_high.div")                            \
+    X(kPow,               "sc_high.pow")                            \
+    X(kRelu,              "sc_high.relu")                           \
+    X(kMatMul,            "sc_high.matmul")                         \
+    X(kGemm,              "sc_high.gemm")                           \
+    X(kConv2d,            "sc_high.conv2d")                         \
+    X(kConv2dGradInput,   "sc_high.conv2d_grad_input")              \
+    X(kConv2dGradFilter,  "sc_high.conv2d_grad_filter")             \
+    X(kBatchNorm,         "sc_high.batch_norm")                     \
+    X(kReshape,           "sc_high.reshape")                        \
+    X(kTranspose,         "sc_high.transpose")                      \
+    X(kConcat,            "sc_high.concat")                         \
+    X(kMaxPool,           "sc_high.maxpool")                        \
+    X(kAvgPool,           "sc_high.avgpool")                        \
+    X(kFusedEw,           "sc_high.fused_ew")                       \
+    X(kReturn,            "sc_high.return")                         \
+    X(kYield,             "sc_high.yield")                          \
+    X(kLowMatMul,         "sc_low.matmul")                          \
+    X(kLowConv2d,         "sc_low.conv2d")                          \
+    X(kLowRelu,           "sc_low.relu")                            \
+    X(kLowTranspose,      "sc_low.transpose")                       \
+    X(kLowIm2Col,         "sc_low.im2col")                          \
+    X(kLowCol2Im,         "sc_low.col2im")                          \
+    X(kLowViewCast,       "sc_low.view_cast")                       \
+    X(kLowReduceSum,      "sc_low.reduce_sum")                      \
+    X(kLowReturn,         "sc_low.return")
+
+// Attribute names read or written by the compiler's own passes.
+#define SEECPP_SIR_BUILTIN_ATTRS(X)                                 \
+    X(kWeightRef,         "weight_ref")                             \
+    X(kValue,             "value")                                  \
+    X(kRuntimeOpcode,     "runtime_opcode")                         \
+    X(kInputOffsets,      "input_offsets")                          \
+    X(kOutputOffsets,     "output_offsets")                         \
+    X(kStrides,           "strides")                                \
+    X(kPads,              "pads")                                   \
+    X(kDilations,         "dilations")                              \
+    X(kGroup,             "group")                                  \
+    X(kKernelShape,       "kernel_shape")                           \
+    X(kTargetShape,       "target_shape")                           \
+    X(kEpsilon,           "epsilon")                                \
+    X(kOpSequence,        "op_sequence")                            \
+    X(kTransA,            "trans_a")                                \
+    X(kTransB,            "trans_b")                                \
+    X(kAxis,              "axis")                                   \
+    X(kAlpha,             "alpha")                                  \
+    X(kBeta,              "beta")                                   \
+    X(kFusedBn,           "fused_bn")                               \
+    X(kBnEpsilon,         "bn_epsilon")                             \
+    X(kBnScaleId,         "bn_scale_id")                            \
+    X(kBnBiasId,          "bn_bias_id")                             \
+    X(kBnMeanId,          "bn_mean_id")                             \
+    X(kBnVarId,           "bn_var_id")                              \
+    X(kFlops,             "flops")                                  \
+    X(kBytesRead,         "bytes_read")                             \
+    X(kBytesWritten,      "bytes_written")                          \
+    X(kSourceNode,        "source_node")                            \
+    X(kSourceOpType,      "source_op_type")
+
+#define SEECPP_SIR_DECLARE_ID(name, str) name,
+
+namespace op {
+enum : OpId { SEECPP_SIR_BUILTIN_OPS(SEECPP_SIR_DECLARE_ID) kNumBuiltins };
+}  // namespace op
+
+namespace attr {
+enum : AttrId { SEECPP_SIR_BUILTIN_ATTRS(SEECPP_SIR_DECLARE_ID) kNumBuiltins };
+
+/// @brief Attributes recording which source node an op came from. They never
+/// change what an op computes, so passes that compare ops ignore them.
+constexpr bool isSourceInfo(AttrId id) { return id == kSourceNode || id == kSourceOpType; }
+}  // namespace attr
+
+#undef SEECPP_SIR_DECLARE_ID
+
+/// @brief What the registry knows about one op mnemonic. Entries never move,
+/// so an op keeps a pointer to its own instead of asking the registry again.
+struct OpInfo {
+    OpId id;
+    Dialect dialect;
+    std::string_view name;
+};
+
+/// @brief Process-wide interning table for op mnemonics and attribute names.
+///
+/// IDs are dense, never reused, and stable for the life of the process; the
+/// builtin IDs above are additionally stable across processes. Names live in
+/// node-stable storage, so the string_views handed out stay valid forever.
+/// Thread-safe: concurrent compilations intern into the same table.
+class OpRegistry {
+ public:
+    static OpRegistry& Get();
+
+    OpRegistry(const OpRegistry&) = delete;
+    OpRegistry& operator=(const OpRegistry&) = delete;
+
+    OpId InternOp(std::string_view mnemonic) { return Intern(ops_, mnemonic); }
+    AttrId InternAttr(std::string_view name) { return Intern(attrs_, name); }
+
+    /// @brief Finds an ID without creating one. A name that was never interned
+    /// cannot be stored on any op, so lookups need not grow the table.
+    std::optional<OpId> LookupOp(std::string_view mnemonic) const { return Lookup(ops_, mnemonic); }
+    std::optional<AttrId> LookupAttr(std::string_view name) const { return Lookup(attrs_, name); }
+
+    /// @brief The entry for `id`. Builtins are read without taking the lock.
+    const OpInfo& GetOpInfo(OpId id) const;
+    std::string_view OpName(OpId id) const { return GetOpInfo(id).name; }
+    std::string_view AttrName(AttrId id) const { return Name(attrs_, id); }
+    Dialect OpDialect(OpId id) const { return GetOpInfo(id).dialect; }
+
+ private:
+    struct Table {
+        std::deque<std::string> names;
+        std::unordered_map<std::string_view, uint32_t> ids;
+    };
+
+    OpRegistry();
+
+    uint32_t Intern(Table& table, std::string_view name);
+    std::optional<uint32_t> Lookup(const Table& table, std::string_view name) const;
+    std::string_view Name(const Table& table, uint32_t id) const;
+
+    mutable std::shared_mutex mutex_;
+    Table ops_;
+    Table attrs_;
+    std::deque<OpInfo> op_infos_;  // Indexed by OpId, like ops_.names
+    // Filled by the constructor and never written again, so readable unlocked.
+    std::array<const OpInfo*, op::kNumBuiltins> builtin_infos_{};
+};
+
+}  // namespace seecpp::sir
+
+#endif  // SEECPP_SIR_OP_REGISTRY_H_
@@ -0,0 +1,180 @@
+#include "seecpp/sir/rewrite_driver.h"
+
+#include <algorithm>
+#include <cassert>
+#include <unordered_map>
+
+namespace seecpp::sir {
+
+// --- PatternRewriter Implementation ---
+
+Operation* PatternRewriter::CreateOp(
+    OpId op_id,
+    const std::vector<Value*>& operands,
+    const std::vector<DataType>& result_types,
+    const std::vector<Shape>& result_shapes) {
+    assert(result_types.size() == result_shapes.size() &&
+           "Result types and shapes must align.");
+
+    Operation* op = ip_ ? block_.insertOpBefore(op_id, ip_)
+                        : block_.appendOp(op_id);
+    for (Value* operand : operands) op->addOperand(operand);
+    for (size_t i = 0; i < result_types.size(); ++i)
+        op->addResult("", result_types[i], result_shapes[i]);
+
+    NotifyOpInserted(op);
+    return op;
+}
+
+void PatternRewriter::ReplaceAllUsesWith(Value* from, Value* to) {
+    // Users are notified before the move; afterwards they are mixed in with
+    // the existing users of `to`.
+    for (Operation* user : from->users()) NotifyOpModified(user);
+    from->replaceAllUsesWith(to);
+}
+
+void PatternRewriter::ReplaceOp(Operation* old_op, const std::vector<Value*>& new_values) {
+    assert(old_op->numResults() == new_values.size() &&
+           "Replacement values must match the number of original results.");
+
+    for (size_t i = 0; i < new_values.size(); ++i)
+        ReplaceAllUsesWith(old_op->result(i), new_values[i]);
+    EraseOp(old_op);
+}
+
+void PatternRewriter::EraseOp(Operation* op) {
+    assert(std::all_of(op->results().begin(), op->results().end(),
+                       [](const Value* v) { return v->hasNoUses(); }) &&
+           "Erasing an op whose results are still used.");
+    if (ip_ == op) ip_ = nullptr;
+
+    NotifyOpErased(op);
+    block_.removeOp(op);  // Destroyed here, which unlinks its operands.
+}
+
+void PatternRewriter::ModifiedOpInPlace(Operation* op) {
+    NotifyOpModified(op);
+    for (const Value* result : op->results())
+        for (Operation* user : result->users()) NotifyOpModified(user);
+}
+
+// --- RewritePatternSet Implementation ---
+
+void RewritePatternSet::Add(std::unique_ptr<RewritePattern> pattern) {
+    const OpId root = pattern->GetRootOp();
+    if (root >= by_op_.size()) by_op_.resize(root + 1);
+    by_op_[root].push_back(pattern.get());
+    owned_.push_back(std::move(pattern));
+}
+
+// --- Greedy Driver ---
+
+namespace {
+
+/// @brief A LIFO worklist with O(1) membership test and removal. Removed
+/// entries are nulled in place and skipped when popped.
+class Worklist {
+ public:
+    void Push(Operation* op) {
+        if (index_.try_emplace(op, ops_.size()).second) ops_.push_back(op);
+    }
+
+    Operation* Pop() {
+        while (!ops_.empty()) {
+            Operation* op = ops_.back();
+            ops_.pop_back();
+            if (op) {
+                index_.erase(op);
+                return op;
+            }
+        }
+        return nullptr;
+    }
+
+    void Remove(Operation* op) {
+        auto it = index_.find(op);
+        if (it == index_.end()) return;
+        ops_[it->second] = nullptr;
+        index_.erase(it);
+    }
+
+ private:
+    std::vector<Operation*> ops_;
+    std::unordered_map<Operation*, size_t> index_;
+};
+
+class GreedyDriver final : public PatternRewriter {
+ public:
+    GreedyDriver(Block& block, const RewritePatternSet& patterns)
+        : PatternRewriter(block), patterns_(patterns) {}
+
+    RewriteStats Run(GreedyRewriteConfig config) {
+        const auto start = std::chrono::steady_clock::now();
+        RewriteStats stats;
+        const size_t budget = config.max_rewrites_per_op *
+                              std::max<size_t>(block().numOps(), 1);
+
+        cursor_ = block().front();
+        while (Operation* op = Next()) {
+            ++stats.visits;
+            for (const RewritePattern* pattern : patterns_.PatternsFor(op->opId())) {
+                SetInsertionPoint(op);
+                if (pattern->MatchAndRewrite(op, *this)) {
+                    ++stats.rewrites;
+                    break;  // The op may have been erased; it is re-queued if not done.
+                }
+            }
+            if (stats.rewrites >= budget) {
+                stats.converged = false;
+                break;
+            }
+        }
+
+        stats.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+        return stats;
+    }
+
+ protected:
+    void NotifyOpInserted(Operation* op) override { worklist_.Push(op); }
+    void NotifyOpModified(Operation* op) override { worklist_.Push(op); }
+
+    void NotifyOpErased(Operation* op) override {
+        worklist_.Remove(op);
+        if (op == cursor_) cursor_ = op->nextInBlock();
+        // Producers lose a user, which may enable single-use or dead-value rules.
+        for (Value* operand : op->operands()) {
+            if (operand && operand->definingOp())
+                worklist_.Push(operand->definingOp());
+        }
+    }
+
+ private:
+    /// @brief Re-queued ops first, then the next op of the initial sweep.
+    ///
+    /// The first visit of every op comes from walking the block's own list in
+    /// program order, so producers simplify before their consumers are
+    /// examined and the hashed worklist only ever holds ops touched by a
+    /// rewrite.
+    Operation* Next() {
+        if (Operation* op = worklist_.Pop()) return op;
+        Operation* op = cursor_;
+        if (op) cursor_ = op->nextInBlock();
+        return op;
+    }
+
+    const RewritePatternSet& patterns_;
+    Worklist worklist_;
+    Operation* cursor_ = nullptr;
+};
+
+}  // namespace
+
+RewriteStats ApplyPatternsGreedily(Block& block,
+                                   const RewritePatternSet& patterns,
+                                   GreedyRewriteConfig config) {
+    if (patterns.empty()) return {};
+    return GreedyDriver(block, patterns).Run(config);
+}
+
+}  // namespace seecpp::sir
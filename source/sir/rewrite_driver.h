@@ -0,0 +1,133 @@
+#ifndef SEECPP_SIR_REWRITE_DRIVER_H_
+#define SEECPP_SIR_REWRITE_DRIVER_H_
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "seecpp/sir/sir.h"
+
+namespace seecpp::sir {
+
+/// @brief The only sanctioned way for a pattern to mutate the IR. Every
+/// mutation is reported through the Notify* hooks, which is how the greedy
+/// driver learns which ops need another look.
+///
+/// Lives with the IR rather than in any one stage: the frontend canonicalizer
+/// and the middle-end peephole passes share it.
+class PatternRewriter {
+ public:
+    explicit PatternRewriter(Block& block) : block_(block) {}
+    virtual ~PatternRewriter() = default;
+
+    PatternRewriter(const PatternRewriter&) = delete;
+    PatternRewriter& operator=(const PatternRewriter&) = delete;
+
+    Block& block() { return block_; }
+
+    /// @brief New ops are inserted before `op`, or appended if it is null.
+    void SetInsertionPoint(Operation* op) { ip_ = op; }
+
+    /// @brief Creates an op at the insertion point.
+    Operation* CreateOp(OpId op_id,
+                        const std::vector<Value*>& operands,
+                        const std::vector<DataType>& result_types,
+                        const std::vector<Shape>& result_shapes);
+
+    /// @brief Redirects every use of `from` to `to`.
+    void ReplaceAllUsesWith(Value* from, Value* to);
+
+    /// @brief Replaces each result of `old_op` with the matching new value,
+    /// then erases `old_op`.
+    void ReplaceOp(Operation* old_op, const std::vector<Value*>& new_values);
+
+    /// @brief Erases an op whose results are no longer used. If it was the
+    /// insertion point, later ops are appended until a new one is set.
+    void EraseOp(Operation* op);
+
+    /// @brief Must be called after changing an op's operands or attributes
+    /// directly, so that it and its users are revisited.
+    void ModifiedOpInPlace(Operation* op);
+
+ protected:
+    virtual void NotifyOpInserted(Operation*) {}
+    virtual void NotifyOpModified(Operation*) {}
+    virtual void NotifyOpErased(Operation*) {}
+
+ private:
+    Block& block_;
+    Operation* ip_ = nullptr;
+};
+
+/// @brief A local rewrite rooted at ops with a single opcode.
+class RewritePattern {
+ public:
+    explicit RewritePattern(OpId root) : root_(root) {}
+    explicit RewritePattern(std::string_view root_mnemonic)
+        : root_(OpRegistry::Get().InternOp(root_mnemonic)) {}
+    virtual ~RewritePattern() = default;
+
+    OpId GetRootOp() const { return root_; }
+
+    /// @brief Analyzes the op and performs structural replacement if matched.
+    /// @return True if the graph was mutated; false if no change occurred.
+    virtual bool MatchAndRewrite(Operation* op, PatternRewriter& rewriter) const = 0;
+
+ private:
+    OpId root_;
+};
+
+/// @brief Owns a set of patterns, indexed by root opcode so that finding the
+/// candidates for an op is a single vector lookup.
+class RewritePatternSet {
+ public:
+    void Add(std::unique_ptr<RewritePattern> pattern);
+
+    template <typename T, typename... Args>
+    void Add(Args&&... args) {
+        Add(std::make_unique<T>(std::forward<Args>(args)...));
+    }
+
+    std::span<const RewritePattern* const> PatternsFor(OpId op_id) const {
+        if (op_id >= by_op_.size()) return {};
+        return by_op_[op_id];
+    }
+
+    bool empty() const { return owned_.empty(); }
+
+ private:
+    std::vector<std::unique_ptr<RewritePattern>> owned_;
+    std::vector<std::vector<const RewritePattern*>> by_op_;
+};
+
+struct GreedyRewriteConfig {
+    /// Upper bound on successful rewrites, as a multiple of the initial op
+    /// count. Guards against patterns that undo each other.
+    size_t max_rewrites_per_op = 10;
+};
+
+struct RewriteStats {
+    size_t rewrites = 0;  // Successful MatchAndRewrite calls.
+    size_t visits = 0;    // Ops popped from the worklist.
+    bool converged = true;
+    std::chrono::microseconds elapsed{0};
+};
+
+/// @brief Applies `patterns` until no pattern matches.
+///
+/// Every op is visited once in program order. After a successful rewrite,
+/// only ops whose operands or users changed are queued again: newly created
+/// ops, users of replaced values, producers of erased ops' operands, and ops
+/// reported via ModifiedOpInPlace. A local change therefore costs time
+/// proportional to its neighbourhood, not to the block.
+RewriteStats ApplyPatternsGreedily(Block& block,
+                                   const RewritePatternSet& patterns,
+                                   GreedyRewriteConfig config = {});
+
+}  // namespace seecpp::sir
+
+#endif  // SEECPP_SIR_REWRITE_DRIVER_H_
@@ -38,71 +38,138 @@ size_t Shape::byteSize(DataType dt) const {
 Value::Value(std::string id, DataType dt, Shape sh, Operation* def_op)
     : id_(std::move(id)), dtype_(dt), shape_(std::move(sh)), defining_op_(def_op) {}
 
+Value::~Value() {
+    while (first_use_) first_use_->drop();
+}
+
+size_t Value::numUses() const {
+    size_t n = 0;
+    for (const OpOperand* use = first_use_; use; use = use->nextUse()) ++n;
+    return n;
+}
+
 void Value::replaceAllUsesWith(Value* newVal) {
     assert(newVal && "replaceAllUsesWith called with null value");
     assert(newVal != this && "replaceAllUsesWith called with same value");
 
-    for (Operation* user : users_) {
-        for (size_t i = 0; i < user->numOperands(); ++i) {
-            if (user->operand(i) == this)
-                user->setOperand(i, newVal);
-        }
-    }
-    for (Operation* user : users_)
-        newVal->addUser(user);
-    users_.clear();
+    while (first_use_) first_use_->set(newVal);
 }
 
-void Value::addUser(Operation* op) { 
-    users_.push_back(op); 
+OpOperand::OpOperand(OpOperand&& other) noexcept
+    : value_(other.value_), owner_(other.owner_), next_use_(other.next_use_), prev_use_(other.prev_use_) {
+    if (prev_use_) *prev_use_ = this;
+    if (next_use_) next_use_->prev_use_ = &next_use_;
+    other.value_ = nullptr;
+    other.next_use_ = nullptr;
+    other.prev_use_ = nullptr;
 }
 
-void Value::removeUser(Operation* op) {
-    auto it = std::find(users_.begin(), users_.end(), op);
-    if (it != users_.end())
-        users_.erase(it);
+void OpOperand::set(Value* value) {
+    unlink();
+    value_ = value;
+    if (!value) return;
+
+    // Push front: O(1), and RAUW never revisits a use it has already moved.
+    next_use_ = value->first_use_;
+    if (next_use_) next_use_->prev_use_ = &next_use_;
+    prev_use_ = &value->first_use_;
+    value->first_use_ = this;
 }
 
 // =============================================================================
 // 3. Operation
 // =============================================================================
 
+const AttributeValue* AttributeList::find(AttrId key) const {
+    // Sorted and short: a forward scan that stops early beats a binary search.
+    for (const auto& [id, val] : entries()) {
+        if (id == key) return &val;
+        if (id > key) break;
+    }
+    return nullptr;
+}
+
+void AttributeList::set(AttrId key, AttributeValue val) {
+    auto by_id = [](const Entry& e, AttrId k) { return e.first < k; };
+
+    if (spilled_.empty()) {
+        Entry* begin = inline_.data();
+        Entry* end = begin + size_;
+        Entry* pos = std::lower_bound(begin, end, key, by_id);
+        if (pos != end && pos->first == key) {
+            pos->second = std::move(val);
+            return;
+        }
+        if (size_ < kInlineCapacity) {
+            std::move_backward(pos, end, end + 1);
+            *pos = Entry{key, std::move(val)};
+            ++size_;
+            return;
+        }
+        // Full: move everything to the heap and fall through to the spilled path.
+        spilled_.reserve(kInlineCapacity * 2);
+        for (auto& e : inline_) spilled_.push_back(std::move(e));
+        size_ = 0;
+    }
+
+    auto pos = std::lower_bound(spilled_.begin(), spilled_.end(), key, by_id);
+    if (pos != spilled_.end() && pos->first == key) {
+        pos->second = std::move(val);
+        return;
+    }
+    spilled_.insert(pos, Entry{key, std::move(val)});
+}
+
 std::atomic<size_t> Operation::id_counter_{0};
 
-Operation::Operation(std::string mnemonic, Block* parent)
-    : mnemonic_(std::move(mnemonic)), parent_block_(parent) {}
+OwnedOp Operation::create(OpId op_id, std::pmr::memory_resource* mr) {
+    return OwnedOp(std::pmr::polymorphic_allocator<>(mr).new_object<Operation>(op_id, mr));
+}
+
+Operation::Operation(OpId op_id, std::pmr::memory_resource* mr)
+    : op_id_(op_id),
+      info_(&OpRegistry::Get().GetOpInfo(op_id)),
+      operands_(mr),
+      results_(mr),
+      attributes_(mr) {}
+
+Operation::~Operation() {
+    std::pmr::polymorphic_allocator<> alloc(resource());
+    for (Value* v : results_) alloc.delete_object(v);
+}
+
+void OpDeleter::operator()(Operation* op) const {
+    // Read the resource before the op (and the vector that records it) is gone.
+    std::pmr::polymorphic_allocator<>(op->resource()).delete_object(op);
+}
 
 void Operation::addOperand(Value* v) {
     assert(v && "addOperand: null Value*");
-    operands_.push_back(v);
-    v->addUser(this);
+    operands_.emplace_back(this, v);
 }
 
 void Operation::setOperand(size_t i, Value* newVal) {
     assert(i < operands_.size() && "setOperand: index out of range");
     assert(newVal && "setOperand: null Value*");
 
-    operands_[i]->removeUser(this);
-    operands_[i] = newVal;
-    newVal->addUser(this);
+    operands_[i].set(newVal);
 }
 
 Value* Operation::addResult(std::string id, DataType dt, Shape sh) {
     if (id.empty())
         id = "%" + std::to_string(id_counter_.fetch_add(1, std::memory_order_relaxed));
 
-    auto val = std::make_unique<Value>(std::move(id), dt, std::move(sh), this);
-    results_.push_back(std::move(val));
-    return results_.back().get();
-}
-
-void Operation::setAttribute(std::string key, AttributeValue val) {
-    attributes_[std::move(key)] = std::move(val);
+    Value* val = std::pmr::polymorphic_allocator<>(resource())
+        .new_object<Value>(std::move(id), dt, std::move(sh), this);
+    results_.push_back(val);
+    if (parent_block_) ++parent_block_->num_results_;
+    return val;
 }
 
 const AttributeValue* Operation::getAttribute(std::string_view key) const {
-    if (auto it = attributes_.find(std::string(key)); it != attributes_.end())
-        return &it->second;
+    if (attributes_.empty()) return nullptr;
+    if (auto id = OpRegistry::Get().LookupAttr(key))
+        return attributes_.find(*id);
     return nullptr;
 }
 
@@ -125,17 +192,24 @@ void Operation::print(std::ostream& os) const {
         os << " = ";
     }
 
-    os << mnemonic_ << "(";
+    os << info_->name << "(";
     for (size_t i = 0; i < operands_.size(); ++i) {
         if (i) os << ", ";
-        os << operands_[i]->id();
+        os << operands_[i].get()->id();
     }
     os << ")";
 
     if (!attributes_.empty()) {
         os << " {";
         bool first = true;
-        for (const auto& [k, v] : attributes_) {
+        // Print in name order so dumps do not depend on interning order.
+        std::vector<std::pair<std::string_view, const AttributeValue*>> sorted;
+        sorted.reserve(attributes_.size());
+        for (const auto& [id, v] : attributes_.entries())
+            sorted.emplace_back(OpRegistry::Get().AttrName(id), &v);
+        std::sort(sorted.begin(), sorted.end());
+
+        for (const auto& [k, v] : sorted) {
             if (!first) os << ", ";
             first = false;
             os << k << " = ";
@@ -154,7 +228,7 @@ void Operation::print(std::ostream& os) const {
                 } else {
                     os << val;
                 }
-            }, v);
+            }, *v);
         }
         os << "}";
     }
@@ -172,61 +246,217 @@ std::string Operation::toString() const {
 
 Value* Block::addArgument(DataType dt, Shape sh) {
     std::string id = "%" + std::to_string(Operation::id_counter_.fetch_add(1, std::memory_order_relaxed));
-    auto val = std::make_unique<Value>(std::move(id), dt, std::move(sh), nullptr);
-    args_.push_back(std::move(val));
-    return args_.back().get();
+    Value* val = arena_->create<Value>(std::move(id), dt, std::move(sh), nullptr);
+    args_.push_back(val);
+    return val;
 }
 
-Operation* Block::appendOp(std::string name) {
-    auto op = std::make_unique<Operation>(std::move(name), this);
-    ops_.push_back(std::move(op));
-    return ops_.back().get();
+Block::~Block() {
+    // Run destructors for the heap payloads some attributes own; the arena
+    // itself is released in one shot afterwards.
+    for (Operation* op = head_; op;) {
+        Operation* next = op->next_;
+        OpDeleter{}(op);
+        op = next;
+    }
+    for (Value* arg : args_) std::destroy_at(arg);
 }
 
-Operation* Block::appendOp(std::unique_ptr<Operation> op) {
+Operation* Block::appendOp(std::string_view name) {
+    return appendOp(OpRegistry::Get().InternOp(name));
+}
+
+Operation* Block::appendOp(OpId op_id) {
+    return link(createOp(op_id), nullptr);
+}
+
+Operation* Block::appendOp(OwnedOp op) {
     assert(op && "appendOp: null operation");
+    return link(std::move(op), nullptr);
+}
+
+Operation* Block::insertOpBefore(OpId op_id, Operation* before) {
+    return insertOpBefore(createOp(op_id), before);
+}
+
+Operation* Block::insertOpBefore(std::string_view name, Operation* before) {
+    return insertOpBefore(OpRegistry::Get().InternOp(name), before);
+}
+
+Operation* Block::insertOpBefore(OwnedOp op, Operation* before) {
+    assert(before && before->parent_block_ == this && "insertOpBefore: anchor not found in block");
+    // An op moved from elsewhere keeps the source info it already carries.
+    for (const auto& [id, value] : before->attributes().entries()) {
+        if (attr::isSourceInfo(id) && !op->getAttribute(id)) op->setAttribute(id, value);
+    }
+    return link(std::move(op), before);
+}
+
+Operation* Block::link(OwnedOp owned, Operation* before) {
+    Operation* op = owned.release();
     op->setParentBlock(this);
-    ops_.push_back(std::move(op));
-    return ops_.back().get();
+    Operation* after = before ? before->prev_ : tail_;
+
+    op->prev_ = after;
+    op->next_ = before;
+    (after ? after->next_ : head_) = op;
+    (before ? before->prev_ : tail_) = op;
+    for (OpOperand& use : op->operands_) use.reattach();
+    ++num_ops_;
+    num_results_ += op->numResults();
+    is_validated_ = false;
+    if (!order_valid_) return op;  // Renumbered on the next query anyway.
+
+    // Take the midpoint of the neighbours' indices; appends step by a full
+    // stride. Only when two neighbours are adjacent do we relabel, and then
+    // only the ops around `op`.
+    const uint64_t lo = after ? after->order_ : 0;
+    if (!before) {
+        op->order_ = lo + kOrderStride;
+    } else if (before->order_ - lo > 1) {
+        op->order_ = lo + (before->order_ - lo) / 2;
+    } else {
+        relabelAround(op);
+    }
+    return op;
+}
+
+void Block::relabelAround(Operation* op) {
+    // List labeling (Bender et al., "Two Simplified Algorithms for Maintaining
+    // Order in a List"): grow an aligned label range of 2^bits around `op`
+    // until it holds few enough ops, i.e. fewer than 2^bits / kOrderDensity^bits,
+    // then spread them evenly across it. The density bound keeps each range
+    // from filling up again soon, so an insert costs O(log n) amortized.
+    constexpr double kOrderDensity = 1.5;
+    const uint64_t anchor = op->prev_ ? op->prev_->order_ : op->next_->order_;
+    op->order_ = anchor;
+    Operation* first = op;
+    Operation* last = op;
+    size_t count = 1;
+    double threshold = 1.0;
+    for (int bits = 1; bits < 64; ++bits) {
+        const uint64_t span = uint64_t{1} << bits;
+        const uint64_t base = anchor & ~(span - 1);
+        while (first->prev_ && first->prev_->order_ >= base) {
+            first = first->prev_;
+            ++count;
+        }
+        while (last->next_ && last->next_->order_ - base < span) {
+            last = last->next_;
+            ++count;
+        }
+        threshold *= kOrderDensity;
+        if (static_cast<double>(count) * threshold > static_cast<double>(span)) continue;
+
+        const uint64_t gap = span / (count + 1);
+        uint64_t order = base;
+        for (Operation* it = first;; it = it->next_) {
+            it->order_ = (order += gap);
+            if (it == last) return;
+        }
+    }
+    renumber();  // Only if the labels are exhausted: never with 64-bit labels.
+}
+
+void Block::renumber() const {
+    uint64_t order = 0;
+    for (Operation* op = head_; op; op = op->next_) op->order_ = (order += kOrderStride);
+    order_valid_ = true;
 }
 
-std::unique_ptr<Operation> Block::removeOp(Operation* op) {
-    auto it = std::find_if(ops_.begin(), ops_.end(), [op](const auto& p) { return p.get() == op; });
-    assert(it != ops_.end() && "removeOp: operation not found in block");
+void Block::spliceOps(Operation* before, Block& from, Operation* first, Operation* last) {
+    assert(&from != this && "spliceOps: source and destination must differ");
+    assert(first && first->parent_block_ == &from && last && last->parent_block_ == &from &&
+           "spliceOps: range not found in source block");
+    assert((!before || before->parent_block_ == this) && "spliceOps: anchor not found in block");
+
+    // Detach [first, last] from `from` and relink it in front of `before`.
+    (first->prev_ ? first->prev_->next_ : from.head_) = last->next_;
+    (last->next_ ? last->next_->prev_ : from.tail_) = first->prev_;
+    Operation* after = before ? before->prev_ : tail_;
+    first->prev_ = after;
+    last->next_ = before;
+    (after ? after->next_ : head_) = first;
+    (before ? before->prev_ : tail_) = last;
+
+    size_t count = 0;
+    size_t results = 0;
+    for (Operation* op = first; op != before; op = op->next_) {
+        op->parent_block_ = this;
+        ++count;
+        results += op->numResults();
+    }
+    from.num_ops_ -= count;
+    num_ops_ += count;
+    from.num_results_ -= results;
+    num_results_ += results;
+    from.is_validated_ = false;
+    is_validated_ = false;
+
+    // The range keeps its indices, which stay valid unless a seam inverts.
+    if (!from.order_valid_ || (after && after->order_ >= first->order_) ||
+        (before && last->order_ >= before->order_)) {
+        order_valid_ = false;
+    }
+}
 
-    for (size_t i = 0; i < op->numOperands(); ++i)
-        op->operand(i)->removeUser(op);
+OwnedOp Block::removeOp(Operation* op) {
+    assert(op && op->parent_block_ == this && "removeOp: operation not found in block");
 
-    auto owned = std::move(*it);
-    ops_.erase(it);
-    owned->setParentBlock(nullptr);
-    return owned;
+    (op->prev_ ? op->prev_->next_ : head_) = op->next_;
+    (op->next_ ? op->next_->prev_ : tail_) = op->prev_;
+    op->prev_ = op->next_ = nullptr;
+    for (OpOperand& use : op->operands_) use.detach();
+    --num_ops_;
+    num_results_ -= op->numResults();
+
+    op->setParentBlock(nullptr);
+    return OwnedOp(op);
+}
+
+bool Block::isBeforeInBlock(const Operation* a, const Operation* b) const {
+    assert(a->parent_block_ == this && b->parent_block_ == this);
+    if (!order_valid_) renumber();
+    return a->order_ < b->order_;
 }
 
 bool Block::validate() const {
     std::unordered_set<const Value*> defined;
-    for (const auto& arg : args_) defined.insert(arg.get());
+    for (const Value* arg : args_) defined.insert(arg);
 
-    for (const auto& op : ops_) {
+    for (const Operation* op = head_; op; op = op->next_) {
         for (const Value* operand : op->operands()) {
             if (defined.find(operand) == defined.end()) {
                 return false;
             }
         }
-        for (const auto& res : op->results())
-            defined.insert(res.get());
+        for (const Value* res : op->results())
+            defined.insert(res);
     }
+    assert(defined.size() == numValues() && "validate: stale value count");
 
     is_validated_ = true;
     return true;
 }
 
 void Block::walk(std::function<void(Operation*)> fn) {
-    for (auto& op : ops_) fn(op.get());
+    for (Operation* op = head_; op;) {
+        Operation* next = op->next_;
+        fn(op);
+        op = next;
+    }
+}
+
+void Block::walk(std::function<void(const Operation*)> fn) const {
+    for (const Operation* op = head_; op; op = op->next_) fn(op);
 }
 
 void Block::walkReverse(std::function<void(Operation*)> fn) {
-    for (auto it = ops_.rbegin(); it != ops_.rend(); ++it) fn(it->get());
+    for (Operation* op = tail_; op;) {
+        Operation* prev = op->prev_;
+        fn(op);
+        op = prev;
+    }
 }
 
 void Block::print(std::ostream& os) const {
@@ -238,7 +468,7 @@ void Block::print(std::ostream& os) const {
         }
         os << "):\n";
     }
-    for (const auto& op : ops_) {
+    for (const Operation* op = head_; op; op = op->next_) {
         os << "  ";
         op->print(os);
         os << "\n";
@@ -259,28 +489,28 @@ Block* Region::entryBlock() {
 // 5. OpBuilder
 // =============================================================================
 
-std::unique_ptr<Operation> OpBuilder::conv2d(
+OwnedOp OpBuilder::conv2d(
     Value* input, Value* filter, Value* bias,
     std::vector<int64_t> strides, std::vector<int64_t> pads,
     std::vector<int64_t> dilations, int64_t group) {
     assert(input  && "conv2d: null input");
     assert(filter && "conv2d: null filter");
 
-    auto op = std::make_unique<Operation>("sc_high.conv2d");
+    auto op = Operation::create(op::kConv2d);
     op->addOperand(input);
     op->addOperand(filter);
     if (bias) op->addOperand(bias);
 
-    op->setAttribute("strides",   std::move(strides));
-    op->setAttribute("pads",      std::move(pads));
-    op->setAttribute("dilations", std::move(dilations));
-    op->setAttribute("group",     group);
+    op->setAttribute(attr::kStrides,   std::move(strides));
+    op->setAttribute(attr::kPads,      std::move(pads));
+    op->setAttribute(attr::kDilations, std::move(dilations));
+    op->setAttribute(attr::kGroup,     group);
 
     op->addResult("", input->dtype(), Shape{});
     return op;
 }
 
-std::unique_ptr<Operation> OpBuilder::batchNorm(
+OwnedOp OpBuilder::batchNorm(
     Value* input, Value* scale, Value* bias,
     Value* running_mean, Value* running_var, float epsilon) {
     assert(input        && "batchNorm: null input");
@@ -289,51 +519,51 @@ std::unique_ptr<Operation> OpBuilder::batchNorm(
     assert(running_mean && "batchNorm: null running_mean");
     assert(running_var  && "batchNorm: null running_var");
 
-    auto op = std::make_unique<Operation>("sc_high.batch_norm");
+    auto op = Operation::create(op::kBatchNorm);
     op->addOperand(input);
     op->addOperand(scale);
     op->addOperand(bias);
     op->addOperand(running_mean);
     op->addOperand(running_var);
-    op->setAttribute("epsilon", epsilon);
+    op->setAttribute(attr::kEpsilon, epsilon);
 
     op->addResult("", input->dtype(), input->shape());
     return op;
 }
 
-std::unique_ptr<Operation> OpBuilder::gemm(
+OwnedOp OpBuilder::gemm(
     Value* A, Value* B, Value* bias, bool trans_a, bool trans_b) {
     assert(A && "gemm: null A");
     assert(B && "gemm: null B");
 
-    auto op = std::make_unique<Operation>("sc_high.gemm");
+    auto op = Operation::create(op::kGemm);
     op->addOperand(A);
     op->addOperand(B);
     if (bias) op->addOperand(bias);
 
-    op->setAttribute("trans_a", static_cast<int64_t>(trans_a));
-    op->setAttribute("trans_b", static_cast<int64_t>(trans_b));
+    op->setAttribute(attr::kTransA, static_cast<int64_t>(trans_a));
+    op->setAttribute(attr::kTransB, static_cast<int64_t>(trans_b));
     op->addResult("", A->dtype(), Shape{});
     return op;
 }
 
-std::unique_ptr<Operation> OpBuilder::relu(Value* input) {
+OwnedOp OpBuilder::relu(Value* input) {
     assert(input && "relu: null input");
-    auto op = std::make_unique<Operation>("sc_high.relu");
+    auto op = Operation::create(op::kRelu);
     op->addOperand(input);
     op->addResult("", input->dtype(), input->shape());
     return op;
 }
 
-std::unique_ptr<Operation> OpBuilder::im2col(
+OwnedOp OpBuilder::im2col(
     Value* input, std::vector<int64_t> kernel_shape,
     std::vector<int64_t> strides, std::vector<int64_t> pads) {
     assert(input && "im2col: null input");
-    auto op = std::make_unique<Operation>("sc_low.im2col");
+    auto op = Operation::create(op::kLowIm2Col);
     op->addOperand(input);
-    op->setAttribute("kernel_shape", std::move(kernel_shape));
-    op->setAttribute("strides",      std::move(strides));
-    op->setAttribute("pads",         std::move(pads));
+    op->setAttribute(attr::kKernelShape, std::move(kernel_shape));
+    op->setAttribute(attr::kStrides,      std::move(strides));
+    op->setAttribute(attr::kPads,         std::move(pads));
     op->addResult("", input->dtype(), Shape{});
     return op;
 }
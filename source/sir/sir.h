@@ -1,10 +1,16 @@
 #ifndef SEECPP_SIR_SIR_H_
 #define SEECPP_SIR_SIR_H_
 
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <string>
 #include <string_view>
 #include <memory>
+#include <memory_resource>
 #include <map>
 #include <variant>
 #include <optional>
@@ -14,28 +20,40 @@
 #include <atomic>
 #include <unordered_set>
 
+#include "seecpp/sir/arena.h"
+#include "seecpp/sir/op_registry.h"
+
 namespace seecpp::sir {
 
+class Value;
 class Operation;
 class Block;
 class Region;
+template <typename OpT> class OpIterator;
 
 enum class DataType : uint8_t {
     F16, BF16, F32, F64,
     I8, I32, I64,
-    Bool
+    Bool,
+    // Appended so the enumerators above keep their values.
+    I16, U8, U16, U32, U64
 };
 
 constexpr size_t dtypeByteWidth(DataType dt) {
     switch (dt) {
         case DataType::Bool:
-        case DataType::I8:   return 1;
+        case DataType::I8:
+        case DataType::U8:   return 1;
         case DataType::F16:
-        case DataType::BF16: return 2;
+        case DataType::BF16:
+        case DataType::I16:
+        case DataType::U16:  return 2;
         case DataType::F32:
-        case DataType::I32:  return 4;
+        case DataType::I32:
+        case DataType::U32:  return 4;
         case DataType::F64:
-        case DataType::I64:  return 8;
+        case DataType::I64:
+        case DataType::U64:  return 8;
         default: return 0;
     }
 }
@@ -47,8 +65,13 @@ constexpr std::string_view dtypeName(DataType dt) {
         case DataType::F32:  return "f32";
         case DataType::F64:  return "f64";
         case DataType::I8:   return "i8";
+        case DataType::I16:  return "i16";
         case DataType::I32:  return "i32";
         case DataType::I64:  return "i64";
+        case DataType::U8:   return "u8";
+        case DataType::U16:  return "u16";
+        case DataType::U32:  return "u32";
+        case DataType::U64:  return "u64";
         case DataType::Bool: return "bool";
         default: return "unknown";
     }
@@ -79,11 +102,137 @@ using AttributeValue = std::variant<
     std::vector<int64_t>, std::vector<float>
 >;
 
+/// @brief An op's attributes, sorted by AttrId.
+///
+/// Ops rarely carry more than a handful of attributes, so the first
+/// kInlineCapacity live inside the op itself and lookups are a short scan of
+/// one cache-resident array. Larger sets spill to the op's memory resource.
+class AttributeList {
+ public:
+    using Entry = std::pair<AttrId, AttributeValue>;
+    static constexpr size_t kInlineCapacity = 4;
+
+    explicit AttributeList(std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+        : spilled_(mr) {}
+
+    const AttributeValue* find(AttrId key) const;
+    void set(AttrId key, AttributeValue val);
+
+    std::span<const Entry> entries() const {
+        return spilled_.empty() ? std::span<const Entry>(inline_.data(), size_)
+                                : std::span<const Entry>(spilled_);
+    }
+    size_t size() const { return spilled_.empty() ? size_ : spilled_.size(); }
+    bool empty() const { return size() == 0; }
+
+ private:
+    std::array<Entry, kInlineCapacity> inline_{};
+    uint32_t size_ = 0;
+    std::pmr::vector<Entry> spilled_;
+};
+
+/// @brief One operand slot of an op, threaded onto its value's use-list.
+///
+/// Each use links itself into a doubly linked list headed by the value, so a
+/// use is added, removed or redirected in O(1) without searching. `prev_use_`
+/// points at whichever pointer currently points at this use (the value's head
+/// or the previous use's `next_use_`), which keeps unlinking branch-free.
+class OpOperand {
+ public:
+    OpOperand(Operation* owner, Value* value) : owner_(owner) { set(value); }
+    OpOperand(const OpOperand&) = delete;
+    OpOperand& operator=(const OpOperand&) = delete;
+    /// @brief Operand arrays may reallocate; the moved-to slot takes over the links.
+    OpOperand(OpOperand&& other) noexcept;
+    OpOperand& operator=(OpOperand&&) = delete;
+    ~OpOperand() { unlink(); }
+
+    Value* get() const { return value_; }
+    Operation* owner() const { return owner_; }
+    OpOperand* nextUse() const { return next_use_; }
+
+    /// @brief Moves this use onto `value`'s list (or detaches it if null).
+    void set(Value* value);
+    void drop() { set(nullptr); }
+
+ private:
+    friend class Block;  // removeOp/link take a detached op's uses off and back on.
+
+    /// @brief Leaves the use-list but keeps the value, for an op taken out of its block.
+    void detach() { unlink(); }
+    /// @brief Rejoins the value's use-list; a no-op if already on it.
+    void reattach() {
+        if (value_ && !prev_use_) set(value_);
+    }
+
+    void unlink() {
+        if (!prev_use_) return;
+        *prev_use_ = next_use_;
+        if (next_use_) next_use_->prev_use_ = prev_use_;
+        prev_use_ = nullptr;
+        next_use_ = nullptr;
+    }
+
+    Value* value_ = nullptr;
+    Operation* owner_;
+    OpOperand* next_use_ = nullptr;
+    OpOperand** prev_use_ = nullptr;
+};
+
+/// @brief Forward iterator over a value's use-list. `Deref` selects what it
+/// yields: the OpOperand itself, or the op that owns it.
+template <typename Deref>
+class ValueUseIterator {
+ public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::remove_reference_t<decltype(Deref{}(std::declval<OpOperand*>()))>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type*;
+    using reference = decltype(Deref{}(std::declval<OpOperand*>()));
+
+    ValueUseIterator() = default;
+    explicit ValueUseIterator(OpOperand* use) : use_(use) {}
+
+    reference operator*() const { return Deref{}(use_); }
+    ValueUseIterator& operator++() { use_ = use_->nextUse(); return *this; }
+    ValueUseIterator operator++(int) { auto tmp = *this; ++*this; return tmp; }
+    bool operator==(const ValueUseIterator& other) const { return use_ == other.use_; }
+
+ private:
+    OpOperand* use_ = nullptr;
+};
+
+struct DerefUse {
+    OpOperand& operator()(OpOperand* use) const { return *use; }
+};
+struct DerefUser {
+    Operation* operator()(OpOperand* use) const { return use->owner(); }
+};
+
+template <typename It>
+class IteratorRange {
+ public:
+    IteratorRange(It begin, It end) : begin_(begin), end_(end) {}
+    It begin() const { return begin_; }
+    It end() const { return end_; }
+    bool empty() const { return begin_ == end_; }
+
+ private:
+    It begin_;
+    It end_;
+};
+
+using UseRange = IteratorRange<ValueUseIterator<DerefUse>>;
+using UserRange = IteratorRange<ValueUseIterator<DerefUser>>;
+
 class Value {
  public:
     Value(std::string id, DataType dt, Shape sh, Operation* def_op);
     Value(const Value&) = delete;
     Value& operator=(const Value&) = delete;
+    /// Uses that outlive the value (e.g. a dead consumer erased after its
+    /// producer) are detached rather than left pointing at freed memory.
+    ~Value();
 
     std::string_view id() const { return id_; }
     DataType dtype() const { return dtype_; }
@@ -92,13 +241,16 @@ class Value {
     const Operation* definingOp() const { return defining_op_; }
 
     bool isBlockArgument() const { return defining_op_ == nullptr; }
-    std::span<Operation* const> users() const { return users_; }
-    bool hasOneUse() const { return users_.size() == 1; }
-    bool hasNoUses() const { return users_.empty(); }
-
+    /// Most recently added use first. An op appears once per operand slot.
+    UseRange uses() const { return {ValueUseIterator<DerefUse>(first_use_), {}}; }
+    UserRange users() const { return {ValueUseIterator<DerefUser>(first_use_), {}}; }
+    bool hasOneUse() const { return first_use_ && !first_use_->nextUse(); }
+    bool hasNoUses() const { return first_use_ == nullptr; }
+    /// @brief O(uses); prefer hasOneUse/hasNoUses for the common checks.
+    size_t numUses() const;
+
+    /// @brief Redirects every use to `newVal`. Linear in the number of uses.
     void replaceAllUsesWith(Value* newVal);
-    void addUser(Operation* op);
-    void removeUser(Operation* op);
     void setShape(Shape sh) { shape_ = std::move(sh); }
 
  private:
@@ -106,43 +258,103 @@ class Value {
     DataType dtype_;
     Shape shape_;
     Operation* defining_op_;
-    std::vector<Operation*> users_;
+    OpOperand* first_use_ = nullptr;
+
+    friend class OpOperand;
+};
+
+/// @brief Iterates an op's operand slots, yielding the Value* in each.
+class OperandIterator {
+ public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Value*;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value* const*;
+    using reference = Value*;
+
+    OperandIterator() = default;
+    explicit OperandIterator(const OpOperand* slot) : slot_(slot) {}
+
+    Value* operator*() const { return slot_->get(); }
+    OperandIterator& operator++() { ++slot_; return *this; }
+    OperandIterator operator++(int) { auto tmp = *this; ++slot_; return tmp; }
+    OperandIterator& operator--() { --slot_; return *this; }
+    OperandIterator operator--(int) { auto tmp = *this; --slot_; return tmp; }
+    bool operator==(const OperandIterator& other) const { return slot_ == other.slot_; }
+
+ private:
+    const OpOperand* slot_ = nullptr;
 };
 
+/// @brief Destroys an op and returns its memory to the resource it came from.
+struct OpDeleter {
+    void operator()(Operation* op) const;
+};
+
+/// @brief An op not (or no longer) linked into a block. Ops allocated from a
+/// block's arena must not outlive that block.
+using OwnedOp = std::unique_ptr<Operation, OpDeleter>;
+
 class Operation {
  public:
-    explicit Operation(std::string mnemonic, Block* parent = nullptr);
+    /// @brief Allocates a detached op from `mr`; Block::createOp uses the
+    /// block's arena. Ops are only ever owned through OwnedOp.
+    static OwnedOp create(OpId op_id, std::pmr::memory_resource* mr = std::pmr::get_default_resource());
+    static OwnedOp create(std::string_view mnemonic,
+                          std::pmr::memory_resource* mr = std::pmr::get_default_resource()) {
+        return create(OpRegistry::Get().InternOp(mnemonic), mr);
+    }
+
+    Operation(OpId op_id, std::pmr::memory_resource* mr);
     Operation(const Operation&) = delete;
+    ~Operation();
+
+    /// @brief The resource this op, its results and its arrays live in.
+    std::pmr::memory_resource* resource() const { return operands_.get_allocator().resource(); }
 
-    std::string_view mnemonic() const { return mnemonic_; }
+    std::string_view mnemonic() const { return info_->name; }
+    OpId opId() const { return op_id_; }
+    bool is(OpId id) const { return op_id_ == id; }
+    /// @brief Neighbours in the parent block's op list; null at either end.
+    Operation* prevInBlock() const { return prev_; }
+    Operation* nextInBlock() const { return next_; }
     Block* parentBlock() { return parent_block_; }
     const Block* parentBlock() const { return parent_block_; }
     void setParentBlock(Block* b) { parent_block_ = b; }
 
-    bool isHighLevel() const { return mnemonic_.starts_with("sc_high."); }
-    bool isLowLevel() const { return mnemonic_.starts_with("sc_low."); }
-    bool isMemoryOp() const { return mnemonic_.starts_with("sc_mem."); }
-    bool isControlFlow() const { return mnemonic_.starts_with("sc_ctrl."); }
+    bool isHighLevel() const { return info_->dialect == Dialect::kHigh; }
+    bool isLowLevel() const { return info_->dialect == Dialect::kLow; }
+    bool isMemoryOp() const { return info_->dialect == Dialect::kMemory; }
+    bool isControlFlow() const { return info_->dialect == Dialect::kControl; }
 
-    std::span<Value* const> operands() const { return operands_; }
-    Value* operand(size_t i) const { return operands_.at(i); }
+    IteratorRange<OperandIterator> operands() const {
+        return {OperandIterator(operands_.data()), OperandIterator(operands_.data() + operands_.size())};
+    }
+    std::span<OpOperand> opOperands() { return operands_; }
+    Value* operand(size_t i) const { return operands_.at(i).get(); }
     size_t numOperands() const { return operands_.size(); }
 
     void addOperand(Value* v);
     void setOperand(size_t i, Value* newVal);
 
-    std::span<const std::unique_ptr<Value>> results() const { return results_; }
-    Value* result(size_t i = 0) const { return results_.at(i).get(); }
+    std::span<Value* const> results() const { return results_; }
+    Value* result(size_t i = 0) const { return results_.at(i); }
     size_t numResults() const { return results_.size(); }
 
     Value* addResult(std::string id, DataType dt, Shape sh);
 
-    void setAttribute(std::string key, AttributeValue val);
+    void setAttribute(AttrId key, AttributeValue val) { attributes_.set(key, std::move(val)); }
+    void setAttribute(std::string_view key, AttributeValue val) {
+        setAttribute(OpRegistry::Get().InternAttr(key), std::move(val));
+    }
+    const AttributeValue* getAttribute(AttrId key) const { return attributes_.find(key); }
     const AttributeValue* getAttribute(std::string_view key) const;
+    bool hasAttribute(AttrId key) const { return getAttribute(key) != nullptr; }
     bool hasAttribute(std::string_view key) const { return getAttribute(key) != nullptr; }
+    const AttributeList& attributes() const { return attributes_; }
 
-    template <typename T>
-    std::optional<T> getAttrAs(std::string_view key) const {
+    template <typename T, typename Key>
+    std::optional<T> getAttrAs(Key key) const {
         if (auto* av = getAttribute(key))
             if (auto* v = std::get_if<T>(av))
                 return *v;
@@ -153,39 +365,170 @@ class Operation {
     std::string toString() const;
 
  private:
-    std::string mnemonic_;
-    std::vector<Value*> operands_;
-    std::vector<std::unique_ptr<Value>> results_;
-    std::map<std::string, AttributeValue, std::less<>> attributes_;
+    OpId op_id_;
+    const OpInfo* info_;  // Owned by the OpRegistry
+    std::pmr::vector<OpOperand> operands_;
+    std::pmr::vector<Value*> results_;
+    AttributeList attributes_;
     Block* parent_block_ = nullptr;
 
+    // Intrusive links owned by the parent block. `order_` increases along the
+    // list but is not dense; see Block::isBeforeInBlock.
+    Operation* prev_ = nullptr;
+    Operation* next_ = nullptr;
+    uint64_t order_ = 0;
+
     static std::atomic<size_t> id_counter_;
     friend class Block; 
+    template <typename> friend class OpIterator;
 };
 
+/// @brief Bidirectional iterator over a Block's intrusive op list.
+///
+/// Dereferences to the Operation* itself. Iterators stay valid across
+/// insertions anywhere in the block and across removal of any other op.
+template <typename OpT>
+class OpIterator {
+ public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = OpT*;
+    using difference_type = std::ptrdiff_t;
+    using pointer = OpT* const*;
+    using reference = OpT* const&;
+
+    OpIterator() = default;
+    OpIterator(OpT* op, OpT* tail) : op_(op), tail_(tail) {}
+
+    reference operator*() const { return op_; }
+    OpT* operator->() const { return op_; }
+
+    OpIterator& operator++() { op_ = op_->next_; return *this; }
+    OpIterator operator++(int) { auto tmp = *this; ++*this; return tmp; }
+    // Decrementing end() yields the tail, as with std::list.
+    OpIterator& operator--() { op_ = op_ ? op_->prev_ : tail_; return *this; }
+    OpIterator operator--(int) { auto tmp = *this; --*this; return tmp; }
+
+    bool operator==(const OpIterator& other) const { return op_ == other.op_; }
+
+ private:
+    OpT* op_ = nullptr;
+    OpT* tail_ = nullptr;
+};
+
+/// @brief Lightweight view of a Block's operations, usable in range-for.
+template <typename OpT>
+class OpRange {
+ public:
+    OpRange(OpT* head, OpT* tail, size_t size) : head_(head), tail_(tail), size_(size) {}
+
+    OpIterator<OpT> begin() const { return {head_, tail_}; }
+    OpIterator<OpT> end() const { return {nullptr, tail_}; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    OpT* front() const { return head_; }
+    OpT* back() const { return tail_; }
+
+ private:
+    OpT* head_;
+    OpT* tail_;
+    size_t size_;
+};
+
+/// @brief A straight-line sequence of operations.
+///
+/// Ops are kept in an intrusive doubly linked list, so insertion and removal
+/// never invalidate pointers or iterators to other ops. Each op also carries
+/// a sparse order label, which answers "does A come before B" in O(1) for
+/// dominance-style queries within the block. An insert takes the midpoint of
+/// its neighbours' labels; when they are adjacent, the smallest sparse enough
+/// label range around it is relabeled, so inserts are O(log n) amortized even
+/// when they all land in front of the same op. Removal is O(1). A splice whose
+/// range does not fit between its new neighbours' labels leaves a single O(n)
+/// renumbering to the next order query.
 class Block {
  public:
-    Block() = default;
+    Block() : owned_arena_(std::make_unique<Arena>()), arena_(owned_arena_.get()) {}
+    /// @brief A block that allocates from `arena`, which must outlive it and
+    /// everything created in it. Used to stage ops that are later spliced
+    /// back into the block owning the arena.
+    explicit Block(Arena& arena) : arena_(&arena) {}
     Block(const Block&) = delete;
+    Block& operator=(const Block&) = delete;
+    ~Block();
 
     Value* addArgument(DataType dt, Shape sh);
-    std::span<const std::unique_ptr<Value>> arguments() const { return args_; }
-    std::span<const std::unique_ptr<Operation>> operations() const { return ops_; }
-    size_t numOps() const { return ops_.size(); }
-
-    Operation* appendOp(std::string name);
-    Operation* appendOp(std::unique_ptr<Operation> op);
-    std::unique_ptr<Operation> removeOp(Operation* op);
+    std::span<Value* const> arguments() const { return args_; }
+    OpRange<Operation> operations() { return {head_, tail_, num_ops_}; }
+    OpRange<const Operation> operations() const { return {head_, tail_, num_ops_}; }
+    size_t numOps() const { return num_ops_; }
+    /// @brief Arguments plus the results of every op in the block, in O(1).
+    size_t numValues() const { return args_.size() + num_results_; }
+    bool empty() const { return num_ops_ == 0; }
+    Operation* front() const { return head_; }
+    Operation* back() const { return tail_; }
+
+    /// @brief Allocates a detached op in this block's arena, for callers that
+    /// populate an op before deciding to link it.
+    OwnedOp createOp(OpId op_id) { return Operation::create(op_id, arena_); }
+    OwnedOp createOp(std::string_view name) { return Operation::create(name, arena_); }
+
+    Operation* appendOp(std::string_view name);
+    Operation* appendOp(OpId op_id);
+    Operation* appendOp(OwnedOp op);
+    /// @brief Creates or links an op in front of `before`. It inherits
+    /// whichever source info attributes of the anchor it lacks: rewrites
+    /// insert an op's replacement in front of it.
+    Operation* insertOpBefore(OpId op_id, Operation* before);
+    Operation* insertOpBefore(std::string_view name, Operation* before);
+    Operation* insertOpBefore(OwnedOp op, Operation* before);
+    /// @brief Unlinks `op` and hands ownership back to the caller. The op
+    /// keeps its operands but leaves their use-lists, so it no longer counts
+    /// as a user; linking it into a block again puts it back on them. Its
+    /// operands' producers must outlive it until then.
+    OwnedOp removeOp(Operation* op);
+    /// @brief Moves the ops `first` through `last` of `from` in front of
+    /// `before` (or to the end if null). The range is relinked in O(1); only
+    /// each op's parent pointer is rewritten.
+    void spliceOps(Operation* before, Block& from, Operation* first, Operation* last);
+
+    Arena& arena() { return *arena_; }
+    const Arena& arena() const { return *arena_; }
+
+    /// @brief True if `a` precedes `b`. Both must belong to this block.
+    bool isBeforeInBlock(const Operation* a, const Operation* b) const;
 
     bool validate() const;
+    /// Both walks fetch the next op before invoking `fn`, so `fn` may remove
+    /// the op it is given (but not its neighbour in the walk direction).
     void walk(std::function<void(Operation*)> fn);
+    void walk(std::function<void(const Operation*)> fn) const;
     void walkReverse(std::function<void(Operation*)> fn);
     void print(std::ostream& os) const;
 
  private:
-    std::vector<std::unique_ptr<Value>> args_;
-    std::vector<std::unique_ptr<Operation>> ops_;
+    friend class Operation;  // addResult() bumps num_results_.
+
+    static constexpr uint64_t kOrderStride = 1ull << 16;
+
+    /// @brief Links an owned op in front of `before` (or at the end if null).
+    Operation* link(OwnedOp op, Operation* before);
+    /// @brief Labels `op`, whose neighbours have adjacent labels, by spreading
+    /// the labels of a window of ops around it.
+    void relabelAround(Operation* op);
+    void renumber() const;
+
+    // Declared first so it is destroyed last, after everything allocated in it.
+    std::unique_ptr<Arena> owned_arena_;
+    Arena* arena_;
+    std::pmr::vector<Value*> args_{arena_};
+    Operation* head_ = nullptr;
+    Operation* tail_ = nullptr;
+    size_t num_ops_ = 0;
+    size_t num_results_ = 0;  // Kept up to date by link/removeOp/splice/addResult.
     mutable bool is_validated_ = false;
+    // Cleared by splices that leave indices out of order; the next order
+    // query renumbers the block.
+    mutable bool order_valid_ = true;
 };
 
 class Region {
@@ -199,7 +542,7 @@ class Region {
 };
 
 struct OpBuilder {
-    static std::unique_ptr<Operation> conv2d(
+    static OwnedOp conv2d(
         Value* input, Value* filter, Value* bias,
         std::vector<int64_t> strides,
         std::vector<int64_t> pads = {0, 0, 0, 0},
@@ -207,20 +550,20 @@ struct OpBuilder {
         int64_t group = 1
     );
 
-    static std::unique_ptr<Operation> batchNorm(
+    static OwnedOp batchNorm(
         Value* input, Value* scale, Value* bias,
         Value* running_mean, Value* running_var,
         float epsilon = 1e-5f
     );
 
-    static std::unique_ptr<Operation> gemm(
+    static OwnedOp gemm(
         Value* A, Value* B, Value* bias = nullptr,
         bool trans_a = false, bool trans_b = false
     );
 
-    static std::unique_ptr<Operation> relu(Value* input);
+    static OwnedOp relu(Value* input);
 
-    static std::unique_ptr<Operation> im2col(
+    static OwnedOp im2col(
         Value* input,
         std::vector<int64_t> kernel_shape,
         std::vector<int64_t> strides,
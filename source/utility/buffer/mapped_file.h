@@ -0,0 +1,77 @@
+#ifndef SEECPP_UTILITY_MAPPED_FILE_H_
+#define SEECPP_UTILITY_MAPPED_FILE_H_
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string>
+
+// POSIX Memory Mapping
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace seecpp::utility {
+
+/// @brief A read-only, private memory mapping of an entire file.
+///
+/// Shared through std::shared_ptr so that every WeightBuffer entry borrowing a
+/// span of the file keeps the mapping alive; the file is unmapped when the last
+/// borrower goes away.
+class MappedFile {
+ public:
+    ~MappedFile() {
+        if (data_ != nullptr) munmap(const_cast<uint8_t*>(data_), size_);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// @brief Maps `path` read-only. Returns a human-readable error on failure.
+    static std::expected<std::shared_ptr<const MappedFile>, std::string> Open(
+        const std::string& path) {
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1) {
+            return std::unexpected("Could not open '" + path + "': " + std::strerror(errno));
+        }
+
+        struct stat sb;
+        if (fstat(fd, &sb) == -1) {
+            const int err = errno;
+            close(fd);
+            return std::unexpected("Could not stat '" + path + "': " + std::strerror(err));
+        }
+
+        const auto size = static_cast<size_t>(sb.st_size);
+        void* ptr = nullptr;
+        if (size > 0) {
+            ptr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        const int err = errno;
+        // The mapping holds its own reference to the file; the descriptor can go.
+        close(fd);
+        if (ptr == MAP_FAILED) {
+            return std::unexpected("Could not mmap '" + path + "': " + std::strerror(err));
+        }
+
+        return std::shared_ptr<const MappedFile>(
+            new MappedFile(static_cast<const uint8_t*>(ptr), size));
+    }
+
+    std::span<const uint8_t> bytes() const { return {data_, size_}; }
+    size_t size() const { return size_; }
+
+ private:
+    MappedFile(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    const uint8_t* data_;
+    size_t size_;
+};
+
+}  // namespace seecpp::utility
+
+#endif  // SEECPP_UTILITY_MAPPED_FILE_H_
@@ -1,6 +1,10 @@
 #ifndef SEECPP_UTILITY_WEIGHT_BUFFER_H_
 #define SEECPP_UTILITY_WEIGHT_BUFFER_H_
 
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <memory>
@@ -16,7 +20,9 @@ namespace seecpp::utility {
 // Google Style: Enumerators use 'k' prefix for constants.
 enum class BufferDtype : uint8_t {
     kF16, kBF16, kF32, kF64,
-    kI8,  kI32,  kI64,
+    kI8,  kI16,  kI32,  kI64,
+    kU8,  kU16,  kU32,  kU64,
+    kBool,
     kUnknown
 };
 
@@ -28,10 +34,13 @@ struct WeightDescriptor {
     size_t TotalBytes() const { return num_elements * byte_width; }
 };
 
-/// @brief Owns binary weight blobs, providing stable pointers via heap allocation.
+/// @brief Owns or borrows binary weight blobs, providing stable pointers.
 /// 
-/// The WeightBuffer guarantees pointer stability: blobs are stored in 
+/// The WeightBuffer guarantees pointer stability: owned blobs are stored in 
 /// individual unique_ptrs, so map rehashes never invalidate existing data pointers.
+/// Borrowed blobs point into storage that the entry pins through a shared 
+/// keep-alive handle (an mmap()ed file, or the parsed protobuf), so weights can 
+/// flow from disk to the .see writer without an intermediate copy.
 class WeightBuffer {
  public:
     WeightBuffer() = default;
@@ -52,7 +61,7 @@ class WeightBuffer {
 
         if (auto it = storage_.find(key); it != storage_.end()) {
             return std::span<const T>(
-                reinterpret_cast<const T*>(it->second.blob.get()),
+                reinterpret_cast<const T*>(it->second.data),
                 it->second.desc.num_elements);
         }
 
@@ -63,18 +72,74 @@ class WeightBuffer {
         WeightDescriptor desc{data.size(), sizeof(T), dtype};
         const T* ptr = reinterpret_cast<const T*>(blob.get());
         
-        storage_.emplace(key, Entry{std::move(blob), desc});
+        // Braced initializers evaluate left to right: data is read before the move.
+        storage_.emplace(key, Entry{blob.get(), std::move(blob), nullptr, desc});
         return std::span<const T>(ptr, data.size());
     }
 
+    /// @brief Reserves an owned, uninitialized slot and returns it for writing.
+    /// Lets callers create every slot up front and then fill them concurrently, 
+    /// since filling a returned span never touches the map.
+    /// Returns an empty span if 'name' already exists; no silent overwrites.
+    std::span<uint8_t> Allocate(std::string_view name,
+                                size_t num_elements,
+                                size_t byte_width,
+                                BufferDtype dtype) {
+        const std::string key(name);
+        if (storage_.contains(key)) return {};
+
+        const size_t bytes = num_elements * byte_width;
+        auto blob = std::make_unique_for_overwrite<uint8_t[]>(bytes);
+        uint8_t* ptr = blob.get();
+
+        WeightDescriptor desc{num_elements, byte_width, dtype};
+        storage_.emplace(key, Entry{ptr, std::move(blob), nullptr, desc});
+        return std::span<uint8_t>(ptr, bytes);
+    }
+
+    /// @brief Registers a blob without copying it. The bytes must stay valid for 
+    /// as long as `keep_alive` is held; the entry holds it until removed.
+    /// Bytes not aligned to their element width (raw_data inside a protobuf, an
+    /// odd external-data offset) are copied instead, so Get<T>() stays valid.
+    /// If 'name' exists, returns the existing bytes; no silent overwrites.
+    std::span<const uint8_t> AddBorrowed(std::string_view name,
+                                         std::span<const uint8_t> bytes,
+                                         size_t byte_width,
+                                         BufferDtype dtype,
+                                         std::shared_ptr<const void> keep_alive) {
+        const std::string key(name);
+
+        if (auto it = storage_.find(key); it != storage_.end()) {
+            return std::span<const uint8_t>(it->second.data, it->second.desc.TotalBytes());
+        }
+
+        WeightDescriptor desc{byte_width ? bytes.size() / byte_width : 0, byte_width, dtype};
+        if (!IsAligned(bytes.data(), byte_width)) {
+            auto blob = std::make_unique_for_overwrite<uint8_t[]>(bytes.size());
+            std::memcpy(blob.get(), bytes.data(), bytes.size());
+            uint8_t* ptr = blob.get();
+            storage_.emplace(key, Entry{ptr, std::move(blob), nullptr, desc});
+            return std::span<const uint8_t>(ptr, bytes.size());
+        }
+        storage_.emplace(key, Entry{bytes.data(), nullptr, std::move(keep_alive), desc});
+        return bytes;
+    }
+
+    /// @brief True if the entry borrows its bytes rather than owning a copy.
+    bool IsBorrowed(std::string_view name) const {
+        auto it = storage_.find(std::string(name));
+        return it != storage_.end() && it->second.blob == nullptr;
+    }
+
     /// @brief Typed retrieval. Returns std::nullopt if the name is not present.
     template <typename T>
     std::optional<std::span<const T>> Get(std::string_view name) const {
         auto it = storage_.find(std::string(name));
         if (it == storage_.end()) return std::nullopt;
         
+        assert(IsAligned(it->second.data, alignof(T)));
         return std::span<const T>(
-            reinterpret_cast<const T*>(it->second.blob.get()),
+            reinterpret_cast<const T*>(it->second.data),
             it->second.desc.num_elements);
     }
 
@@ -84,7 +149,7 @@ class WeightBuffer {
         if (it == storage_.end()) return std::nullopt;
         
         const auto& e = it->second;
-        return std::span<const uint8_t>(e.blob.get(), e.desc.TotalBytes());
+        return std::span<const uint8_t>(e.data, e.desc.TotalBytes());
     }
 
     bool Contains(std::string_view name) const {
@@ -96,8 +161,16 @@ class WeightBuffer {
     void Remove(std::string_view name) { storage_.erase(std::string(name)); }
 
  private:
+    // Elements are naturally aligned; nothing needs more than max_align_t.
+    static bool IsAligned(const void* p, size_t width) {
+        const size_t alignment = std::min(std::bit_floor(width ? width : 1), alignof(std::max_align_t));
+        return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+    }
+
     struct Entry {
-        std::unique_ptr<uint8_t[]> blob;
+        const uint8_t* data;                  // Points into `blob` or borrowed storage
+        std::unique_ptr<uint8_t[]> blob;      // Set for owned entries
+        std::shared_ptr<const void> pinned;   // Set for borrowed entries
         WeightDescriptor desc;
     };
 
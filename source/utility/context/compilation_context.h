@@ -0,0 +1,84 @@
+#ifndef SEECPP_UTILITY_COMPILATION_CONTEXT_H_
+#define SEECPP_UTILITY_COMPILATION_CONTEXT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <utility>
+
+#include "seecpp/utility/diagnostics_engine.h"
+#include "seecpp/utility/time_report.h"
+#include "seecpp/utility/weight_buffer.h"
+
+namespace seecpp::utility {
+
+/// @brief Knobs shared by every stage of one compilation.
+struct CompilationOptions {
+    bool verbose = false;
+    /// @brief Threads used for data-parallel work inside this compilation
+    /// (initializer decoding, partition-local passes). Zero selects the hardware concurrency; services
+    /// running many compiles side by side should set this to 1.
+    size_t num_threads = 0;
+
+    // Middle-end
+    bool verify_each = false;
+    bool print_ir_after_all = false;
+
+    // Backend (see backend::CodegenOptions)
+    size_t large_weight_threshold = 0;
+    size_t large_weight_alignment = 4096;
+    std::filesystem::path cache_dir;
+    uint64_t cache_max_bytes = uint64_t{4} << 30;
+
+    // Profiling (see TimeReport). Setting either path enables the report.
+    std::filesystem::path time_report_path;  ///< -ftime-report style JSON.
+    std::filesystem::path time_trace_path;   ///< Chrome trace of the same phases.
+};
+
+/// @brief Owns all mutable state of a single model compilation.
+///
+/// Every stage (ProtobufReader, PassManager, CodegenDriver) reads its weights,
+/// options and diagnostics from the context it is handed instead of from
+/// process globals, so independent compilations can run concurrently in one
+/// process. A context is not itself thread-safe: one compilation, one context.
+class CompilationContext {
+ public:
+    explicit CompilationContext(CompilationOptions options = {})
+        : options_(std::move(options)),
+          time_report_(!options_.time_report_path.empty() || !options_.time_trace_path.empty()) {}
+
+    CompilationContext(const CompilationContext&) = delete;
+    CompilationContext& operator=(const CompilationContext&) = delete;
+
+    const CompilationOptions& options() const { return options_; }
+
+    WeightBuffer& weights() { return weights_; }
+    const WeightBuffer& weights() const { return weights_; }
+
+    TimeReport& time_report() { return time_report_; }
+    const TimeReport& time_report() const { return time_report_; }
+
+    /// @brief Writes the time report to the paths in the options, if any. Called
+    /// by whichever stage finishes the compilation.
+    void WriteTimeReport() {
+        if (!time_report_.enabled()) return;
+        if (auto res = time_report_.Write(options_.time_report_path, options_.time_trace_path); !res) {
+            diagnostics_.Report(DiagnosticSeverity::kWarning, "time_report", res.error());
+        }
+    }
+
+    /// @brief Where every stage reports errors, warnings and notes.
+    DiagnosticsEngine& diagnostics() { return diagnostics_; }
+    const DiagnosticsEngine& diagnostics() const { return diagnostics_; }
+
+ private:
+    CompilationOptions options_;
+    WeightBuffer weights_;
+    TimeReport time_report_;
+    DiagnosticsEngine diagnostics_;
+};
+
+}  // namespace seecpp::utility
+
+#endif  // SEECPP_UTILITY_COMPILATION_CONTEXT_H_
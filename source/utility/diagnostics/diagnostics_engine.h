@@ -0,0 +1,83 @@
+#ifndef SEECPP_UTILITY_DIAGNOSTICS_ENGINE_H_
+#define SEECPP_UTILITY_DIAGNOSTICS_ENGINE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace seecpp::utility {
+
+/// @brief Represents the severity of a compiler diagnostic message.
+enum class DiagnosticSeverity : uint8_t {
+    kNote,
+    kWarning,
+    kError,
+    kFatal  // Printed, then the process exits.
+};
+
+/// @brief Pinpoints the exact location and size of a token in the source code.
+struct SourceLocation {
+    std::string file_path;
+    size_t line = 0;
+    size_t column = 0;
+    size_t length = 1;  // Controls the length of the '~~~' squiggles
+};
+
+/// @brief One reported message, kept so callers can inspect how a
+/// compilation went after the fact.
+struct Diagnostic {
+    DiagnosticSeverity severity;
+    std::string phase;        // Stage that reported it, e.g. "ingest"; may be empty.
+    SourceLocation location;  // Empty file_path when there is no source position.
+    std::string message;
+};
+
+/// @brief A Clang-style terminal diagnostics printer. Handles ANSI coloring,
+/// source line retrieval, and caret/squiggle formatting for precise errors.
+///
+/// Every message is also recorded. Each compilation owns one engine through
+/// its CompilationContext, so it is not thread-safe.
+class DiagnosticsEngine {
+ public:
+    DiagnosticsEngine() = default;
+    ~DiagnosticsEngine() = default;
+
+    DiagnosticsEngine(const DiagnosticsEngine&) = delete;
+    DiagnosticsEngine& operator=(const DiagnosticsEngine&) = delete;
+
+    /// @brief Reports a message to the terminal with rich source context.
+    void Report(DiagnosticSeverity severity, const SourceLocation& loc,
+                std::string_view message);
+
+    /// @brief Reports a message that has no source position, tagged with the
+    /// pipeline stage that raised it.
+    void Report(DiagnosticSeverity severity, std::string_view phase,
+                std::string_view message);
+
+    /// @brief Everything reported so far, in order.
+    std::span<const Diagnostic> diagnostics() const { return diagnostics_; }
+
+    /// @brief Returns the total number of errors and fatal errors reported.
+    [[nodiscard]] size_t GetErrorCount() const { return error_count_; }
+
+ private:
+    size_t error_count_ = 0;
+    std::vector<Diagnostic> diagnostics_;
+
+    void Record(DiagnosticSeverity severity, std::string_view phase,
+                const SourceLocation& loc, std::string_view message);
+
+    /// @brief Fetches a specific line of text directly from the source file.
+    std::string GetSourceLine(const std::string& file_path, size_t line) const;
+
+    /// @brief Prints the Clang-style source context block (line numbers, carets).
+    void PrintSourceContext(const SourceLocation& loc,
+                            const std::string& source_line) const;
+};
+
+}  // namespace seecpp::utility
+
+#endif  // SEECPP_UTILITY_DIAGNOSTICS_ENGINE_H_
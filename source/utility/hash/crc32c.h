@@ -0,0 +1,51 @@
+#ifndef SEECPP_UTILITY_CRC32C_H_
+#define SEECPP_UTILITY_CRC32C_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace seecpp::utility {
+
+class ThreadPool;
+
+/// @brief CRC-32C (Castagnoli), the checksum of iSCSI and ext4 and the one
+/// computed by SSE4.2's crc32 and ARMv8's crc32c* instructions.
+///
+/// `crc` continues an earlier result, so
+/// Crc32c(b, Crc32c(a)) == Crc32c(a followed by b). Uses the CPU's CRC
+/// instructions when present, with three independent streams in flight to
+/// hide their latency, and a slicing-by-8 table otherwise.
+uint32_t Crc32c(std::span<const uint8_t> bytes, uint32_t crc = 0);
+
+/// @brief True if Crc32c() runs on SSE4.2 or ARMv8 CRC instructions.
+bool Crc32cIsHardwareAccelerated();
+
+/// @brief The CRC of a followed by b, from the CRCs of a and b and the length
+/// of b, in O(log len_b) without touching the data.
+uint32_t Crc32cCombine(uint32_t crc_a, uint32_t crc_b, uint64_t len_b);
+
+/// @brief Continues `crc` over `count` zero bytes in O(log count).
+uint32_t Crc32cExtendZeros(uint32_t crc, uint64_t count);
+
+/// @brief A run of data in a sparse buffer: the bytes between extents are
+/// zeros that are never materialized, like the padding in a .see file.
+struct Crc32cExtent {
+    uint64_t offset;
+    std::span<const uint8_t> bytes;
+};
+
+/// @brief The CRC of a `size`-byte buffer that holds `extents` (sorted, non-
+/// overlapping) and zeros elsewhere. Extents are cut into chunks of at most
+/// `chunk_size` bytes that are checksummed in parallel on `pool` and then
+/// combined in order; a null pool runs them on the calling thread.
+uint32_t Crc32cSparse(std::span<const Crc32cExtent> extents, uint64_t size,
+                      ThreadPool* pool, size_t chunk_size = size_t{2} << 20);
+
+/// @brief Crc32c() of a contiguous buffer, chunked over `pool` like Crc32cSparse().
+uint32_t Crc32cParallel(std::span<const uint8_t> bytes, ThreadPool* pool,
+                        size_t chunk_size = size_t{2} << 20);
+
+}  // namespace seecpp::utility
+
+#endif  // SEECPP_UTILITY_CRC32C_H_
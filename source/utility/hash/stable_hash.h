@@ -0,0 +1,81 @@
+#ifndef SEECPP_UTILITY_STABLE_HASH_H_
+#define SEECPP_UTILITY_STABLE_HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+namespace seecpp::utility {
+
+/// @brief A streaming 64-bit hash whose output is identical across processes
+/// and builds on hosts of the same endianness, unlike std::hash.
+///
+/// Each Update() folds one MurmurHash64A digest of its input into the running
+/// state, so the result depends on how the input was split into Update()
+/// calls. Callers feed structured data field by field, which is what keeps
+/// ("ab", "c") distinct from ("a", "bc").
+class StableHasher {
+ public:
+    explicit StableHasher(uint64_t seed = 0x5EEC0DE5EEC0DEULL) : state_(seed) {}
+
+    void Update(std::span<const uint8_t> bytes) {
+        state_ = Murmur64A(bytes.data(), bytes.size(), state_);
+    }
+
+    void Update(std::string_view s) {
+        Update(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(s.data()), s.size()));
+    }
+
+    template <typename T>
+        requires std::is_arithmetic_v<T> || std::is_enum_v<T>
+    void Update(T value) {
+        uint8_t bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        Update(std::span<const uint8_t>(bytes, sizeof(T)));
+    }
+
+    uint64_t Digest() const { return state_; }
+
+ private:
+    static uint64_t Murmur64A(const uint8_t* data, size_t len, uint64_t seed) {
+        constexpr uint64_t m = 0xc6a4a7935bd1e995ULL;
+        constexpr int r = 47;
+        uint64_t h = seed ^ (len * m);
+
+        const uint8_t* end = data + (len & ~size_t{7});
+        for (; data != end; data += 8) {
+            uint64_t k;
+            std::memcpy(&k, data, 8);
+            k *= m;
+            k ^= k >> r;
+            k *= m;
+            h ^= k;
+            h *= m;
+        }
+
+        switch (len & 7) {
+            case 7: h ^= uint64_t(data[6]) << 48; [[fallthrough]];
+            case 6: h ^= uint64_t(data[5]) << 40; [[fallthrough]];
+            case 5: h ^= uint64_t(data[4]) << 32; [[fallthrough]];
+            case 4: h ^= uint64_t(data[3]) << 24; [[fallthrough]];
+            case 3: h ^= uint64_t(data[2]) << 16; [[fallthrough]];
+            case 2: h ^= uint64_t(data[1]) << 8;  [[fallthrough]];
+            case 1: h ^= uint64_t(data[0]);
+                    h *= m;
+        }
+
+        h ^= h >> r;
+        h *= m;
+        h ^= h >> r;
+        return h;
+    }
+
+    uint64_t state_;
+};
+
+}  // namespace seecpp::utility
+
+#endif  // SEECPP_UTILITY_STABLE_HASH_H_
@@ -0,0 +1,17 @@
+#ifndef SEECPP_UTILITY_JSON_WRITER_H_
+#define SEECPP_UTILITY_JSON_WRITER_H_
+
+#include <string>
+#include <string_view>
+
+namespace seecpp::utility {
+
+/// @brief Appends `s` to `out` as a quoted JSON string. Escapes quotes,
+/// backslashes, \n and \t by name and any other control character as \uXXXX;
+/// everything else, UTF-8 included, is copied as is. Shared by the reports
+/// that hand-write JSON (time reports, instruction traces).
+void AppendJsonString(std::string& out, std::string_view s);
+
+}  // namespace seecpp::utility
+
+#endif  // SEECPP_UTILITY_JSON_WRITER_H_
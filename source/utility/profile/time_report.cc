@@ -0,0 +1,178 @@
+#include "include/utility/time_report.h"
+#include "include/utility/json_writer.h"
+
+#include <algorithm>
+#include <ctime>
+#include <format>
+#include <fstream>
+
+#include "seecpp/sir/sir.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace seecpp::utility {
+
+namespace {
+
+std::chrono::microseconds ProcessCpuTime() {
+#if defined(CLOCK_PROCESS_CPUTIME_ID)
+    timespec ts{};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return std::chrono::seconds(ts.tv_sec) +
+           std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::nanoseconds(ts.tv_nsec));
+#else
+    return std::chrono::microseconds(static_cast<int64_t>(
+        static_cast<double>(std::clock()) * 1e6 / CLOCKS_PER_SEC));
+#endif
+}
+
+int64_t PeakRssKb() {
+#if defined(__APPLE__)
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<int64_t>(usage.ru_maxrss) / 1024;  // Bytes on macOS.
+#elif defined(__unix__)
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<int64_t>(usage.ru_maxrss);
+#else
+    return 0;
+#endif
+}
+
+void AppendCounts(std::string& out, std::string_view key, const std::optional<IrCounts>& counts) {
+    out += std::format("\"{}\": ", key);
+    if (!counts) {
+        out += "null";
+    } else {
+        out += std::format("{{\"ops\": {}, \"values\": {}}}", counts->ops, counts->values);
+    }
+}
+
+std::expected<void, std::string> WriteFile(const std::filesystem::path& path, const std::string& text) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return std::unexpected("Could not open '" + path.string() + "' for writing");
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    if (!out) return std::unexpected("Failed to write '" + path.string() + "'");
+    return {};
+}
+
+}  // namespace
+
+TimeReport::TimeReport(bool enabled)
+    : enabled_(enabled), origin_(std::chrono::steady_clock::now()) {}
+
+IrCounts TimeReport::Count(const sir::Block& block) {
+    return {block.numOps(), block.numValues()};
+}
+
+TimeReport::Scope::Scope(TimeReport* report, std::string_view name, std::string_view category,
+                         const sir::Block* block) {
+    if (report == nullptr || !report->enabled_) return;
+    report_ = report;
+    block_ = block;
+
+    PhaseRecord record;
+    record.name = std::string(name);
+    record.category = std::string(category);
+    record.depth = report_->depth_++;
+    if (block_ != nullptr) record.before = Count(*block_);
+    index_ = report_->phases_.size();
+    report_->phases_.push_back(std::move(record));
+
+    // Sample last so counting the block is not charged to the phase.
+    peak_rss_start_kb_ = PeakRssKb();
+    cpu_start_ = ProcessCpuTime();
+    wall_start_ = std::chrono::steady_clock::now();
+}
+
+TimeReport::Scope::~Scope() {
+    if (report_ == nullptr) return;
+    const auto wall_end = std::chrono::steady_clock::now();
+    const auto cpu_end = ProcessCpuTime();
+    const int64_t peak_rss_end_kb = PeakRssKb();
+
+    PhaseRecord& record = report_->phases_[index_];
+    record.start = std::chrono::duration_cast<std::chrono::microseconds>(wall_start_ - report_->origin_);
+    record.wall = std::chrono::duration_cast<std::chrono::microseconds>(wall_end - wall_start_);
+    record.cpu = cpu_end - cpu_start_;
+    record.peak_rss_delta_kb = peak_rss_end_kb - peak_rss_start_kb_;
+    if (block_ != nullptr) record.after = Count(*block_);
+    --report_->depth_;
+}
+
+std::string TimeReport::ToJson() const {
+    std::chrono::microseconds total{0};
+    for (const PhaseRecord& p : phases_) {
+        if (p.depth == 0) total += p.wall;
+    }
+
+    std::string out = "{\n  \"phases\": [";
+    for (size_t i = 0; i < phases_.size(); ++i) {
+        const PhaseRecord& p = phases_[i];
+        out += i == 0 ? "\n    {" : ",\n    {";
+        out += "\"name\": ";
+        AppendJsonString(out, p.name);
+        out += ", \"category\": ";
+        AppendJsonString(out, p.category);
+        out += std::format(", \"depth\": {}, \"start_us\": {}, \"wall_us\": {}, \"cpu_us\": {}, "
+                           "\"peak_rss_delta_kb\": {}, ",
+                           p.depth, p.start.count(), p.wall.count(), p.cpu.count(), p.peak_rss_delta_kb);
+        AppendCounts(out, "before", p.before);
+        out += ", ";
+        AppendCounts(out, "after", p.after);
+        out += "}";
+    }
+    out += std::format("\n  ],\n  \"total_wall_us\": {}\n}}\n", total.count());
+    return out;
+}
+
+std::string TimeReport::ToChromeTrace() const {
+    // Everything is recorded on the driving thread, so one track suffices.
+    std::string out = "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    bool first = true;
+    auto begin_event = [&] {
+        out += first ? "\n  {" : ",\n  {";
+        first = false;
+    };
+
+    for (const PhaseRecord& p : phases_) {
+        begin_event();
+        out += "\"name\": ";
+        AppendJsonString(out, p.name);
+        out += ", \"cat\": ";
+        AppendJsonString(out, p.category);
+        out += std::format(", \"ph\": \"X\", \"pid\": 1, \"tid\": 1, \"ts\": {}, \"dur\": {}, "
+                           "\"args\": {{\"cpu_us\": {}, \"peak_rss_delta_kb\": {}",
+                           p.start.count(), p.wall.count(), p.cpu.count(), p.peak_rss_delta_kb);
+        if (p.before) out += std::format(", \"ops_before\": {}, \"values_before\": {}", p.before->ops, p.before->values);
+        if (p.after) out += std::format(", \"ops_after\": {}, \"values_after\": {}", p.after->ops, p.after->values);
+        out += "}}";
+
+        const auto counter = [&](std::chrono::microseconds ts, const IrCounts& c) {
+            begin_event();
+            out += std::format("\"name\": \"ir\", \"ph\": \"C\", \"pid\": 1, \"ts\": {}, "
+                               "\"args\": {{\"ops\": {}, \"values\": {}}}}}",
+                               ts.count(), c.ops, c.values);
+        };
+        if (p.before) counter(p.start, *p.before);
+        if (p.after) counter(p.start + p.wall, *p.after);
+    }
+    out += "\n]}\n";
+    return out;
+}
+
+std::expected<void, std::string> TimeReport::Write(const std::filesystem::path& json_path,
+                                                   const std::filesystem::path& trace_path) const {
+    if (!json_path.empty()) {
+        if (auto res = WriteFile(json_path, ToJson()); !res) return res;
+    }
+    if (!trace_path.empty()) {
+        if (auto res = WriteFile(trace_path, ToChromeTrace()); !res) return res;
+    }
+    return {};
+}
+
+}  // namespace seecpp::utility
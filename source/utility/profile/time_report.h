@@ -0,0 +1,114 @@
+#ifndef SEECPP_UTILITY_TIME_REPORT_H_
+#define SEECPP_UTILITY_TIME_REPORT_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace seecpp::sir {
+class Block;
+}
+
+namespace seecpp::utility {
+
+/// @brief Size of the IR at a phase boundary.
+struct IrCounts {
+    size_t ops = 0;
+    /// Block arguments plus op results.
+    size_t values = 0;
+};
+
+/// @brief One timed phase of a compilation, like a row of -ftime-report.
+struct PhaseRecord {
+    std::string name;
+    /// "frontend", "middle_end", "pass" or "backend".
+    std::string category;
+    /// Nesting level; passes sit one below the middle-end phase.
+    uint32_t depth = 0;
+    /// Offset from the creation of the report.
+    std::chrono::microseconds start{0};
+    std::chrono::microseconds wall{0};
+    /// Process CPU time, so work done on thread pools is included.
+    std::chrono::microseconds cpu{0};
+    /// Growth of the process's peak resident set during the phase.
+    int64_t peak_rss_delta_kb = 0;
+    /// Unset when the phase had no block on that side (e.g. before ingest).
+    std::optional<IrCounts> before;
+    std::optional<IrCounts> after;
+};
+
+/// @brief Collects per-phase wall time, CPU time, peak RSS growth and IR size
+/// for one compilation, from ProtobufReader::ingest through Serializer::Run.
+///
+/// A disabled report records nothing, and Scopes on it cost one branch, so
+/// stages open them unconditionally. Like the CompilationContext that owns
+/// it, a report is not thread-safe: open Scopes only on the driving thread.
+class TimeReport {
+ public:
+    explicit TimeReport(bool enabled = false);
+
+    TimeReport(const TimeReport&) = delete;
+    TimeReport& operator=(const TimeReport&) = delete;
+
+    bool enabled() const { return enabled_; }
+
+    /// @brief Times one phase from construction to destruction.
+    class Scope {
+     public:
+        /// @param report May be null or disabled, in which case nothing is recorded.
+        /// @param block Counted now and again when the scope closes.
+        Scope(TimeReport* report, std::string_view name, std::string_view category,
+              const sir::Block* block = nullptr);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        /// @brief Changes which block is counted when the scope closes, for
+        /// phases that create or temporarily empty their block. Null skips it.
+        void set_block(const sir::Block* block) { block_ = block; }
+
+     private:
+        TimeReport* report_ = nullptr;
+        size_t index_ = 0;
+        const sir::Block* block_ = nullptr;
+        std::chrono::steady_clock::time_point wall_start_;
+        std::chrono::microseconds cpu_start_{0};
+        int64_t peak_rss_start_kb_ = 0;
+    };
+
+    /// @brief Phases in the order they started.
+    std::span<const PhaseRecord> phases() const { return phases_; }
+
+    /// @brief {"phases": [...], "total_wall_us": ...}. Nested phases are
+    /// listed after their parent with a larger depth.
+    std::string ToJson() const;
+
+    /// @brief The Trace Event Format read by chrome://tracing and Perfetto:
+    /// one complete event per phase, plus "ir" counters at every boundary.
+    std::string ToChromeTrace() const;
+
+    /// @brief Writes the JSON report and the trace; empty paths are skipped.
+    std::expected<void, std::string> Write(const std::filesystem::path& json_path,
+                                           const std::filesystem::path& trace_path) const;
+
+    /// @brief O(1); the block keeps both counts up to date.
+    static IrCounts Count(const sir::Block& block);
+
+ private:
+    bool enabled_;
+    uint32_t depth_ = 0;
+    std::chrono::steady_clock::time_point origin_;
+    std::vector<PhaseRecord> phases_;
+};
+
+}  // namespace seecpp::utility
+
+#endif  // SEECPP_UTILITY_TIME_REPORT_H_
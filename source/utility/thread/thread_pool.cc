@@ -0,0 +1,77 @@
+#include "include/utility/thread_pool.h"
+
+#include <algorithm>
+
+namespace seecpp::utility {
+
+ThreadPool::ThreadPool(size_t num_threads) {
+    if (num_threads == 0) {
+        num_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    // The caller is the first lane; spawn the rest.
+    workers_.reserve(num_threads - 1);
+    for (size_t i = 1; i < num_threads; ++i) {
+        workers_.emplace_back([this] { WorkerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    work_cv_.notify_all();
+    for (auto& worker : workers_) worker.join();
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& fn) {
+    if (count == 0) return;
+    if (workers_.empty() || count == 1) {
+        for (size_t i = 0; i < count; ++i) fn(i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> call_lock(call_mutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        fn_ = &fn;
+        count_ = count;
+        next_.store(0, std::memory_order_relaxed);
+        pending_workers_ = workers_.size();
+        ++generation_;
+    }
+    work_cv_.notify_all();
+
+    RunChunks();
+
+    // Every worker must leave RunChunks() before `fn` goes out of scope.
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] { return pending_workers_ == 0; });
+    fn_ = nullptr;
+}
+
+void ThreadPool::WorkerLoop() {
+    uint64_t seen_generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_cv_.wait(lock, [&] { return stop_ || generation_ != seen_generation; });
+            if (stop_) return;
+            seen_generation = generation_;
+        }
+
+        RunChunks();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--pending_workers_ == 0) done_cv_.notify_one();
+    }
+}
+
+void ThreadPool::RunChunks() {
+    for (size_t i = next_.fetch_add(1, std::memory_order_relaxed); i < count_;
+         i = next_.fetch_add(1, std::memory_order_relaxed)) {
+        (*fn_)(i);
+    }
+}
+
+}  // namespace seecpp::utility
@@ -0,0 +1,60 @@
+#ifndef SEECPP_UTILITY_THREAD_POOL_H_
+#define SEECPP_UTILITY_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace seecpp::utility {
+
+/// @brief A fixed set of worker threads that execute data-parallel loops.
+///
+/// Work is handed out one index at a time from a shared atomic counter, so
+/// uneven items (one huge tensor among thousands of scalars) balance
+/// themselves. The calling thread participates in every loop, which means a
+/// pool of size 1 spawns no workers and runs everything inline.
+class ThreadPool {
+ public:
+    /// @param num_threads Total parallelism including the caller. Zero selects
+    ///        std::thread::hardware_concurrency().
+    explicit ThreadPool(size_t num_threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// @brief Total parallelism, including the calling thread.
+    size_t size() const { return workers_.size() + 1; }
+
+    /// @brief Runs fn(i) for every i in [0, count) and blocks until all finish.
+    /// `fn` must be safe to call concurrently and must not call back into the
+    /// same pool. Loops issued from different threads are serialized.
+    void ParallelFor(size_t count, const std::function<void(size_t)>& fn);
+
+ private:
+    void WorkerLoop();
+    void RunChunks();
+
+    std::vector<std::thread> workers_;
+
+    std::mutex call_mutex_;  // Serializes ParallelFor callers
+    std::mutex mutex_;       // Guards the fields below
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    uint64_t generation_ = 0;
+    size_t pending_workers_ = 0;
+    bool stop_ = false;
+
+    const std::function<void(size_t)>* fn_ = nullptr;
+    size_t count_ = 0;
+    std::atomic<size_t> next_{0};
+};
+
+}  // namespace seecpp::utility
+
+#endif  // SEECPP_UTILITY_THREAD_POOL_H_
@@ -1,9 +1,17 @@
 // test/cpp/backend/test_codegen.cc
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <vector>
 
 #include "include/backend/codegen_driver.h"
+#include "source/backend/cache/artifact_cache.h"
+#include "source/backend/serializer/schema.h"
+#include "source/utility/hash/crc32c.h"
 #include "seecpp/sir/sir.h"
 #include "seecpp/utility/weight_buffer.h"
 
@@ -103,4 +111,506 @@ TEST_F(CodegenDriverTest, HappyPathProducesValidBinaryFile) {
     EXPECT_GT(std::filesystem::file_size(valid_output_bin_), 0);
 }
 
+TEST_F(CodegenDriverTest, LargeWeightsArePageAlignedInRodata) {
+    CodegenDriver driver(CodegenOptions{
+        .large_weight_threshold = 64 * 1024,
+        .large_weight_alignment = 4096
+    });
+
+    // A 1 KiB weight packed first, then one of 512 KiB: only the second
+    // crosses the threshold, so it must be pushed to the next page.
+    sir::Block valid_block;
+    sir::Value* x = valid_block.addArgument(sir::DataType::F32, {1, 16});
+    sir::Value* small_w = valid_block.addArgument(sir::DataType::F32, {16, 16});
+    sir::Value* large_w = valid_block.addArgument(sir::DataType::F32, {16, 8192});
+    auto* first = valid_block.appendOp(sir::op::kLowMatMul);
+    first->addOperand(x);
+    first->addOperand(small_w);
+    sir::Value* h = first->addResult("", sir::DataType::F32, {1, 16});
+    auto* second = valid_block.appendOp(sir::op::kLowMatMul);
+    second->addOperand(h);
+    second->addOperand(large_w);
+    second->addResult("", sir::DataType::F32, {1, 8192});
+
+    utility::WeightBuffer valid_weights;
+    const std::vector<float> small_data(16 * 16, 0.5f);
+    const std::vector<float> large_data(16 * 8192, 0.25f);
+    valid_weights.Add<float>(small_w->id(), small_data, utility::BufferDtype::kF32);
+    valid_weights.Add<float>(large_w->id(), large_data, utility::BufferDtype::kF32);
+    const uint64_t large_bytes = large_data.size() * sizeof(float);
+    ASSERT_GE(large_bytes, 64u * 1024);
+
+    auto result = driver.Run(valid_block, valid_weights, valid_output_bin_.string());
+    ASSERT_TRUE(result.has_value()) << result.error().phase << " - " << result.error().message;
+
+    // The rodata section itself must start on the page boundary, otherwise the 
+    // per-tensor page alignment inside it is meaningless once mmap()ed.
+    std::ifstream in(valid_output_bin_, std::ios::binary);
+    FileHeader header{};
+    in.read(reinterpret_cast<char*>(&header), sizeof(FileHeader));
+    ASSERT_TRUE(in.good());
+    ASSERT_EQ(header.version, kCurrentVersion);
+
+    std::vector<SectionEntry> sections(header.section_count);
+    in.seekg(static_cast<std::streamoff>(header.section_table_offset));
+    in.read(reinterpret_cast<char*>(sections.data()), sections.size() * sizeof(SectionEntry));
+    ASSERT_TRUE(in.good());
+    const SectionEntry* rodata = FindSection(sections, SectionType::kRodata);
+    ASSERT_NE(rodata, nullptr);
+    EXPECT_EQ(rodata->offset % 4096, 0u);
+    EXPECT_GE(rodata->alignment, 4096u);
+    EXPECT_TRUE(rodata->flags & kSectionRequired);
+    // The small weight at 0, padding to the page, then the large weight.
+    EXPECT_EQ(rodata->size, 4096 + large_bytes);
+
+    // Required sections end with .rodata and optional ones trail it, so a
+    // plain load maps no optional bytes.
+    for (const SectionEntry& section : sections) {
+        if (section.flags & kSectionRequired) {
+            EXPECT_LE(section.offset + section.size, rodata->offset + rodata->size) << section.type;
+        } else {
+            EXPECT_GE(section.offset, rodata->offset + rodata->size) << section.type;
+        }
+    }
+}
+
+TEST_F(CodegenDriverTest, RejectsNonPowerOfTwoWeightAlignment) {
+    CodegenDriver driver(CodegenOptions{
+        .large_weight_threshold = 1024,
+        .large_weight_alignment = 3000
+    });
+    sir::Block valid_block = CreateValidGraph();
+    utility::WeightBuffer valid_weights(4096);
+
+    auto result = driver.Run(valid_block, valid_weights, valid_output_bin_.string());
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().phase, "weight_packing");
+}
+
+TEST_F(CodegenDriverTest, InstructionsUseTheCompactEncodingByDefault) {
+    CodegenDriver driver;
+    sir::Block valid_block = CreateValidGraph();
+    utility::WeightBuffer valid_weights(4096);
+    ASSERT_TRUE(driver.Run(valid_block, valid_weights, valid_output_bin_.string()).has_value());
+
+    std::ifstream in(valid_output_bin_, std::ios::binary);
+    FileHeader header{};
+    in.read(reinterpret_cast<char*>(&header), sizeof(FileHeader));
+    std::vector<SectionEntry> sections(header.section_count);
+    in.seekg(static_cast<std::streamoff>(header.section_table_offset));
+    in.read(reinterpret_cast<char*>(sections.data()), sections.size() * sizeof(SectionEntry));
+    ASSERT_TRUE(in.good());
+
+    EXPECT_EQ(FindSection(sections, SectionType::kText), nullptr);
+    const SectionEntry* text = FindSection(sections, SectionType::kCompactText);
+    const SectionEntry* pool = FindSection(sections, SectionType::kOperandPool);
+    ASSERT_NE(text, nullptr);
+    ASSERT_NE(pool, nullptr);
+    EXPECT_EQ(text->size, header.instruction_count * sizeof(CompactInstruction));
+    EXPECT_TRUE(text->flags & kSectionRequired);
+    EXPECT_TRUE(pool->flags & kSectionRequired);
+
+    // Every instruction's operands must lie inside the pool.
+    std::vector<CompactInstruction> instructions(header.instruction_count);
+    in.seekg(static_cast<std::streamoff>(text->offset));
+    in.read(reinterpret_cast<char*>(instructions.data()), text->size);
+    ASSERT_TRUE(in.good());
+    for (const CompactInstruction& inst : instructions) {
+        EXPECT_LE((inst.operand_index + inst.num_inputs + inst.num_outputs) * sizeof(uint64_t), pool->size);
+    }
+}
+
+TEST_F(CodegenDriverTest, EverySectionCarriesItsCrc32c) {
+    CodegenDriver driver;
+    sir::Block valid_block = CreateValidGraph();
+    utility::WeightBuffer valid_weights(4096);
+    ASSERT_TRUE(driver.Run(valid_block, valid_weights, valid_output_bin_.string()).has_value());
+
+    std::ifstream in(valid_output_bin_, std::ios::binary);
+    const std::vector<uint8_t> file((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    ASSERT_GE(file.size(), sizeof(FileHeader));
+    FileHeader header{};
+    std::memcpy(&header, file.data(), sizeof(FileHeader));
+    std::vector<SectionEntry> sections(header.section_count);
+    std::memcpy(sections.data(), file.data() + header.section_table_offset,
+                sections.size() * sizeof(SectionEntry));
+
+    for (const SectionEntry& section : sections) {
+        SCOPED_TRACE(section.type);
+        EXPECT_TRUE(section.flags & kSectionChecksummed);
+        ASSERT_LE(section.offset + section.size, file.size());
+        EXPECT_EQ(utility::Crc32c({file.data() + section.offset, section.size}), section.checksum);
+    }
+}
+
+TEST_F(CodegenDriverTest, SourceInfoRoundTripsThroughTheStringTable) {
+    CodegenDriver driver;
+    sir::Block block;
+    sir::Value* x = block.addArgument(sir::DataType::F32, {1, 16});
+    sir::Value* w1 = block.addArgument(sir::DataType::F32, {16, 16});
+    sir::Value* w2 = block.addArgument(sir::DataType::F32, {16, 16});
+    auto* first = block.appendOp(sir::op::kLowMatMul);
+    first->addOperand(x);
+    first->addOperand(w1);
+    sir::Value* h = first->addResult("", sir::DataType::F32, {1, 16});
+    first->setAttribute(sir::attr::kSourceNode, std::string("fc1"));
+    first->setAttribute(sir::attr::kSourceOpType, std::string("Gemm"));
+    first->setAttribute(sir::attr::kOpSequence, std::string("add,relu"));
+    // No source attributes: every string but the mnemonic and shapes is empty.
+    auto* second = block.appendOp(sir::op::kLowMatMul);
+    second->addOperand(h);
+    second->addOperand(w2);
+    second->addResult("", sir::DataType::F32, {1, 16});
+
+    utility::WeightBuffer weights;
+    const std::vector<float> data(16 * 16, 0.5f);
+    weights.Add<float>(w1->id(), data, utility::BufferDtype::kF32);
+    weights.Add<float>(w2->id(), data, utility::BufferDtype::kF32);
+    auto result = driver.Run(block, weights, valid_output_bin_.string());
+    ASSERT_TRUE(result.has_value()) << result.error().phase << " - " << result.error().message;
+
+    std::ifstream in(valid_output_bin_, std::ios::binary);
+    const std::vector<uint8_t> file((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    FileHeader header{};
+    std::memcpy(&header, file.data(), sizeof(FileHeader));
+    std::vector<SectionEntry> sections(header.section_count);
+    std::memcpy(sections.data(), file.data() + header.section_table_offset,
+                sections.size() * sizeof(SectionEntry));
+    const SectionEntry* strings = FindSection(sections, SectionType::kStringTable);
+    const SectionEntry* records = FindSection(sections, SectionType::kSourceInfo);
+    ASSERT_NE(strings, nullptr);
+    ASSERT_NE(records, nullptr);
+    EXPECT_FALSE(strings->flags & kSectionRequired);
+    EXPECT_FALSE(records->flags & kSectionRequired);
+    ASSERT_EQ(records->size, header.instruction_count * sizeof(SourceInfo));
+    ASSERT_EQ(header.instruction_count, 2u);
+
+    std::vector<SourceInfo> infos(header.instruction_count);
+    std::memcpy(infos.data(), file.data() + records->offset, records->size);
+    const auto text = [&](uint32_t offset) {
+        EXPECT_LT(offset, strings->size);
+        const char* begin = reinterpret_cast<const char*>(file.data() + strings->offset + offset);
+        return std::string(begin, strnlen(begin, strings->size - offset));
+    };
+    EXPECT_EQ(text(infos[0].node_name), "fc1");
+    EXPECT_EQ(text(infos[0].op_type), "Gemm");
+    EXPECT_EQ(text(infos[0].op_sequence), "add,relu");
+    EXPECT_EQ(text(infos[0].shapes), "f32[1,16], f32[16,16] -> f32[1,16]");
+    EXPECT_FALSE(text(infos[0].sir_op).empty());
+    EXPECT_EQ(infos[0].reserved, 0u);
+
+    // Offset 0 is the empty string, and equal strings are stored once.
+    EXPECT_EQ(infos[1].node_name, 0u);
+    EXPECT_EQ(infos[1].op_type, 0u);
+    EXPECT_EQ(infos[1].op_sequence, 0u);
+    EXPECT_EQ(infos[1].sir_op, infos[0].sir_op);
+    EXPECT_EQ(infos[1].shapes, infos[0].shapes);
+
+    // Without source info neither section is written.
+    CodegenOptions stripped;
+    stripped.serializer.emit_source_info = false;
+    stripped.serializer.emit_weight_names = false;
+    const auto stripped_output = test_dir_ / "stripped.see";
+    ASSERT_TRUE(CodegenDriver(stripped).Run(block, weights, stripped_output.string()).has_value());
+    std::ifstream stripped_in(stripped_output, std::ios::binary);
+    ASSERT_TRUE(stripped_in.read(reinterpret_cast<char*>(&header), sizeof(header)));
+    sections.assign(header.section_count, SectionEntry{});
+    stripped_in.seekg(static_cast<std::streamoff>(header.section_table_offset));
+    ASSERT_TRUE(stripped_in.read(reinterpret_cast<char*>(sections.data()),
+                                 static_cast<std::streamsize>(sections.size() * sizeof(SectionEntry))));
+    EXPECT_EQ(FindSection(sections, SectionType::kStringTable), nullptr);
+    EXPECT_EQ(FindSection(sections, SectionType::kSourceInfo), nullptr);
+}
+
+TEST_F(CodegenDriverTest, EveryInstructionGetsACostRecord) {
+    CodegenDriver driver;
+    sir::Block block;
+    sir::Value* x = block.addArgument(sir::DataType::F32, {1, 16});
+    sir::Value* w = block.addArgument(sir::DataType::F32, {16, 16});
+    auto* matmul = block.appendOp(sir::op::kLowMatMul);
+    matmul->addOperand(x);
+    matmul->addOperand(w);
+    matmul->addResult("", sir::DataType::F32, {1, 16});
+
+    utility::WeightBuffer weights;
+    weights.Add<float>(w->id(), std::vector<float>(16 * 16, 0.5f), utility::BufferDtype::kF32);
+    auto result = driver.Run(block, weights, valid_output_bin_.string());
+    ASSERT_TRUE(result.has_value()) << result.error().phase << " - " << result.error().message;
+
+    std::ifstream in(valid_output_bin_, std::ios::binary);
+    const std::vector<uint8_t> file((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    FileHeader header{};
+    std::memcpy(&header, file.data(), sizeof(FileHeader));
+    std::vector<SectionEntry> sections(header.section_count);
+    std::memcpy(sections.data(), file.data() + header.section_table_offset,
+                sections.size() * sizeof(SectionEntry));
+    const SectionEntry* costs = FindSection(sections, SectionType::kInstructionCost);
+    ASSERT_NE(costs, nullptr);
+    EXPECT_FALSE(costs->flags & kSectionRequired);
+    ASSERT_EQ(header.instruction_count, 1u);
+    ASSERT_EQ(costs->size, sizeof(InstructionCost));
+
+    // One multiply-add per weight element, reading x and W, writing y.
+    InstructionCost cost{};
+    std::memcpy(&cost, file.data() + costs->offset, sizeof(cost));
+    EXPECT_EQ(cost.flops, 2u * 16 * 16);
+    EXPECT_EQ(cost.bytes_read, (16u + 16 * 16) * sizeof(float));
+    EXPECT_EQ(cost.bytes_written, 16u * sizeof(float));
+}
+
+TEST_F(CodegenDriverTest, SecondCompileOfSameGraphIsServedFromCache) {
+    const auto cache_dir = test_dir_ / "cache";
+    CodegenDriver driver(CodegenOptions{.cache_dir = cache_dir});
+    utility::WeightBuffer valid_weights(4096);
+
+    sir::Block first_block = CreateValidGraph();
+    ASSERT_TRUE(driver.Run(first_block, valid_weights, valid_output_bin_.string()).has_value());
+    const auto hits_before = ArtifactCache::ProcessStats().hits;
+
+    const auto second_output = test_dir_ / "second.see";
+    sir::Block second_block = CreateValidGraph();
+    ASSERT_TRUE(driver.Run(second_block, valid_weights, second_output.string()).has_value());
+
+    EXPECT_EQ(ArtifactCache::ProcessStats().hits, hits_before + 1);
+    EXPECT_EQ(std::filesystem::file_size(second_output),
+              std::filesystem::file_size(valid_output_bin_));
+}
+
+TEST_F(CodegenDriverTest, SerializerLayoutIsPartOfTheCacheKey) {
+    const auto cache_dir = test_dir_ / "cache";
+    utility::WeightBuffer valid_weights(4096);
+    sir::Block compact_block = CreateValidGraph();
+    ASSERT_TRUE(CodegenDriver(CodegenOptions{.cache_dir = cache_dir})
+                    .Run(compact_block, valid_weights, valid_output_bin_.string())
+                    .has_value());
+    const auto hits_before = ArtifactCache::ProcessStats().hits;
+
+    // Same graph and weights, but a file laid out differently.
+    CodegenOptions fixed{.cache_dir = cache_dir};
+    fixed.serializer.encoding = InstructionEncoding::kFixed;
+    const auto fixed_output = test_dir_ / "fixed.see";
+    sir::Block fixed_block = CreateValidGraph();
+    ASSERT_TRUE(CodegenDriver(fixed).Run(fixed_block, valid_weights, fixed_output.string()).has_value());
+
+    EXPECT_EQ(ArtifactCache::ProcessStats().hits, hits_before);
+    std::ifstream in(fixed_output, std::ios::binary);
+    FileHeader header{};
+    ASSERT_TRUE(in.read(reinterpret_cast<char*>(&header), sizeof(header)));
+    std::vector<SectionEntry> sections(header.section_count);
+    in.seekg(static_cast<std::streamoff>(header.section_table_offset));
+    ASSERT_TRUE(in.read(reinterpret_cast<char*>(sections.data()),
+                        static_cast<std::streamsize>(sections.size() * sizeof(SectionEntry))));
+    for (const SectionEntry& section : sections) {
+        EXPECT_NE(section.type, static_cast<uint32_t>(SectionType::kOperandPool));
+    }
+}
+
+TEST_F(CodegenDriverTest, BlockArgumentWeightContentIsPartOfTheCacheKey) {
+    const auto cache_dir = test_dir_ / "cache";
+    CodegenDriver driver(CodegenOptions{.cache_dir = cache_dir});
+
+    // The weight reaches the matmul as a block argument, with no weight_ref.
+    const auto compile = [&](float value, const std::filesystem::path& output) {
+        sir::Block block;
+        sir::Value* x = block.addArgument(sir::DataType::F32, {1, 16});
+        sir::Value* w = block.addArgument(sir::DataType::F32, {16, 16});
+        auto* matmul = block.appendOp(sir::op::kLowMatMul);
+        matmul->addOperand(x);
+        matmul->addOperand(w);
+        matmul->addResult("", sir::DataType::F32, {1, 16});
+        utility::WeightBuffer weights;
+        weights.Add<float>(w->id(), std::vector<float>(16 * 16, value), utility::BufferDtype::kF32);
+        return driver.Run(block, weights, output.string()).has_value();
+    };
+
+    ASSERT_TRUE(compile(0.5f, valid_output_bin_));
+    const auto hits_before = ArtifactCache::ProcessStats().hits;
+    ASSERT_TRUE(compile(0.25f, test_dir_ / "changed.see"));
+    EXPECT_EQ(ArtifactCache::ProcessStats().hits, hits_before);
+    ASSERT_TRUE(compile(0.25f, test_dir_ / "again.see"));
+    EXPECT_EQ(ArtifactCache::ProcessStats().hits, hits_before + 1);
+}
+
+TEST_F(CodegenDriverTest, RecompileReplacesOutputWithoutTouchingTheOldInode) {
+    CodegenDriver driver;
+    utility::WeightBuffer valid_weights(4096);
+    sir::Block first_block = CreateValidGraph();
+    ASSERT_TRUE(driver.Run(first_block, valid_weights, valid_output_bin_.string()).has_value());
+
+    // Stands in for a cache entry or a file a running engine has mapped.
+    const auto linked = test_dir_ / "linked.see";
+    std::filesystem::create_hard_link(valid_output_bin_, linked);
+    const auto size_before = std::filesystem::file_size(linked);
+
+    sir::Block second_block = CreateValidGraph();
+    ASSERT_TRUE(driver.Run(second_block, valid_weights, valid_output_bin_.string()).has_value());
+
+    EXPECT_EQ(std::filesystem::hard_link_count(linked), 1u);
+    EXPECT_EQ(std::filesystem::hard_link_count(valid_output_bin_), 1u);
+    EXPECT_EQ(std::filesystem::file_size(linked), size_before);
+    // No temporary sibling is left behind.
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator(test_dir_),
+                            std::filesystem::directory_iterator{}), 2);
+}
+
+TEST_F(CodegenDriverTest, RefreshWeightsPatchesMatchingArtifact) {
+    CodegenDriver driver;
+    utility::WeightBuffer valid_weights(4096);
+
+    sir::Block original = CreateValidGraph();
+    ASSERT_TRUE(driver.Run(original, valid_weights, valid_output_bin_.string()).has_value());
+    const auto size_before = std::filesystem::file_size(valid_output_bin_);
+
+    sir::Block retrained = CreateValidGraph();
+    auto result = driver.RefreshWeights(retrained, valid_weights, valid_output_bin_.string());
+    ASSERT_TRUE(result.has_value()) << result.error().phase << " - " << result.error().message;
+    EXPECT_EQ(std::filesystem::file_size(valid_output_bin_), size_before);
+}
+
+TEST_F(CodegenDriverTest, RefreshWeightsRewritesRodataIntoANewFile) {
+    CodegenDriver driver;
+    auto build = [](sir::Block& block) {
+        sir::Value* x = block.addArgument(sir::DataType::F32, {1, 16});
+        sir::Value* w = block.addArgument(sir::DataType::F32, {16, 16});
+        auto* matmul = block.appendOp(sir::op::kLowMatMul);
+        matmul->addOperand(x);
+        matmul->addOperand(w);
+        matmul->addResult("", sir::DataType::F32, {1, 16});
+        return w->id();
+    };
+    auto rodata_of = [](const std::filesystem::path& path) {
+        std::ifstream in(path, std::ios::binary);
+        const std::vector<uint8_t> file((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        FileHeader header{};
+        std::memcpy(&header, file.data(), sizeof(FileHeader));
+        std::vector<SectionEntry> sections(header.section_count);
+        std::memcpy(sections.data(), file.data() + header.section_table_offset,
+                    sections.size() * sizeof(SectionEntry));
+        const SectionEntry* rodata = FindSection(sections, SectionType::kRodata);
+        EXPECT_NE(rodata, nullptr);
+        if (rodata == nullptr) return std::vector<float>{};
+        EXPECT_EQ(utility::Crc32c({file.data() + rodata->offset, rodata->size}), rodata->checksum);
+        std::vector<float> values(rodata->size / sizeof(float));
+        std::memcpy(values.data(), file.data() + rodata->offset, values.size() * sizeof(float));
+        return values;
+    };
+
+    std::vector<float> before(16 * 16), after(16 * 16);
+    for (size_t i = 0; i < before.size(); ++i) {
+        before[i] = static_cast<float>(i);
+        after[i] = -0.25f * static_cast<float>(i);
+    }
+    sir::Block original;
+    utility::WeightBuffer original_weights;
+    original_weights.Add<float>(build(original), before, utility::BufferDtype::kF32);
+    ASSERT_TRUE(driver.Run(original, original_weights, valid_output_bin_.string()).has_value());
+    const std::filesystem::path old_inode = test_dir_ / "old.see";
+    std::filesystem::create_hard_link(valid_output_bin_, old_inode);
+
+    sir::Block retrained;
+    utility::WeightBuffer retrained_weights;
+    retrained_weights.Add<float>(build(retrained), after, utility::BufferDtype::kF32);
+    auto result = driver.RefreshWeights(retrained, retrained_weights, valid_output_bin_.string());
+    ASSERT_TRUE(result.has_value()) << result.error().phase << " - " << result.error().message;
+
+    // The path names a new file with the new weights; the old inode, which an
+    // engine could still have mapped, is untouched.
+    const std::vector<float> patched = rodata_of(valid_output_bin_);
+    ASSERT_GE(patched.size(), after.size());
+    EXPECT_TRUE(std::equal(after.begin(), after.end(), patched.begin()));
+    const std::vector<float> kept = rodata_of(old_inode);
+    ASSERT_GE(kept.size(), before.size());
+    EXPECT_TRUE(std::equal(before.begin(), before.end(), kept.begin()));
+    EXPECT_EQ(std::filesystem::hard_link_count(old_inode), 1u);
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator(test_dir_),
+                            std::filesystem::directory_iterator{}), 2);
+}
+
+TEST_F(CodegenDriverTest, RefreshWeightsByNameNeedsNoGraph) {
+    CodegenDriver driver;
+    sir::Block block;
+    sir::Value* x = block.addArgument(sir::DataType::F32, {1, 16});
+    sir::Value* w = block.addArgument(sir::DataType::F32, {16, 16});
+    auto* matmul = block.appendOp(sir::op::kLowMatMul);
+    matmul->addOperand(x);
+    matmul->addOperand(w);
+    matmul->addResult("", sir::DataType::F32, {1, 16});
+
+    utility::WeightBuffer original;
+    original.Add<float>(w->id(), std::vector<float>(16 * 16, 0.5f), utility::BufferDtype::kF32);
+    ASSERT_TRUE(driver.Run(block, original, valid_output_bin_.string()).has_value());
+    const auto size_before = std::filesystem::file_size(valid_output_bin_);
+    const std::filesystem::path old_inode = test_dir_ / "old.see";
+    std::filesystem::create_hard_link(valid_output_bin_, old_inode);
+
+    utility::WeightBuffer retrained;
+    retrained.Add<float>(w->id(), std::vector<float>(16 * 16, 2.0f), utility::BufferDtype::kF32);
+    auto result = driver.RefreshWeights(retrained, valid_output_bin_.string());
+    ASSERT_TRUE(result.has_value()) << result.error().phase << " - " << result.error().message;
+    EXPECT_EQ(std::filesystem::file_size(valid_output_bin_), size_before);
+
+    std::ifstream in(valid_output_bin_, std::ios::binary);
+    const std::vector<uint8_t> file((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    FileHeader header{};
+    std::memcpy(&header, file.data(), sizeof(FileHeader));
+    std::vector<SectionEntry> sections(header.section_count);
+    std::memcpy(sections.data(), file.data() + header.section_table_offset,
+                sections.size() * sizeof(SectionEntry));
+    const SectionEntry* rodata = FindSection(sections, SectionType::kRodata);
+    ASSERT_NE(rodata, nullptr);
+    float first = 0;
+    std::memcpy(&first, file.data() + rodata->offset, sizeof(float));
+    EXPECT_EQ(first, 2.0f);
+    EXPECT_EQ(utility::Crc32c({file.data() + rodata->offset, rodata->size}), rodata->checksum);
+    // Patched as a copy renamed over the path; the old inode keeps the old weights.
+    EXPECT_EQ(std::filesystem::hard_link_count(old_inode), 1u);
+    std::ifstream old_in(old_inode, std::ios::binary);
+    old_in.seekg(static_cast<std::streamoff>(rodata->offset));
+    old_in.read(reinterpret_cast<char*>(&first), sizeof(float));
+    EXPECT_EQ(first, 0.5f);
+
+    // A checkpoint missing a weight is refused before anything is written.
+    utility::WeightBuffer incomplete;
+    result = driver.RefreshWeights(incomplete, valid_output_bin_.string());
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().phase, "weights_refresh");
+}
+
+TEST_F(CodegenDriverTest, RefreshWeightsRejectsNonSeeFile) {
+    CodegenDriver driver;
+    utility::WeightBuffer valid_weights(4096);
+    {
+        std::ofstream out(valid_output_bin_, std::ios::binary);
+        out << std::string(sizeof(FileHeader), 'x');
+    }
+
+    sir::Block block = CreateValidGraph();
+    auto result = driver.RefreshWeights(block, valid_weights, valid_output_bin_.string());
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().phase, "weights_refresh");
+}
+
+TEST_F(CodegenDriverTest, RefreshWeightsRejectsSectionTableRunningPastTheFile) {
+    CodegenDriver driver;
+    utility::WeightBuffer valid_weights(4096);
+    sir::Block original = CreateValidGraph();
+    ASSERT_TRUE(driver.Run(original, valid_weights, valid_output_bin_.string()).has_value());
+
+    // A count no file could hold must be refused, not allocated.
+    {
+        std::fstream file(valid_output_bin_, std::ios::binary | std::ios::in | std::ios::out);
+        const uint32_t count = 0x7FFFFFFF;
+        file.seekp(offsetof(FileHeader, section_count));
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+
+    sir::Block retrained = CreateValidGraph();
+    auto result = driver.RefreshWeights(retrained, valid_weights, valid_output_bin_.string());
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().phase, "io_error");
+    result = driver.RefreshWeights(valid_weights, valid_output_bin_.string());
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().phase, "io_error");
+}
+
 } // namespace seecpp::backend::testing
@@ -0,0 +1,106 @@
+// test/cpp/backend/test_cost_annotator.cc
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "source/backend/lowering/cost_annotator.h"
+#include "seecpp/sir/sir.h"
+
+namespace seecpp::backend::testing {
+
+TEST(CostAnnotatorTest, CountsMultiplyAddsAndCompulsoryTraffic) {
+    sir::Block block;
+    sir::Value* x = block.addArgument(sir::DataType::F32, {1, 3, 8, 8});
+    sir::Value* w = block.addArgument(sir::DataType::F32, {4, 3, 3, 3});
+    sir::Value* b = block.addArgument(sir::DataType::F32, {4});
+
+    auto* conv = block.appendOp(sir::op::kLowConv2d);
+    conv->addOperand(x);
+    conv->addOperand(w);
+    conv->addOperand(b);
+    sir::Value* y = conv->addResult("", sir::DataType::F32, {1, 4, 6, 6});
+
+    auto* relu = block.appendOp(sir::op::kLowRelu);
+    relu->addOperand(y);
+    relu->addResult("", sir::DataType::F32, {1, 4, 6, 6});
+
+    sir::Value* a = block.addArgument(sir::DataType::F32, {2, 16, 32});
+    sir::Value* m = block.addArgument(sir::DataType::F32, {32, 8});
+    auto* matmul = block.appendOp(sir::op::kLowMatMul);
+    matmul->addOperand(a);
+    matmul->addOperand(m);
+    matmul->addResult("", sir::DataType::F32, {2, 16, 8});
+
+    CostAnnotator().Run(block);
+
+    // 144 outputs, each a 27-term dot product plus a bias add.
+    EXPECT_EQ(conv->getAttrAs<int64_t>(sir::attr::kFlops), 144 * (2 * 27 + 1));
+    EXPECT_EQ(conv->getAttrAs<int64_t>(sir::attr::kBytesRead), (192 + 108 + 4) * 4);
+    EXPECT_EQ(conv->getAttrAs<int64_t>(sir::attr::kBytesWritten), 144 * 4);
+
+    EXPECT_EQ(relu->getAttrAs<int64_t>(sir::attr::kFlops), 144);
+
+    const OpCost cost = CostAnnotator::Estimate(*matmul);
+    EXPECT_EQ(cost.flops, 2u * 256 * 32);
+    EXPECT_EQ(cost.bytes_read, (1024u + 256) * 4);
+    EXPECT_EQ(cost.bytes_written, 256u * 4);
+}
+
+TEST(CostAnnotatorTest, CoversElementwiseReductionAndDataMovementOps) {
+    sir::Block block;
+    sir::Value* x = block.addArgument(sir::DataType::F32, {2, 8, 4, 4});
+    sir::Value* y = block.addArgument(sir::DataType::F32, {2, 8, 4, 4});
+    const auto append = [&](sir::OpId id, std::vector<sir::Value*> operands, sir::Shape shape) {
+        auto* op = block.appendOp(id);
+        for (sir::Value* v : operands) op->addOperand(v);
+        op->addResult("", sir::DataType::F32, std::move(shape));
+        return op;
+    };
+
+    // 256 output elements each.
+    for (sir::OpId id : {sir::op::kAdd, sir::op::kSub, sir::op::kMul, sir::op::kDiv, sir::op::kRelu}) {
+        const OpCost cost = CostAnnotator::Estimate(*append(id, {x, y}, {2, 8, 4, 4}));
+        EXPECT_TRUE(cost.flops_known);
+        EXPECT_EQ(cost.flops, 256u);
+    }
+
+    auto* fused = append(sir::op::kFusedEw, {x, y}, {2, 8, 4, 4});
+    fused->setAttribute(sir::attr::kOpSequence, std::string("add,mul,relu"));
+    EXPECT_EQ(CostAnnotator::Estimate(*fused).flops, 3u * 256);
+
+    EXPECT_EQ(CostAnnotator::Estimate(*append(sir::op::kBatchNorm, {x}, {2, 8, 4, 4})).flops, 2u * 256);
+
+    // [2, 8, 4, 4] summed to [2, 8]: one add per input element.
+    EXPECT_EQ(CostAnnotator::Estimate(*append(sir::op::kLowReduceSum, {x}, {2, 8})).flops, 256u);
+
+    // 2x2 windows over 4x4, stride 2: 64 outputs of 4 elements each.
+    auto* max_pool = append(sir::op::kMaxPool, {x}, {2, 8, 2, 2});
+    max_pool->setAttribute(sir::attr::kKernelShape, std::vector<int64_t>{2, 2});
+    EXPECT_EQ(CostAnnotator::Estimate(*max_pool).flops, 64u * 4);
+    auto* avg_pool = append(sir::op::kAvgPool, {x}, {2, 8, 2, 2});
+    avg_pool->setAttribute(sir::attr::kKernelShape, std::vector<int64_t>{2, 2});
+    EXPECT_EQ(CostAnnotator::Estimate(*avg_pool).flops, 64u * 5);
+
+    // Moving bytes is free of arithmetic, but still traffic.
+    const OpCost transpose = CostAnnotator::Estimate(*append(sir::op::kLowTranspose, {x}, {2, 8, 4, 4}));
+    EXPECT_TRUE(transpose.flops_known);
+    EXPECT_EQ(transpose.flops, 0u);
+    EXPECT_EQ(transpose.bytes_read, 256u * 4);
+    EXPECT_EQ(transpose.bytes_written, 256u * 4);
+
+    // An op the annotator has never heard of is flagged, not silently free.
+    auto* custom = append(sir::OpRegistry::Get().InternOp("sc_low.custom_kernel"), {x}, {2, 8, 4, 4});
+    const OpCost unknown = CostAnnotator::Estimate(*custom);
+    EXPECT_FALSE(unknown.flops_known);
+    EXPECT_EQ(unknown.flops, 0u);
+    EXPECT_EQ(unknown.bytes_read, 256u * 4);
+
+    // Run() still annotates it, so the serializer keeps the cost table.
+    CostAnnotator().Run(block);
+    EXPECT_EQ(custom->getAttrAs<int64_t>(sir::attr::kFlops), 0);
+    EXPECT_EQ(fused->getAttrAs<int64_t>(sir::attr::kFlops), 3 * 256);
+}
+
+}  // namespace seecpp::backend::testing
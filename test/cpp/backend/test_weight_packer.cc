@@ -0,0 +1,62 @@
+// test/cpp/backend/test_weight_packer.cc
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "include/backend/codegen_driver.h"
+#include "source/backend/weights/weight_packer.h"
+#include "seecpp/sir/sir.h"
+#include "seecpp/utility/weight_buffer.h"
+
+namespace seecpp::backend::testing {
+
+TEST(WeightPackerTest, IdenticalWeightsAreStoredOnce) {
+    sir::Block block;
+    sir::Value* x = block.addArgument(sir::DataType::F32, {1, 16});
+    // Tied embeddings: two names, the same bytes.
+    sir::Value* embed = block.addArgument(sir::DataType::F32, {16, 16});
+    sir::Value* unembed = block.addArgument(sir::DataType::F32, {16, 16});
+    // Same size, one element different.
+    sir::Value* other = block.addArgument(sir::DataType::F32, {16, 16});
+    for (sir::Value* w : {embed, unembed, other}) {
+        auto* matmul = block.appendOp(sir::op::kLowMatMul);
+        matmul->addOperand(x);
+        matmul->addOperand(w);
+        matmul->addResult("", sir::DataType::F32, {1, 16});
+    }
+
+    std::vector<float> data(16 * 16);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<float>(i) * 0.25f;
+    std::vector<float> changed = data;
+    changed.back() += 1.0f;
+    utility::WeightBuffer weights;
+    weights.Add<float>(embed->id(), data, utility::BufferDtype::kF32);
+    weights.Add<float>(unembed->id(), data, utility::BufferDtype::kF32);
+    weights.Add<float>(other->id(), changed, utility::BufferDtype::kF32);
+
+    WeightPacker packer;
+    auto packed = packer.Run(block, weights);
+    ASSERT_TRUE(packed.has_value()) << packed.error().message;
+
+    // Distinct names resolve to one slot; every name keeps its own size.
+    const std::string embed_id(embed->id()), unembed_id(unembed->id()), other_id(other->id());
+    ASSERT_TRUE(packed->offsets.contains(embed_id));
+    ASSERT_TRUE(packed->offsets.contains(unembed_id));
+    EXPECT_EQ(packed->offsets.at(embed_id), packed->offsets.at(unembed_id));
+    EXPECT_NE(packed->offsets.at(other_id), packed->offsets.at(embed_id));
+    for (const std::string& id : {embed_id, unembed_id, other_id}) {
+        EXPECT_EQ(packed->sizes.at(id), data.size() * sizeof(float)) << id;
+    }
+
+    // Only two tensors reach .rodata, and the duplicate costs no bytes.
+    ASSERT_EQ(packed->layout.size(), 2u);
+    EXPECT_EQ(packer.packed_tensor_count(), 2u);
+    EXPECT_EQ(packer.deduplicated_tensor_count(), 1u);
+    EXPECT_EQ(packer.deduplicated_bytes(), data.size() * sizeof(float));
+    EXPECT_EQ(packed->rodata_size, packed->layout.back().offset + data.size() * sizeof(float));
+    EXPECT_LT(packed->rodata_size, 3 * data.size() * sizeof(float));
+}
+
+}  // namespace seecpp::backend::testing
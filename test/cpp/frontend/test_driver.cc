@@ -1,9 +1,11 @@
 #include <gtest/gtest.h>
 #include <filesystem>
 #include <fstream>
+#include <thread>
+#include <vector>
 
 #include "source/frontend/frontend_driver.h"
-#include "include/utility/weight_buffer.hpp"
+#include "seecpp/utility/compilation_context.h"
 
 namespace seecpp::frontend::testing {
 
@@ -16,9 +18,7 @@ protected:
     }
 
     void TearDown() override {
-        // CRITICAL: Prevent global state cross-contamination between tests
-        // Assuming WeightBuffer has a clear() or reset() method.
-        seecpp::utility::global_weight_buffer.clear(); 
+        // Weights live in each driver's CompilationContext; nothing global to reset.
         std::filesystem::remove_all(test_dir_);
     }
 
@@ -88,4 +88,53 @@ TEST_F(FrontendDriverIntegrationTest, SerializationIsCurrentlyStubbed) {
     EXPECT_FALSE(std::filesystem::exists(output_bin_));
 }
 
+// 4. Concurrent Compilations Keep Independent State
+TEST_F(FrontendDriverIntegrationTest, ConcurrentDriversReportIntoTheirOwnContexts) {
+    constexpr int kNumCompiles = 4;
+    std::vector<std::unique_ptr<utility::CompilationContext>> contexts;
+    std::vector<int> exit_codes(kNumCompiles, 0);
+    for (int i = 0; i < kNumCompiles; ++i) {
+        contexts.push_back(std::make_unique<utility::CompilationContext>(
+            utility::CompilationOptions{.num_threads = 1}));
+    }
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kNumCompiles; ++i) {
+        threads.emplace_back([&, i] {
+            FrontendDriver::Config config{
+                .input_path = test_dir_ / ("missing_" + std::to_string(i) + ".onnx"),
+                .output_path = test_dir_ / ("out_" + std::to_string(i) + ".see"),
+                .verbose = false
+            };
+            FrontendDriver driver(config, *contexts[i]);
+            exit_codes[i] = driver.Run();
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    for (int i = 0; i < kNumCompiles; ++i) {
+        EXPECT_NE(exit_codes[i], 0);
+        ASSERT_EQ(contexts[i]->diagnostics().GetErrorCount(), 1u);
+        EXPECT_EQ(contexts[i]->diagnostics().diagnostics()[0].phase, "ingest");
+    }
+}
+
+// 5. A Failed Frontend Still Writes the Caller's Time Report
+TEST_F(FrontendDriverIntegrationTest, FailureWritesTimeReportOfCallerOwnedContext) {
+    const auto report_path = test_dir_ / "time_report.json";
+    utility::CompilationContext context(
+        utility::CompilationOptions{.time_report_path = report_path});
+
+    FrontendDriver::Config config{
+        .input_path = test_dir_ / "does_not_exist.onnx",
+        .output_path = output_bin_,
+        .verbose = false
+    };
+    FrontendDriver driver(config, context);
+
+    // The backend will never run, so nobody else would write it.
+    EXPECT_NE(driver.Run(), 0);
+    EXPECT_TRUE(std::filesystem::exists(report_path));
+}
+
 } // namespace seecpp::frontend::testing
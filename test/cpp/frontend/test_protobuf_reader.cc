@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+#include <onnx.pb.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "seecpp/frontend/protobuf_reader.h"
+#include "seecpp/utility/compilation_context.h"
+#include "seecpp/utility/weight_buffer.h"
+
+namespace seecpp::frontend::testing {
+
+namespace {
+sir::DataType ResultType(const sir::Block& block, std::string_view name) {
+    for (const auto& op : block.operations()) {
+        for (const auto& result : op->results()) {
+            if (result->id() == name) return result->dtype();
+        }
+    }
+    ADD_FAILURE() << "no value named " << name;
+    return sir::DataType::F32;
+}
+}  // namespace
+
+TEST(ProtobufReaderTest, NarrowAndUnsignedInitializersPassThrough) {
+    onnx::ModelProto model;
+    onnx::GraphProto* graph = model.mutable_graph();
+
+    // A bool mask in raw_data, as exporters usually write it.
+    onnx::TensorProto* mask = graph->add_initializer();
+    mask->set_name("mask");
+    mask->set_data_type(onnx::TensorProto::BOOL);
+    mask->add_dims(4);
+    mask->set_raw_data(std::string("\x01\x00\x00\x01", 4));
+
+    // The same types in int32_data, the typed-field form.
+    onnx::TensorProto* flags = graph->add_initializer();
+    flags->set_name("flags");
+    flags->set_data_type(onnx::TensorProto::BOOL);
+    flags->add_dims(3);
+    for (int v : {1, 0, 1}) flags->add_int32_data(v);
+
+    onnx::TensorProto* zero_point = graph->add_initializer();
+    zero_point->set_name("zero_point");
+    zero_point->set_data_type(onnx::TensorProto::UINT8);
+    zero_point->add_dims(2);
+    for (int v : {128, 255}) zero_point->add_int32_data(v);
+
+    onnx::TensorProto* lut = graph->add_initializer();
+    lut->set_name("lut");
+    lut->set_data_type(onnx::TensorProto::UINT8);
+    lut->add_dims(3);
+    lut->set_raw_data(std::string("\x07\x80\xff", 3));
+
+    // Signed 16-bit values sit sign-extended in int32_data, uint32 in uint64_data.
+    onnx::TensorProto* offsets = graph->add_initializer();
+    offsets->set_name("offsets");
+    offsets->set_data_type(onnx::TensorProto::INT16);
+    offsets->add_dims(2);
+    for (int v : {-2, 300}) offsets->add_int32_data(v);
+
+    onnx::TensorProto* codes = graph->add_initializer();
+    codes->set_name("codes");
+    codes->set_data_type(onnx::TensorProto::UINT16);
+    codes->add_dims(1);
+    codes->add_int32_data(0xfffe);
+
+    onnx::TensorProto* ids = graph->add_initializer();
+    ids->set_name("ids");
+    ids->set_data_type(onnx::TensorProto::UINT32);
+    ids->add_dims(1);
+    ids->add_uint64_data(0x80000001u);
+
+    onnx::TensorProto* hashes = graph->add_initializer();
+    hashes->set_name("hashes");
+    hashes->set_data_type(onnx::TensorProto::UINT64);
+    hashes->add_dims(1);
+    hashes->add_uint64_data(0x8000000000000001ull);
+
+    onnx::TensorProto* scales = graph->add_initializer();
+    scales->set_name("scales");
+    scales->set_data_type(onnx::TensorProto::FLOAT8E4M3FN);
+    scales->add_dims(2);
+    scales->set_raw_data(std::string("\x38\xc0", 2));
+
+    const auto path = std::filesystem::temp_directory_path() / "seecpp_narrow_initializers.onnx";
+    {
+        std::ofstream out(path, std::ios::binary);
+        ASSERT_TRUE(model.SerializeToOstream(&out));
+    }
+
+    utility::CompilationContext context(utility::CompilationOptions{.num_threads = 2});
+    ProtobufReader reader(context);
+    auto block = reader.ingest(path.string());
+    std::filesystem::remove(path);
+    ASSERT_TRUE(block.has_value()) << block.error().message;
+
+    auto bytes_of = [&](std::string_view name) {
+        auto bytes = context.weights().GetRawBytes(name);
+        return bytes ? std::vector<uint8_t>(bytes->begin(), bytes->end()) : std::vector<uint8_t>{};
+    };
+    EXPECT_EQ(bytes_of("mask"), (std::vector<uint8_t>{1, 0, 0, 1}));
+    EXPECT_EQ(bytes_of("flags"), (std::vector<uint8_t>{1, 0, 1}));
+    EXPECT_EQ(bytes_of("zero_point"), (std::vector<uint8_t>{128, 255}));
+    EXPECT_EQ(bytes_of("lut"), (std::vector<uint8_t>{7, 128, 255}));
+
+    EXPECT_EQ(bytes_of("offsets"), (std::vector<uint8_t>{0xfe, 0xff, 0x2c, 0x01}));
+    EXPECT_EQ(bytes_of("codes"), (std::vector<uint8_t>{0xfe, 0xff}));
+    EXPECT_EQ(bytes_of("ids"), (std::vector<uint8_t>{0x01, 0x00, 0x00, 0x80}));
+    EXPECT_EQ(bytes_of("hashes"), (std::vector<uint8_t>{0x01, 0, 0, 0, 0, 0, 0, 0x80}));
+    EXPECT_EQ(bytes_of("scales"), (std::vector<uint8_t>{0x38, 0xc0}));
+
+    EXPECT_EQ(ResultType(**block, "mask"), sir::DataType::Bool);
+    EXPECT_EQ(ResultType(**block, "zero_point"), sir::DataType::U8);
+    EXPECT_EQ(ResultType(**block, "lut"), sir::DataType::U8);
+    EXPECT_EQ(ResultType(**block, "offsets"), sir::DataType::I16);
+    EXPECT_EQ(ResultType(**block, "codes"), sir::DataType::U16);
+    EXPECT_EQ(ResultType(**block, "ids"), sir::DataType::U32);
+    EXPECT_EQ(ResultType(**block, "hashes"), sir::DataType::U64);
+    // float8 has no SIR dtype; its bytes ride in U8.
+    EXPECT_EQ(ResultType(**block, "scales"), sir::DataType::U8);
+}
+
+TEST(ProtobufReaderTest, InitializersWithoutAFixedWidthAreRejected) {
+    onnx::ModelProto model;
+    onnx::TensorProto* names = model.mutable_graph()->add_initializer();
+    names->set_name("names");
+    names->set_data_type(onnx::TensorProto::STRING);
+    names->add_dims(1);
+    names->add_string_data("a");
+
+    const auto path = std::filesystem::temp_directory_path() / "seecpp_string_initializer.onnx";
+    {
+        std::ofstream out(path, std::ios::binary);
+        ASSERT_TRUE(model.SerializeToOstream(&out));
+    }
+
+    utility::CompilationContext context;
+    ProtobufReader reader(context);
+    auto block = reader.ingest(path.string());
+    std::filesystem::remove(path);
+    ASSERT_FALSE(block.has_value());
+    EXPECT_EQ(block.error().code, IngestErrorCode::UnsupportedDtype);
+}
+
+TEST(ProtobufReaderTest, ExternalAndRawDataResolveToAlignedWeights) {
+    const auto dir = std::filesystem::temp_directory_path() / "seecpp_external_data";
+    std::filesystem::create_directories(dir);
+
+    // Two float tensors in one side file: one at offset 0, one at offset 3.
+    const std::vector<float> aligned = {1.0f, 2.0f, 3.0f, 4.0f};
+    const std::vector<float> shifted = {-1.5f, 0.25f};
+    {
+        std::ofstream side(dir / "weights.bin", std::ios::binary);
+        side.write(reinterpret_cast<const char*>(aligned.data()), 16);
+        side.write("\0\0\0", 3);
+        side.write(reinterpret_cast<const char*>(shifted.data()), 8);
+    }
+
+    onnx::ModelProto model;
+    onnx::GraphProto* graph = model.mutable_graph();
+    const auto add_external = [&](const std::string& name, int64_t count, int offset, int length) {
+        onnx::TensorProto* init = graph->add_initializer();
+        init->set_name(name);
+        init->set_data_type(onnx::TensorProto::FLOAT);
+        init->add_dims(count);
+        init->set_data_location(onnx::TensorProto::EXTERNAL);
+        const auto add_entry = [&](const std::string& key, const std::string& value) {
+            onnx::StringStringEntryProto* entry = init->add_external_data();
+            entry->set_key(key);
+            entry->set_value(value);
+        };
+        add_entry("location", "weights.bin");
+        add_entry("offset", std::to_string(offset));
+        add_entry("length", std::to_string(length));
+    };
+    add_external("aligned", 4, 0, 16);
+    add_external("shifted", 2, 19, 8);
+
+    // raw_data is borrowed from the parsed model wherever it is aligned.
+    const std::vector<float> raw = {0.5f, -0.5f, 8.0f};
+    onnx::TensorProto* inline_init = graph->add_initializer();
+    inline_init->set_name("inline");
+    inline_init->set_data_type(onnx::TensorProto::FLOAT);
+    inline_init->add_dims(3);
+    inline_init->set_raw_data(std::string(reinterpret_cast<const char*>(raw.data()), 12));
+
+    const auto path = dir / "model.onnx";
+    {
+        std::ofstream out(path, std::ios::binary);
+        ASSERT_TRUE(model.SerializeToOstream(&out));
+    }
+
+    utility::CompilationContext context;
+    ProtobufReader reader(context);
+    auto block = reader.ingest(path.string());
+    ASSERT_TRUE(block.has_value()) << block.error().message;
+
+    const auto floats_of = [&](std::string_view name) {
+        auto floats = context.weights().Get<float>(name);
+        EXPECT_TRUE(floats.has_value()) << name;
+        if (!floats) return std::vector<float>{};
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(floats->data()) % alignof(float), 0u) << name;
+        return std::vector<float>(floats->begin(), floats->end());
+    };
+    EXPECT_EQ(floats_of("aligned"), aligned);
+    EXPECT_EQ(floats_of("shifted"), shifted);
+    EXPECT_EQ(floats_of("inline"), raw);
+
+    // Offset 0 of a page-aligned mapping is borrowed; offset 19 is copied.
+    EXPECT_TRUE(context.weights().IsBorrowed("aligned"));
+    EXPECT_FALSE(context.weights().IsBorrowed("shifted"));
+
+    std::filesystem::remove_all(dir);
+}
+
+}  // namespace seecpp::frontend::testing
@@ -0,0 +1,51 @@
+// test/cpp/middle_end/block_fixture.h
+#ifndef SEECPP_TEST_MIDDLE_END_BLOCK_FIXTURE_H_
+#define SEECPP_TEST_MIDDLE_END_BLOCK_FIXTURE_H_
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+
+#include "seecpp/sir/sir.h"
+
+namespace seecpp::middle_end::testing {
+
+/// @brief Base fixture for tests that build a block by hand and run a pass
+/// or a utility over it.
+class BlockFixture : public ::testing::Test {
+ protected:
+  /// @brief Appends `id` on `operands` with one result of the first
+  /// operand's dtype and the given shape.
+  sir::Operation* Append(sir::OpId id,
+                         std::initializer_list<sir::Value*> operands,
+                         sir::Shape shape) {
+    auto* op = block_.appendOp(id);
+    for (sir::Value* v : operands) op->addOperand(v);
+    op->addResult("", (*operands.begin())->dtype(), std::move(shape));
+    return op;
+  }
+
+  /// @brief Elementwise op: the result has the operand's type.
+  sir::Value* Unary(sir::OpId id, sir::Value* in) {
+    return Append(id, {in}, in->shape())->result();
+  }
+
+  /// @brief Elementwise op: the result has the left operand's type.
+  sir::Value* Binary(sir::OpId id, sir::Value* lhs, sir::Value* rhs) {
+    return Append(id, {lhs, rhs}, lhs->shape())->result();
+  }
+
+  size_t Count(sir::OpId id) const {
+    size_t n = 0;
+    for (const sir::Operation* op : block_.operations()) n += op->is(id);
+    return n;
+  }
+
+  sir::Block block_;
+};
+
+}  // namespace seecpp::middle_end::testing
+
+#endif  // SEECPP_TEST_MIDDLE_END_BLOCK_FIXTURE_H_
@@ -0,0 +1,93 @@
+// test/cpp/middle_end/test_cse.cc
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "source/middle_end/transforms/common_subexpression_elimination.h"
+#include "seecpp/sir/sir.h"
+#include "test/cpp/middle_end/block_fixture.h"
+
+namespace seecpp::middle_end::testing {
+
+using transforms::CommonSubexpressionElimination;
+
+using CseTest = BlockFixture;
+
+TEST_F(CseTest, DuplicateChainsCollapseInOneSweep) {
+  sir::Value* x = block_.addArgument(sir::DataType::F32, {8, 4});
+
+  // Two identical transpose -> view_cast chains, as emitted by separate
+  // lowering rules for the same input.
+  sir::Value* ys[2];
+  for (sir::Value*& y : ys) {
+    sir::Value* t = Append(sir::op::kLowTranspose, {x}, {4, 8})->result();
+    auto* view = Append(sir::op::kLowViewCast, {t}, {32});
+    view->setAttribute(sir::attr::kTargetShape, std::vector<int64_t>{32});
+    y = view->result();
+  }
+  auto* ret = block_.appendOp(sir::op::kLowReturn);
+  ret->addOperand(ys[0]);
+  ret->addOperand(ys[1]);
+
+  CommonSubexpressionElimination cse;
+  EXPECT_TRUE(cse.Run(block_));
+  EXPECT_EQ(cse.last_stats().ops_erased, 2u);
+  EXPECT_GT(cse.last_stats().bytes_freed, 0u);
+  EXPECT_EQ(Count(sir::op::kLowTranspose), 1u);
+  EXPECT_EQ(Count(sir::op::kLowViewCast), 1u);
+  EXPECT_EQ(ret->operand(0), ret->operand(1));
+  EXPECT_TRUE(block_.validate());
+
+  EXPECT_FALSE(cse.Run(block_));
+}
+
+TEST_F(CseTest, SourceInfoDoesNotBlockMerging) {
+  sir::Value* x = block_.addArgument(sir::DataType::F32, {8});
+  auto* first = Append(sir::op::kRelu, {x}, {8});
+  auto* second = Append(sir::op::kRelu, {x}, {8});
+  first->setAttribute(sir::attr::kSourceNode, std::string("relu_a"));
+  second->setAttribute(sir::attr::kSourceNode, std::string("relu_b"));
+  second->setAttribute(sir::attr::kSourceOpType, std::string("Relu"));
+  auto* ret = block_.appendOp(sir::op::kReturn);
+  ret->addOperand(first->result());
+  ret->addOperand(second->result());
+
+  CommonSubexpressionElimination cse;
+  EXPECT_TRUE(cse.Run(block_));
+  EXPECT_EQ(Count(sir::op::kRelu), 1u);
+  EXPECT_EQ(ret->operand(0), ret->operand(1));
+}
+
+TEST_F(CseTest, DifferingAttributesOrTypesAreKept) {
+  sir::Value* x = block_.addArgument(sir::DataType::F32, {8, 4});
+
+  auto* a = Append(sir::op::kLowViewCast, {x}, {32});
+  a->setAttribute(sir::attr::kTargetShape, std::vector<int64_t>{32});
+  auto* b = Append(sir::op::kLowViewCast, {x}, {4, 8});
+  b->setAttribute(sir::attr::kTargetShape, std::vector<int64_t>{4, 8});
+
+  // Same opcode and operand, but 0.0 and -0.0 are different constants.
+  auto* pos = block_.appendOp(sir::op::kConstant);
+  pos->setAttribute(sir::attr::kValue, 0.0f);
+  pos->addResult("", sir::DataType::F32, {});
+  auto* neg = block_.appendOp(sir::op::kConstant);
+  neg->setAttribute(sir::attr::kValue, -0.0f);
+  neg->addResult("", sir::DataType::F32, {});
+
+  CommonSubexpressionElimination cse;
+  EXPECT_FALSE(cse.Run(block_));
+  EXPECT_EQ(block_.numOps(), 4u);
+}
+
+TEST_F(CseTest, TerminatorsAreNeverMerged) {
+  sir::Value* x = block_.addArgument(sir::DataType::F32, {4});
+  block_.appendOp(sir::op::kReturn)->addOperand(x);
+  block_.appendOp(sir::op::kReturn)->addOperand(x);
+
+  CommonSubexpressionElimination cse;
+  EXPECT_FALSE(cse.Run(block_));
+  EXPECT_EQ(Count(sir::op::kReturn), 2u);
+}
+
+}  // namespace seecpp::middle_end::testing
@@ -0,0 +1,100 @@
+// test/cpp/middle_end/test_graph_partitioner.cc
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "source/middle_end/manager/graph_partitioner.h"
+#include "seecpp/sir/sir.h"
+#include "seecpp/utility/thread_pool.h"
+#include "test/cpp/middle_end/block_fixture.h"
+
+namespace seecpp::middle_end::testing {
+
+class GraphPartitionerTest : public BlockFixture {
+ protected:
+  // x -> L x [relu, dead relu, add(r, r)] -> return
+  void BuildChain(size_t layers) {
+    x_ = block_.addArgument(sir::DataType::F32, {16});
+    sir::Value* v = x_;
+    for (size_t l = 0; l < layers; ++l) {
+      sir::Value* r = Unary(sir::op::kRelu, v);
+      Unary(sir::op::kRelu, v);  // Never used.
+      v = Binary(sir::op::kAdd, r, r);
+    }
+    block_.appendOp(sir::op::kReturn)->addOperand(v);
+  }
+
+  // Runs `fn` on every partition concurrently, the way the PassManager does.
+  template <typename Fn>
+  void RunConcurrently(PartitionedBlock& parts, Fn fn) {
+    utility::ThreadPool pool(4);
+    pool.ParallelFor(parts.size(), [&](size_t k) {
+      sir::Arena::LaneScope lane(parts.parent().arena(), k);
+      fn(parts.partition(k));
+    });
+  }
+
+  sir::Value* x_ = nullptr;
+};
+
+TEST_F(GraphPartitionerTest, RangesAreContiguousAndSkipTerminators) {
+  BuildChain(100);
+  auto ranges = PartitionBlock(block_, 8, 16);
+  ASSERT_EQ(ranges.size(), 8u);
+
+  size_t covered = 0;
+  sir::Operation* expected_first = block_.front();
+  for (const PartitionRange& r : ranges) {
+    EXPECT_EQ(r.first, expected_first);
+    EXPECT_GE(r.num_ops, 16u);
+    covered += r.num_ops;
+    expected_first = r.last->nextInBlock();
+  }
+  EXPECT_EQ(covered, block_.numOps() - 1);
+  EXPECT_TRUE(expected_first->is(sir::op::kReturn));
+
+  EXPECT_TRUE(PartitionBlock(block_, 8, block_.numOps()).empty());
+}
+
+TEST_F(GraphPartitionerTest, ReplacementsPropagateAcrossBoundaries) {
+  BuildChain(200);
+  const auto ranges = PartitionBlock(block_, 8, 16);
+  ASSERT_GT(ranges.size(), 1u);
+
+  {
+    PartitionedBlock parts(block_, ranges);
+    EXPECT_TRUE(block_.empty());
+
+    // Forward every relu to its input and erase it, including relus whose
+    // result feeds the next partition through the yield.
+    RunConcurrently(parts, [](sir::Block& part) {
+      std::vector<sir::Operation*> relus;
+      for (sir::Operation* op : part.operations())
+        if (op->is(sir::op::kRelu)) relus.push_back(op);
+      for (sir::Operation* op : relus) {
+        op->result()->replaceAllUsesWith(op->operand(0));
+        part.removeOp(op);
+      }
+      // Ops created here come from this partition's lane.
+      auto* scratch = part.appendOp(sir::op::kConstant);
+      scratch->setAttribute(sir::attr::kValue, 1.0f);
+      part.removeOp(scratch);
+    });
+  }
+
+  EXPECT_EQ(Count(sir::op::kRelu), 0u);
+  EXPECT_EQ(Count(sir::op::kAdd), 200u);
+  EXPECT_EQ(Count(sir::op::kYield), 0u);
+  EXPECT_TRUE(block_.validate());
+
+  // The chain is intact: each add consumes the previous one, the first
+  // consumes the block argument, and the return sees the last.
+  sir::Value* expected = x_;
+  for (const sir::Operation* op : block_.operations()) {
+    ASSERT_EQ(op->operand(0), expected);
+    if (op->is(sir::op::kAdd)) expected = op->result();
+  }
+  EXPECT_TRUE(block_.back()->is(sir::op::kReturn));
+}
+
+}  // namespace seecpp::middle_end::testing
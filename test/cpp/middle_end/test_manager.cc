@@ -2,13 +2,21 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <memory>
 #include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "seecpp/middle_end/pass_manager.h"
 #include "seecpp/middle_end/pass_context.h"
 #include "seecpp/middle_end/passes/pass.h"
 #include "seecpp/sir/sir.h"
+#include "seecpp/utility/compilation_context.h"
+#include "source/middle_end/transforms/algebraic_simplifier.h"
+#include "source/middle_end/transforms/dead_code_elimination.h"
 
 namespace seecpp::middle_end::testing {
 
@@ -136,4 +144,232 @@ TEST_F(PassManagerTest, AbortsPipelineImmediatelyOnVerificationFailure) {
   EXPECT_EQ(result.error(), PassError::kVerificationFailed);
 }
 
+// Independent compilations, each with a pool of its own.
+TEST(PassManagerConcurrencyTest, ConcurrentPipelinesRunRealPassesOnTheirOwnPools) {
+  constexpr size_t kNumCompiles = 4;
+  std::vector<std::unique_ptr<utility::CompilationContext>> contexts;
+  std::vector<std::unique_ptr<sir::Block>> blocks;
+  std::vector<size_t> layers;
+  for (size_t i = 0; i < kNumCompiles; ++i) {
+    contexts.push_back(std::make_unique<utility::CompilationContext>());
+    blocks.push_back(std::make_unique<sir::Block>());
+    layers.push_back(64 + 8 * i);
+
+    // relu chain with an unused transpose hanging off every layer.
+    sir::Block& block = *blocks.back();
+    sir::Value* x = block.addArgument(sir::DataType::F32, {8, 8});
+    for (size_t l = 0; l < layers.back(); ++l) {
+      auto* relu = block.appendOp(sir::op::kRelu);
+      relu->addOperand(x);
+      x = relu->addResult("", sir::DataType::F32, {8, 8});
+      auto* dead = block.appendOp(sir::op::kTranspose);
+      dead->addOperand(x);
+      dead->addResult("", sir::DataType::F32, {8, 8});
+    }
+    block.appendOp(sir::op::kReturn)->addOperand(x);
+  }
+
+  std::vector<int> mutated(kNumCompiles, -1);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kNumCompiles; ++i) {
+    threads.emplace_back([&, i] {
+      PassContext context;
+      context.num_threads = 4;
+      context.max_partitions = 8;
+      context.min_partition_ops = 16;
+      PassManager pm(context, contexts[i].get());
+      pm.Add<transforms::DeadCodeElimination>();
+      auto result = pm.Run(*blocks[i]);
+      mutated[i] = result.has_value() ? result.value() : -1;
+    });
+  }
+  for (auto& t : threads) t.join();
+
+  for (size_t i = 0; i < kNumCompiles; ++i) {
+    sir::Block& block = *blocks[i];
+    EXPECT_EQ(mutated[i], 1);
+    EXPECT_EQ(contexts[i]->diagnostics().GetErrorCount(), 0u);
+    ASSERT_EQ(block.numOps(), layers[i] + 1);
+    EXPECT_TRUE(block.validate());
+
+    // The joined block is one unbroken chain from the return to the input.
+    size_t depth = 0;
+    const sir::Value* v = block.back()->operand(0);
+    while (const sir::Operation* def = v->definingOp()) {
+      ASSERT_TRUE(def->is(sir::op::kRelu));
+      ASSERT_EQ(def->parentBlock(), &block);
+      v = def->operand(0);
+      ++depth;
+    }
+    EXPECT_EQ(depth, layers[i]);
+    EXPECT_EQ(v, block.arguments()[0]);
+  }
+}
+
+namespace {
+// relu(relu(x)) -> relu(x). Partition-local, and unable to fold a pair whose
+// inner relu sits in an earlier partition, so it sees the cuts.
+class FoldReluPairs : public Pass {
+ public:
+  explicit FoldReluPairs(std::atomic<size_t>* runs) : runs_(runs) {}
+
+  std::string_view name() const override { return "fold-relu-pairs"; }
+  PassScope scope() const override { return PassScope::kPartition; }
+
+  bool Run(sir::Block& block) override {
+    runs_->fetch_add(1);
+    std::vector<sir::Operation*> folded;
+    for (sir::Operation* op : block.operations()) {
+      const sir::Operation* inner =
+          op->is(sir::op::kRelu) ? op->operand(0)->definingOp() : nullptr;
+      if (inner && inner->is(sir::op::kRelu)) {
+        op->result()->replaceAllUsesWith(op->operand(0));
+        folded.push_back(op);
+      }
+    }
+    for (sir::Operation* op : folded) block.removeOp(op);
+    return !folded.empty();
+  }
+
+ private:
+  std::atomic<size_t>* runs_;
+};
+
+// Each op with its operands as (defining op index, result index), block
+// arguments as (-1, argument index).
+std::vector<std::pair<sir::OpId, std::vector<std::pair<int, int>>>> Structure(
+    const sir::Block& block) {
+  std::unordered_map<const sir::Value*, std::pair<int, int>> where;
+  for (size_t i = 0; i < block.arguments().size(); ++i)
+    where[block.arguments()[i]] = {-1, static_cast<int>(i)};
+  std::vector<std::pair<sir::OpId, std::vector<std::pair<int, int>>>> ops;
+  for (const sir::Operation* op : block.operations()) {
+    std::vector<std::pair<int, int>> operands;
+    for (size_t i = 0; i < op->numOperands(); ++i)
+      operands.push_back(where.at(op->operand(i)));
+    for (size_t r = 0; r < op->numResults(); ++r)
+      where[op->result(r)] = {static_cast<int>(ops.size()), static_cast<int>(r)};
+    ops.emplace_back(op->opId(), std::move(operands));
+  }
+  return ops;
+}
+}  // namespace
+
+TEST(PassManagerConcurrencyTest, OutputDoesNotDependOnTheThreadCount) {
+  // relu -> relu -> add(r2, r1) per layer, plus a transpose nobody uses.
+  const auto build = [](sir::Block& block) {
+    sir::Value* v = block.addArgument(sir::DataType::F32, {8});
+    for (int l = 0; l < 300; ++l) {
+      auto* r1 = block.appendOp(sir::op::kRelu);
+      r1->addOperand(v);
+      sir::Value* a = r1->addResult("", sir::DataType::F32, {8});
+      auto* r2 = block.appendOp(sir::op::kRelu);
+      r2->addOperand(a);
+      sir::Value* b = r2->addResult("", sir::DataType::F32, {8});
+      block.appendOp(sir::op::kTranspose)->addOperand(b);
+      auto* add = block.appendOp(sir::op::kAdd);
+      add->addOperand(b);
+      add->addOperand(a);
+      v = add->addResult("", sir::DataType::F32, {8});
+    }
+    block.appendOp(sir::op::kReturn)->addOperand(v);
+  };
+
+  std::vector<std::pair<sir::OpId, std::vector<std::pair<int, int>>>> serial;
+  for (size_t threads : {1, 2, 4, 7}) {
+    PassContext context;
+    context.num_threads = threads;
+    context.max_partitions = 8;
+    context.min_partition_ops = 32;
+    std::atomic<size_t> runs{0};
+    PassManager pm(context);
+    pm.Add<FoldReluPairs>(&runs);
+    pm.Add<transforms::DeadCodeElimination>();
+
+    sir::Block block;
+    build(block);
+    auto result = pm.Run(block);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(result.value());
+    EXPECT_TRUE(block.validate());
+    // Split the same way at one thread, just not concurrently.
+    EXPECT_EQ(runs.load(), 8u) << threads << " threads";
+
+    if (threads == 1) {
+      serial = Structure(block);
+    } else {
+      EXPECT_EQ(Structure(block), serial) << threads << " threads";
+    }
+  }
+  EXPECT_EQ(serial.size(), 300u * 2 + 1);
+}
+
+TEST(PassManagerConcurrencyTest, SimplifierRunsOnPartitionsConcurrently) {
+  // relu((x * 1) ^ 2) per layer, each constant next to its only use.
+  constexpr int kLayers = 200;
+  const auto build = [](sir::Block& block) {
+    const auto constant = [&](float v) {
+      auto* op = block.appendOp(sir::op::kConstant);
+      op->setAttribute(sir::attr::kValue, v);
+      return op->addResult("", sir::DataType::F32, {8});
+    };
+    sir::Value* x = block.addArgument(sir::DataType::F32, {8});
+    for (int l = 0; l < kLayers; ++l) {
+      sir::Value* one = constant(1);
+      auto* mul = block.appendOp(sir::op::kMul);
+      mul->addOperand(x);
+      mul->addOperand(one);
+      sir::Value* m = mul->addResult("", sir::DataType::F32, {8});
+      sir::Value* two = constant(2);
+      auto* pow = block.appendOp(sir::op::kPow);
+      pow->addOperand(m);
+      pow->addOperand(two);
+      sir::Value* p = pow->addResult("", sir::DataType::F32, {8});
+      auto* relu = block.appendOp(sir::op::kRelu);
+      relu->addOperand(p);
+      x = relu->addResult("", sir::DataType::F32, {8});
+    }
+    block.appendOp(sir::op::kReturn)->addOperand(x);
+  };
+
+  std::vector<std::pair<sir::OpId, std::vector<std::pair<int, int>>>> serial;
+  for (size_t threads : {1, 4}) {
+    PassContext context;
+    context.num_threads = threads;
+    context.max_partitions = 8;
+    context.min_partition_ops = 64;
+    PassManager pm(context);
+    auto simplifier = std::make_unique<transforms::AlgebraicSimplifier>();
+    const transforms::AlgebraicSimplifier* stats = simplifier.get();
+    pm.AddPass(std::move(simplifier));
+    pm.Add<transforms::DeadCodeElimination>();
+
+    sir::Block block;
+    build(block);
+    auto result = pm.Run(block);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(result.value());
+    EXPECT_TRUE(block.validate());
+
+    // Cuts fall between layers, so every identity is in reach: x * 1 is
+    // forwarded and x ^ 2 becomes x * x in each one.
+    EXPECT_EQ(stats->stats().rewrites, 2u * kLayers) << threads << " threads";
+    EXPECT_TRUE(stats->stats().converged);
+    size_t pows = 0, muls = 0;
+    for (const sir::Operation* op : block.operations()) {
+      pows += op->is(sir::op::kPow);
+      muls += op->is(sir::op::kMul);
+    }
+    EXPECT_EQ(pows, 0u);
+    EXPECT_EQ(muls, size_t{kLayers});
+
+    if (threads == 1) {
+      serial = Structure(block);
+    } else {
+      EXPECT_EQ(Structure(block), serial) << threads << " threads";
+    }
+  }
+  EXPECT_EQ(serial.size(), 2u * kLayers + 1);
+}
+
 }  // namespace seecpp::middle_end::testing
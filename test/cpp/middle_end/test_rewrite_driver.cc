@@ -0,0 +1,90 @@
+// test/cpp/middle_end/test_rewrite_driver.cc
+#include <gtest/gtest.h>
+
+#include "source/middle_end/transforms/algebraic_simplifier.h"
+#include "seecpp/sir/rewrite_driver.h"
+#include "seecpp/sir/sir.h"
+#include "test/cpp/middle_end/block_fixture.h"
+
+namespace seecpp::middle_end::testing {
+
+using transforms::AlgebraicSimplifier;
+using sir::ApplyPatternsGreedily;
+using sir::PatternRewriter;
+using sir::RewritePattern;
+using sir::RewritePatternSet;
+
+class RewriteDriverTest : public BlockFixture {
+ protected:
+  // The identities the simplifier looks for hang off constants.
+  sir::Value* Constant(float v, sir::Shape shape = {4}) {
+    auto* op = block_.appendOp(sir::op::kConstant);
+    op->setAttribute(sir::attr::kValue, v);
+    return op->addResult("", sir::DataType::F32, std::move(shape));
+  }
+};
+
+TEST_F(RewriteDriverTest, CascadedIdentitiesCollapseInOneRun) {
+  sir::Value* x = block_.addArgument(sir::DataType::F32, {4});
+  sir::Value* y = Binary(sir::op::kPow, x, Constant(2));
+  y = Binary(sir::op::kMul, y, Constant(1));
+  y = Binary(sir::op::kAdd, y, Constant(0));
+  y = Binary(sir::op::kPow, y, Constant(1));
+  block_.appendOp(sir::op::kReturn)->addOperand(y);
+
+  AlgebraicSimplifier simplifier;
+  EXPECT_TRUE(simplifier.Run(block_));
+
+  // ((x ^ 2) * 1 + 0) ^ 1  ->  x * x
+  EXPECT_EQ(simplifier.stats().rewrites, 4u);
+  EXPECT_TRUE(simplifier.stats().converged);
+  EXPECT_EQ(Count(sir::op::kPow), 0u);
+  EXPECT_EQ(Count(sir::op::kAdd), 0u);
+  ASSERT_EQ(Count(sir::op::kMul), 1u);
+  const sir::Operation* ret = block_.back();
+  EXPECT_TRUE(ret->operand(0)->definingOp()->is(sir::op::kMul));
+  EXPECT_EQ(ret->operand(0)->definingOp()->operand(0), x);
+  EXPECT_TRUE(block_.validate());
+
+  // A second run finds nothing to do.
+  EXPECT_FALSE(simplifier.Run(block_));
+}
+
+TEST_F(RewriteDriverTest, BroadcastingIdentityIsNotForwarded) {
+  // x: [4] plus a [2, 4] zero broadcasts; forwarding x would drop a dimension.
+  sir::Value* x = block_.addArgument(sir::DataType::F32, {4});
+  Append(sir::op::kAdd, {x, Constant(0, {2, 4})}, {2, 4});
+
+  AlgebraicSimplifier simplifier;
+  EXPECT_FALSE(simplifier.Run(block_));
+  EXPECT_EQ(Count(sir::op::kAdd), 1u);
+}
+
+// Two patterns that undo each other must trip the rewrite budget.
+class SwapOperands final : public RewritePattern {
+ public:
+  SwapOperands() : RewritePattern(sir::op::kAdd) {}
+  bool MatchAndRewrite(sir::Operation* op,
+                       PatternRewriter& rewriter) const override {
+    sir::Value* lhs = op->operand(0);
+    op->setOperand(0, op->operand(1));
+    op->setOperand(1, lhs);
+    rewriter.ModifiedOpInPlace(op);
+    return true;
+  }
+};
+
+TEST_F(RewriteDriverTest, CyclicPatternsStopAtTheBudget) {
+  sir::Value* x = block_.addArgument(sir::DataType::F32, {4});
+  sir::Value* y = block_.addArgument(sir::DataType::F32, {4});
+  Binary(sir::op::kAdd, x, y);
+
+  RewritePatternSet patterns;
+  patterns.Add<SwapOperands>();
+  auto stats = ApplyPatternsGreedily(block_, patterns,
+                                     {.max_rewrites_per_op = 3});
+  EXPECT_FALSE(stats.converged);
+  EXPECT_EQ(stats.rewrites, 3u);
+}
+
+}  // namespace seecpp::middle_end::testing
@@ -0,0 +1,244 @@
+// test/cpp/runtime/see_file_fixture.h
+#ifndef SEECPP_TEST_RUNTIME_SEE_FILE_FIXTURE_H_
+#define SEECPP_TEST_RUNTIME_SEE_FILE_FIXTURE_H_
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "source/backend/serializer/schema.h"
+#include "source/utility/hash/crc32c.h"
+
+namespace seecpp::runtime::testing {
+
+/// @brief Assembles a .see file section by section, so runtime tests can
+/// produce layouts the serializer never would: legacy headers, unknown
+/// sections, bad offsets, corrupt bytes.
+class SeeFileWriter {
+ public:
+    /// @brief Appends a section. Write() assigns its offset and, when `flags`
+    /// has kSectionChecksummed, its checksum.
+    void Add(uint32_t type, std::span<const uint8_t> bytes,
+             uint32_t flags = backend::kSectionRequired, uint32_t alignment = 64) {
+        entries_.push_back({type, flags, 0, bytes.size(), alignment, 0});
+        data_.emplace_back(bytes.begin(), bytes.end());
+    }
+
+    template <typename T>
+    void Add(backend::SectionType type, const std::vector<T>& records,
+             uint32_t flags = backend::kSectionRequired, uint32_t alignment = 64) {
+        Add(static_cast<uint32_t>(type),
+            {reinterpret_cast<const uint8_t*>(records.data()), records.size() * sizeof(T)},
+            flags, alignment);
+    }
+
+    /// @brief Lays the sections out after the header and table and writes the
+    /// file. Returns the entries as written, for tests that corrupt them.
+    std::vector<backend::SectionEntry> Write(const std::filesystem::path& path,
+                                             uint64_t instruction_count, uint64_t arena_size) {
+        uint64_t offset = sizeof(backend::FileHeader) + entries_.size() * sizeof(backend::SectionEntry);
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            backend::SectionEntry& entry = entries_[i];
+            offset = (offset + entry.alignment - 1) & ~uint64_t{entry.alignment - 1};
+            entry.offset = offset;
+            if (entry.flags & backend::kSectionChecksummed) entry.checksum = utility::Crc32c(data_[i]);
+            offset += entry.size;
+        }
+
+        backend::FileHeader header{};
+        header.magic = backend::kSeeMagic;
+        header.version = backend::kCurrentVersion;
+        header.arena_size = arena_size;
+        header.instruction_count = instruction_count;
+        header.section_table_offset = sizeof(backend::FileHeader);
+        header.section_count = static_cast<uint32_t>(entries_.size());
+
+        std::vector<uint8_t> file(offset, 0);
+        std::memcpy(file.data(), &header, sizeof(header));
+        std::memcpy(file.data() + sizeof(header), entries_.data(),
+                    entries_.size() * sizeof(backend::SectionEntry));
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            std::memcpy(file.data() + entries_[i].offset, data_[i].data(), data_[i].size());
+        }
+        std::ofstream(path, std::ios::binary)
+            .write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+        return entries_;
+    }
+
+ private:
+    std::vector<backend::SectionEntry> entries_;
+    std::vector<std::vector<uint8_t>> data_;
+};
+
+/// @brief Base fixture for tests that load hand-built .see files. Provides a
+/// scratch directory and a small GEMV + RELU network in either encoding.
+class SeeFileTest : public ::testing::Test {
+ protected:
+    // Two layers: y = relu(A2 * relu(A1 * x + b1) + b2).
+    static constexpr uint32_t kIn = 8;
+    static constexpr uint32_t kHidden = 8;
+    static constexpr uint32_t kOut = 4;
+    // Arena: x at 0, hidden at 64, y at 128.
+    static constexpr uint64_t kHiddenOffset = 64;
+    static constexpr uint64_t kOutputOffset = 128;
+    static constexpr uint64_t kArenaSize = 192;
+    static constexpr uint64_t kInstructionCount = 4;
+
+    void SetUp() override {
+        dir_ = std::filesystem::temp_directory_path() /
+               ("seecpp_runtime_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(dir_); }
+
+    std::filesystem::path Path(const std::string& name) const { return dir_ / name; }
+
+    /// @brief The network's weights: A1, b1, A2, b2 back to back.
+    static std::vector<float> Weights() {
+        std::vector<float> w(kHidden * kIn + kHidden + kOut * kHidden + kOut);
+        for (size_t i = 0; i < w.size(); ++i) w[i] = static_cast<float>((i * 7) % 13) / 13.0f - 0.45f;
+        return w;
+    }
+
+    static std::vector<float> Input() {
+        std::vector<float> x(kIn);
+        for (uint32_t i = 0; i < kIn; ++i) x[i] = static_cast<float>(static_cast<int>(i % 5) - 2) * 0.5f;
+        return x;
+    }
+
+    /// @brief The network evaluated in plain C++.
+    static std::vector<float> Reference() {
+        const std::vector<float> w = Weights();
+        const std::vector<float> x = Input();
+        const float* a1 = w.data();
+        const float* b1 = a1 + kHidden * kIn;
+        const float* a2 = b1 + kHidden;
+        const float* b2 = a2 + kOut * kHidden;
+        std::vector<float> h(kHidden), y(kOut);
+        for (uint32_t i = 0; i < kHidden; ++i) {
+            float s = b1[i];
+            for (uint32_t j = 0; j < kIn; ++j) s += a1[i * kIn + j] * x[j];
+            h[i] = s < 0.0f ? 0.0f : s;
+        }
+        for (uint32_t i = 0; i < kOut; ++i) {
+            float s = b2[i];
+            for (uint32_t j = 0; j < kHidden; ++j) s += a2[i * kHidden + j] * h[j];
+            y[i] = s < 0.0f ? 0.0f : s;
+        }
+        return y;
+    }
+
+    /// @brief Each instruction's operands, inputs first, in either encoding.
+    static std::vector<std::vector<uint64_t>> Operands() {
+        const uint64_t a1 = 0;
+        const uint64_t b1 = a1 + kHidden * kIn * sizeof(float);
+        const uint64_t a2 = b1 + kHidden * sizeof(float);
+        const uint64_t b2 = a2 + kOut * kHidden * sizeof(float);
+        return {{a1, 0, b1, (uint64_t{kHidden} << 32) | kIn, kHiddenOffset},
+                {kHiddenOffset, kHidden},
+                {a2, kHiddenOffset, b2, (uint64_t{kOut} << 32) | kHidden, kOutputOffset},
+                {kOutputOffset, kOut}};
+    }
+
+    static constexpr backend::Opcode kOpcodes[kInstructionCount] = {
+        backend::kGemv, backend::kRelu, backend::kGemv, backend::kRelu};
+
+    /// @brief The network in the fixed 64-byte encoding.
+    static std::vector<backend::SerializedInstruction> FixedText() {
+        const auto operands = Operands();
+        std::vector<backend::SerializedInstruction> text(kInstructionCount);
+        for (size_t i = 0; i < kInstructionCount; ++i) {
+            text[i].opcode = kOpcodes[i];
+            const size_t inputs = kOpcodes[i] == backend::kGemv ? 4 : 2;
+            for (size_t k = 0; k < inputs; ++k) text[i].inputs[k] = operands[i][k];
+            if (inputs < operands[i].size()) text[i].outputs[0] = operands[i][inputs];
+        }
+        return text;
+    }
+
+    /// @brief Adds the network's text (fixed or compact) and .rodata.
+    static void AddNetwork(SeeFileWriter& writer, bool compact, uint32_t flags = backend::kSectionRequired) {
+        const auto operands = Operands();
+        if (compact) {
+            std::vector<backend::CompactInstruction> text;
+            std::vector<uint64_t> pool;
+            for (size_t i = 0; i < kInstructionCount; ++i) {
+                const uint8_t outputs = kOpcodes[i] == backend::kGemv ? 1 : 0;
+                text.push_back({kOpcodes[i], static_cast<uint8_t>(operands[i].size() - outputs), outputs,
+                                static_cast<uint32_t>(pool.size())});
+                pool.insert(pool.end(), operands[i].begin(), operands[i].end());
+            }
+            writer.Add(backend::SectionType::kCompactText, text, flags);
+            writer.Add(backend::SectionType::kOperandPool, pool, flags, 8);
+        } else {
+            writer.Add(backend::SectionType::kText, FixedText(), flags);
+        }
+        writer.Add(backend::SectionType::kRodata, Weights(), flags);
+    }
+
+    /// @brief The strings of one SourceInfo record.
+    struct SourceStrings {
+        std::string node_name, op_type, sir_op, op_sequence, shapes;
+    };
+
+    /// @brief Adds a string table and one SourceInfo per entry of `sources`.
+    /// Equal strings are stored once, as the serializer does.
+    static void AddSourceRecords(SeeFileWriter& writer, const std::vector<SourceStrings>& sources,
+                              uint32_t flags = 0) {
+        std::vector<uint8_t> strings(1, 0);
+        std::map<std::string, uint32_t> interned{{"", 0}};
+        const auto intern = [&](const std::string& s) {
+            auto [it, inserted] = interned.emplace(s, static_cast<uint32_t>(strings.size()));
+            if (inserted) {
+                strings.insert(strings.end(), s.begin(), s.end());
+                strings.push_back(0);
+            }
+            return it->second;
+        };
+        std::vector<backend::SourceInfo> infos(sources.size());
+        for (size_t i = 0; i < sources.size(); ++i) {
+            infos[i].node_name = intern(sources[i].node_name);
+            infos[i].op_type = intern(sources[i].op_type);
+            infos[i].sir_op = intern(sources[i].sir_op);
+            infos[i].op_sequence = intern(sources[i].op_sequence);
+            infos[i].shapes = intern(sources[i].shapes);
+        }
+        writer.Add(backend::SectionType::kStringTable, strings, flags, 1);
+        writer.Add(backend::SectionType::kSourceInfo, infos, flags, 8);
+    }
+
+    /// @brief Adds source info naming instruction i's node `node_names[i]` and its
+    /// SIR op `sir_ops[i]`.
+    static void AddSourceInfo(SeeFileWriter& writer, const std::vector<std::string>& node_names,
+                              const std::vector<std::string>& sir_ops = {}, uint32_t flags = 0) {
+        std::vector<SourceStrings> sources(node_names.size());
+        for (size_t i = 0; i < node_names.size(); ++i) {
+            sources[i].node_name = node_names[i];
+            if (i < sir_ops.size()) sources[i].sir_op = sir_ops[i];
+        }
+        AddSourceRecords(writer, sources, flags);
+    }
+
+    /// @brief Writes the network to `name` and returns its path.
+    std::filesystem::path WriteNetwork(const std::string& name, bool compact) const {
+        SeeFileWriter writer;
+        AddNetwork(writer, compact);
+        writer.Write(Path(name), kInstructionCount, kArenaSize);
+        return Path(name);
+    }
+
+    std::filesystem::path dir_;
+};
+
+}  // namespace seecpp::runtime::testing
+
+#endif  // SEECPP_TEST_RUNTIME_SEE_FILE_FIXTURE_H_
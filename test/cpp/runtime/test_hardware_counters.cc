@@ -0,0 +1,58 @@
+// test/cpp/runtime/test_hardware_counters.cc
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "source/backend/serializer/schema.h"
+#include "source/runtime/hardware_counters.h"
+
+namespace seecpp::runtime::testing {
+
+TEST(HardwareCountersTest, AggregatesPerOpcodeAndDegradesWithoutPmu) {
+    // gemv (4 KiB moved), relu, relu (1 KiB each)
+    HardwareCounterProfiler profiler({backend::kGemv, backend::kRelu, backend::kRelu}, {4096, 1024, 1024});
+
+    const HwReading zero{};
+    profiler.Record(0, zero, HwReading{1000, 500, 64, 8, 1});
+    profiler.Record(1, zero, HwReading{100, 200, 4, 0, 0});
+    profiler.Record(2, zero, HwReading{300, 200, 12, 2, 0});
+
+    const auto stats = profiler.Summarize();
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_EQ(stats[0].opcode, backend::kGemv);
+    EXPECT_DOUBLE_EQ(stats[0].ipc(), 0.5);
+    EXPECT_DOUBLE_EQ(stats[0].misses_per_kib(HwEvent::kL1dMisses), 16.0);
+    EXPECT_EQ(stats[1].samples, 2u);
+    EXPECT_EQ(stats[1].bytes, 2048u);
+    EXPECT_DOUBLE_EQ(stats[1].ipc(), 1.0);
+    EXPECT_DOUBLE_EQ(stats[1].misses_per_kib(HwEvent::kLlcMisses), 1.0);
+
+    // Whether or not this machine exposes a PMU, opening must not fail hard,
+    // and the report must say which case it is.
+    PerfCounterGroup* group = profiler.ThreadGroup();
+    EXPECT_EQ(profiler.ThreadGroup(), group);  // Opened once per thread.
+    const std::string report = profiler.Report();
+    if (group == nullptr) {
+        EXPECT_NE(report.find("Hardware counters unavailable: perf_event_open"), std::string::npos);
+    } else {
+        HwReading reading{};
+        EXPECT_TRUE(group->Read(reading));
+        EXPECT_NE(report.find("IPC"), std::string::npos);
+    }
+}
+
+TEST(HardwareCountersTest, BackwardScaledReadingsCountAsZero) {
+    HardwareCounterProfiler profiler({backend::kGemv}, {1024});
+
+    // The scale factor shrank between the reads, so cycles "went down".
+    profiler.Record(0, HwReading{5000, 100, 0, 0, 0}, HwReading{4800, 300, 0, 0, 0});
+    profiler.Record(0, HwReading{0, 0, 0, 0, 0}, HwReading{400, 200, 0, 0, 0});
+
+    const auto stats = profiler.Summarize();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].samples, 2u);
+    EXPECT_EQ(stats[0].counts[static_cast<size_t>(HwEvent::kCycles)], 400u);
+    EXPECT_EQ(stats[0].counts[static_cast<size_t>(HwEvent::kInstructions)], 400u);
+}
+
+}  // namespace seecpp::runtime::testing
@@ -0,0 +1,85 @@
+// test/cpp/runtime/test_instruction_profiler.cc
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "source/backend/serializer/schema.h"
+#include "source/runtime/instruction_profiler.h"
+
+namespace seecpp::runtime::testing {
+
+TEST(InstructionProfilerTest, RingKeepsNewestSamplesWhileAggregatesKeepAll) {
+    // gemv, relu, relu
+    InstructionProfiler profiler({backend::kGemv, backend::kRelu, backend::kRelu}, ProfilingOptions{.ring_capacity = 5});
+
+    uint64_t t = 1000;
+    for (uint32_t step = 0; step < 3; ++step) {
+        for (uint32_t i = 0; i < 3; ++i) {
+            const uint64_t cost = i == 0 ? 50 : 10;
+            profiler.Record(i, t, t + cost);
+            t += cost;
+        }
+        profiler.OnStepEnd();
+    }
+
+    // Capacity rounds up to 8, so the first of the 9 samples is gone.
+    const std::vector<InstructionSample> samples = profiler.Samples();
+    ASSERT_EQ(samples.size(), 8u);
+    EXPECT_EQ(samples.front().instruction, 1u);
+    EXPECT_EQ(samples.front().step, 0u);
+    EXPECT_EQ(samples.back().instruction, 2u);
+    EXPECT_EQ(samples.back().step, 2u);
+
+    const ProfileSummary summary = profiler.Summarize();
+    EXPECT_EQ(summary.steps, 3u);
+    ASSERT_EQ(summary.by_opcode.size(), 2u);
+    EXPECT_EQ(summary.by_opcode[0].key, backend::kGemv);
+    EXPECT_EQ(summary.by_opcode[0].calls, 3u);
+    EXPECT_EQ(summary.by_opcode[1].calls, 6u);
+    EXPECT_NEAR(summary.by_opcode[0].share, 150.0 / 210.0, 1e-9);
+
+    ASSERT_EQ(summary.by_node.size(), 3u);
+    EXPECT_EQ(summary.by_node[0].key, 0u);
+    EXPECT_EQ(summary.by_node[1].key, 1u);  // Ties keep text order.
+    EXPECT_EQ(summary.by_node[2].opcode, backend::kRelu);
+
+    const std::string trace = profiler.ToChromeTrace(
+        [](uint32_t i) { return "node \"" + std::to_string(i) + "\"\n"; });
+    EXPECT_NE(trace.find("\"name\": \"node \\\"2\\\"\\n\""), std::string::npos);
+    EXPECT_NE(trace.find("\"cat\": \"relu\""), std::string::npos);
+
+    EXPECT_EQ(InstructionProfiler::OpcodeName(999), "unknown");
+
+    profiler.Reset();
+    EXPECT_TRUE(profiler.Samples().empty());
+    EXPECT_TRUE(profiler.Summarize().by_node.empty());
+}
+
+TEST(InstructionProfilerTest, ThroughputIsMeasuredAgainstTheRoofline) {
+    InstructionProfiler profiler({backend::kGemv, backend::kRelu});
+    // A GEMV near the ridge and an in-place RELU with almost no arithmetic.
+    profiler.SetWork({{.flops = 2'000'000, .bytes = 4'000'000}, {.flops = 1'000, .bytes = 8'000}},
+                     MachineRoofline{.peak_gflops = 100, .peak_gbps = 10});
+    for (int step = 0; step < 2; ++step) {
+        profiler.Record(0, 0, 1'000'000);
+        profiler.Record(1, 0, 1'000'000);
+        profiler.OnStepEnd();
+    }
+
+    const ProfileSummary summary = profiler.Summarize();
+    ASSERT_TRUE(summary.has_work);
+    ASSERT_EQ(summary.by_node.size(), 2u);
+    const ProfileEntry& gemv = summary.by_node[0];
+    EXPECT_NEAR(gemv.gflops, 4e6 / gemv.total_ns, 1e-9);
+    EXPECT_NEAR(gemv.gbps, 8e6 / gemv.total_ns, 1e-9);
+    // At 0.5 FLOP/byte the roofline allows 5 GFLOP/s.
+    EXPECT_NEAR(gemv.roofline_fraction, gemv.gflops / 5.0, 1e-9);
+    EXPECT_NEAR(summary.by_node[1].roofline_fraction, summary.by_node[1].gflops / 1.25, 1e-9);
+
+    // Equal time, but the RELU is further below its ceiling, so it leads.
+    const std::string report = profiler.RooflineReport();
+    EXPECT_LT(report.find("relu#1"), report.find("gemv#0"));
+}
+
+}  // namespace seecpp::runtime::testing
@@ -0,0 +1,425 @@
+// test/cpp/runtime/test_runtime_engine.cc
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "source/runtime/runtime_engine.h"
+#include "test/cpp/runtime/see_file_fixture.h"
+
+namespace seecpp::runtime::testing {
+
+class RuntimeEngineTest : public SeeFileTest {
+ protected:
+    // Runs the network once and returns its output.
+    static std::vector<float> RunNetwork(RuntimeEngine& engine) {
+        const std::vector<float> input = Input();
+        EXPECT_TRUE(engine.SetInput(input.data(), input.size()));
+        const auto invoked = engine.Invoke();
+        EXPECT_TRUE(invoked) << (invoked ? "" : invoked.error().message);
+        const float* out = engine.GetOutput(kOutputOffset);
+        return out ? std::vector<float>(out, out + kOut) : std::vector<float>{};
+    }
+
+    // Overwrites (or extends the file with) `size` bytes at `offset`.
+    void WriteBytes(const std::string& name, uint64_t offset, const void* data, size_t size) const {
+        std::fstream file(Path(name), std::ios::binary | std::ios::in | std::ios::out);
+        if (!file) file.open(Path(name), std::ios::binary | std::ios::out);
+        file.seekp(static_cast<std::streamoff>(offset));
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    }
+};
+
+TEST_F(RuntimeEngineTest, CompactEncodingMatchesTheFixedEncoding) {
+    RuntimeEngine fixed, compact;
+    ASSERT_TRUE(fixed.Load(WriteNetwork("fixed.see", false).string()));
+    ASSERT_TRUE(compact.Load(WriteNetwork("compact.see", true).string()));
+    ASSERT_FALSE(compact.Section(backend::SectionType::kCompactText).empty());
+    ASSERT_TRUE(compact.Section(backend::SectionType::kText).empty());
+
+    const std::vector<float> expected = RunNetwork(fixed);
+    EXPECT_EQ(RunNetwork(compact), expected);
+    ASSERT_EQ(expected.size(), kOut);
+    for (uint32_t i = 0; i < kOut; ++i) EXPECT_NEAR(expected[i], Reference()[i], 1e-5f) << i;
+}
+
+TEST_F(RuntimeEngineTest, ThreadedCodeMatchesTheInterpreter) {
+    if (!ThreadedCode::Supported()) GTEST_SKIP() << "No code emitter for this host";
+
+    for (const bool compact : {false, true}) {
+        const auto path = WriteNetwork(compact ? "compact.see" : "fixed.see", compact);
+        RuntimeEngine interpreted, threaded;
+        ASSERT_TRUE(interpreted.Load(path.string()));
+        ASSERT_TRUE(threaded.Load(path.string(), LoadOptions{.jit = true}));
+        ASSERT_EQ(interpreted.threaded_code(), nullptr);
+        ASSERT_NE(threaded.threaded_code(), nullptr) << "compact=" << compact;
+
+        // Twice, so the second run starts from the first one's arena.
+        for (int run = 0; run < 2; ++run) {
+            EXPECT_EQ(RunNetwork(threaded), RunNetwork(interpreted)) << "compact=" << compact;
+        }
+    }
+}
+
+TEST_F(RuntimeEngineTest, ThreadedCodeFallsBackOnAnUnknownOpcode) {
+    SeeFileWriter writer;
+    writer.Add(backend::SectionType::kCompactText, std::vector<backend::CompactInstruction>{{99, 0, 0, 0}});
+    writer.Add(backend::SectionType::kOperandPool, std::vector<uint64_t>{0}, backend::kSectionRequired, 8);
+    writer.Add(backend::SectionType::kRodata, std::vector<uint8_t>(64));
+    writer.Write(Path("unknown.see"), 1, 64);
+
+    RuntimeEngine engine;
+    ASSERT_TRUE(engine.Load(Path("unknown.see").string(), LoadOptions{.jit = true}));
+    EXPECT_EQ(engine.threaded_code(), nullptr);
+    const auto invoked = engine.Invoke();
+    ASSERT_FALSE(invoked);
+    EXPECT_NE(invoked.error().message.find("unknown hardware opcode 99"), std::string::npos);
+}
+
+TEST_F(RuntimeEngineTest, ProfilingTracesEveryInstructionUnderItsNodeName) {
+    SeeFileWriter writer;
+    AddNetwork(writer, true);
+    AddSourceInfo(writer, {"fc1", "fc1/relu", "fc\t\"2\"", ""}, {"", "", "", "sc_low.relu"});
+    writer.Write(Path("named.see"), kInstructionCount, kArenaSize);
+
+    RuntimeEngine engine;
+    ASSERT_TRUE(engine.Load(Path("named.see").string()));
+    const auto enabled = engine.EnableProfiling();
+    if (!kProfilingCompiledIn) {
+        EXPECT_FALSE(enabled);
+        GTEST_SKIP() << "Profiling is compiled out";
+    }
+    ASSERT_TRUE(enabled) << enabled.error().message;
+    RunNetwork(engine);
+    RunNetwork(engine);
+
+    ASSERT_NE(engine.profiler(), nullptr);
+    const std::vector<InstructionSample> samples = engine.profiler()->Samples();
+    ASSERT_EQ(samples.size(), 2 * kInstructionCount);
+    for (size_t k = 0; k < samples.size(); ++k) {
+        EXPECT_EQ(samples[k].instruction, k % kInstructionCount);
+        EXPECT_EQ(samples[k].step, k / kInstructionCount);
+        EXPECT_LE(samples[k].start, samples[k].end);
+    }
+
+    const std::string trace = engine.profiler()->ToChromeTrace(
+        [&](uint32_t i) { return engine.InstructionName(i); });
+    EXPECT_NE(trace.find("\"name\": \"fc1/relu\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\": \"fc\\t\\\"2\\\"\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\": \"sc_low.relu#3\""), std::string::npos);
+    EXPECT_NE(trace.find("\"cat\": \"gemv\""), std::string::npos);
+    EXPECT_NE(trace.find("\"cat\": \"relu\""), std::string::npos);
+}
+
+TEST_F(RuntimeEngineTest, ProfilerThroughputComesFromTheCostTable) {
+    // Two GEMVs with bias and two RELUs, costed as the CostAnnotator would.
+    const std::vector<backend::InstructionCost> costs = {
+        {2 * kHidden * kIn + kHidden, (kHidden * kIn + kIn + kHidden) * 4, kHidden * 4},
+        {kHidden, kHidden * 4, kHidden * 4},
+        {2 * kOut * kHidden + kOut, (kOut * kHidden + kHidden + kOut) * 4, kOut * 4},
+        {kOut, kOut * 4, kOut * 4},
+    };
+    const auto write = [&](const std::string& name, size_t records) {
+        SeeFileWriter writer;
+        AddNetwork(writer, true);
+        writer.Add(backend::SectionType::kInstructionCost,
+                   std::vector<backend::InstructionCost>(costs.begin(), costs.begin() + records), 0, 8);
+        writer.Write(Path(name), kInstructionCount, kArenaSize);
+        return Path(name);
+    };
+
+    RuntimeEngine engine;
+    ASSERT_TRUE(engine.Load(write("costed.see", costs.size()).string()));
+    const auto enabled = engine.EnableProfiling();
+    if (!kProfilingCompiledIn) GTEST_SKIP() << "Profiling is compiled out";
+    ASSERT_TRUE(enabled) << enabled.error().message;
+    for (int step = 0; step < 3; ++step) RunNetwork(engine);
+
+    const ProfileSummary summary = engine.profiler()->Summarize();
+    ASSERT_TRUE(summary.has_work);
+    ASSERT_EQ(summary.by_node.size(), kInstructionCount);
+    for (const ProfileEntry& e : summary.by_node) {
+        ASSERT_LT(e.key, costs.size());
+        EXPECT_EQ(e.calls, 3u);
+        if (e.total_ns <= 0) continue;
+        // GFLOP/s times nanoseconds gives back the FLOPs of every call.
+        const backend::InstructionCost& cost = costs[e.key];
+        EXPECT_NEAR(e.gflops * e.total_ns, 3.0 * cost.flops, 1e-6 * cost.flops) << e.key;
+        EXPECT_NEAR(e.gbps * e.total_ns, 3.0 * (cost.bytes_read + cost.bytes_written), 1e-3) << e.key;
+    }
+
+    // A table that does not cover every instruction is ignored.
+    RuntimeEngine partial;
+    ASSERT_TRUE(partial.Load(write("partial.see", costs.size() - 1).string()));
+    ASSERT_TRUE(partial.EnableProfiling());
+    RunNetwork(partial);
+    EXPECT_FALSE(partial.profiler()->Summarize().has_work);
+}
+
+TEST_F(RuntimeEngineTest, SourceOfReadsEveryFieldBackFromTheStringTable) {
+    const std::vector<SourceStrings> sources = {
+        {"fc1", "Gemm", "sc_low.matmul", "", "f32[8], f32[8,8] -> f32[8]"},
+        {"fc1/relu", "Relu", "sc_low.relu", "", "f32[8] -> f32[8]"},
+        {"fc2+fc2/relu", "Gemm+Relu", "sc_low.matmul", "add,relu", "f32[8], f32[4,8] -> f32[4]"},
+        {"", "", "sc_low.relu", "", ""},
+    };
+    SeeFileWriter writer;
+    AddNetwork(writer, true);
+    AddSourceRecords(writer, sources);
+    writer.Write(Path("sourced.see"), kInstructionCount, kArenaSize);
+
+    RuntimeEngine engine;
+    ASSERT_TRUE(engine.Load(Path("sourced.see").string()));
+    for (size_t i = 0; i < sources.size(); ++i) {
+        const std::optional<InstructionSource> source = engine.SourceOf(i);
+        ASSERT_TRUE(source.has_value()) << i;
+        EXPECT_EQ(source->node_name, sources[i].node_name) << i;
+        EXPECT_EQ(source->op_type, sources[i].op_type) << i;
+        EXPECT_EQ(source->sir_op, sources[i].sir_op) << i;
+        EXPECT_EQ(source->op_sequence, sources[i].op_sequence) << i;
+        EXPECT_EQ(source->shapes, sources[i].shapes) << i;
+    }
+    EXPECT_FALSE(engine.SourceOf(kInstructionCount).has_value());
+
+    // Named by node, else by SIR op and index.
+    EXPECT_EQ(engine.InstructionName(0), "fc1");
+    EXPECT_EQ(engine.InstructionName(2), "fc2+fc2/relu");
+    EXPECT_EQ(engine.InstructionName(3), "sc_low.relu#3");
+}
+
+TEST_F(RuntimeEngineTest, SourceInfoToleratesMissingOrTruncatedSections) {
+    // No source info at all.
+    RuntimeEngine bare;
+    ASSERT_TRUE(bare.Load(WriteNetwork("bare.see", true).string()));
+    EXPECT_FALSE(bare.SourceOf(0).has_value());
+    EXPECT_EQ(bare.InstructionName(1), "#1");
+
+    // A record per instruction, but offsets past the end of the string table.
+    SeeFileWriter writer;
+    AddNetwork(writer, true);
+    std::vector<backend::SourceInfo> infos(kInstructionCount);
+    infos[0] = {1, 0, 1000, 0, 0, 0};
+    writer.Add(backend::SectionType::kStringTable, std::vector<uint8_t>{0, 'f', 'c'}, 0, 1);
+    writer.Add(backend::SectionType::kSourceInfo, infos, 0, 8);
+    writer.Write(Path("truncated.see"), kInstructionCount, kArenaSize);
+
+    RuntimeEngine truncated;
+    ASSERT_TRUE(truncated.Load(Path("truncated.see").string()));
+    const std::optional<InstructionSource> source = truncated.SourceOf(0);
+    ASSERT_TRUE(source.has_value());
+    // "fc" has no terminator, and 1000 is outside the table.
+    EXPECT_TRUE(source->node_name.empty());
+    EXPECT_TRUE(source->sir_op.empty());
+    EXPECT_EQ(truncated.InstructionName(0), "#0");
+}
+
+TEST_F(RuntimeEngineTest, UnknownOpcodeErrorsDescribeTheInstructionSource) {
+    const auto write = [&](const std::string& name, bool with_source) {
+        std::vector<backend::SerializedInstruction> text = FixedText();
+        text[1].opcode = 99;
+        SeeFileWriter writer;
+        writer.Add(backend::SectionType::kText, text);
+        writer.Add(backend::SectionType::kRodata, Weights());
+        if (with_source) {
+            AddSourceRecords(writer, {{"fc1", "Gemm", "sc_low.matmul", "", ""},
+                                      {"fc1/act", "Gelu", "sc_low.gelu", "mul,tanh", "f32[8] -> f32[8]"},
+                                      {"fc2", "Gemm", "sc_low.matmul", "", ""},
+                                      {"fc2/relu", "Relu", "sc_low.relu", "", ""}});
+        }
+        writer.Write(Path(name), kInstructionCount, kArenaSize);
+        return Path(name);
+    };
+
+    RuntimeEngine sourced;
+    ASSERT_TRUE(sourced.Load(write("sourced.see", true).string()));
+    const auto failed = sourced.Invoke();
+    ASSERT_FALSE(failed);
+    EXPECT_NE(failed.error().message.find(
+                  "at instruction 1 (node 'fc1/act', Gelu lowered to sc_low.gelu [mul,tanh], f32[8] -> f32[8])"),
+              std::string::npos)
+        << failed.error().message;
+
+    RuntimeEngine bare;
+    ASSERT_TRUE(bare.Load(write("bare.see", false).string()));
+    const auto bare_failed = bare.Invoke();
+    ASSERT_FALSE(bare_failed);
+    EXPECT_NE(bare_failed.error().message.find("(no source info in this file)"), std::string::npos)
+        << bare_failed.error().message;
+}
+
+TEST_F(RuntimeEngineTest, LoadsVersionOneFiles) {
+    // Header, then .text at 64 and .rodata right after it; no section table.
+    const std::vector<backend::SerializedInstruction> text = FixedText();
+    const std::vector<float> weights = Weights();
+
+    backend::LegacyFileHeader legacy{};
+    legacy.magic = backend::kSeeMagic;
+    legacy.version = backend::kLegacyVersion;
+    legacy.arena_size = kArenaSize;
+    legacy.text_offset = sizeof(legacy);
+    legacy.text_size = kInstructionCount;
+    legacy.rodata_offset = legacy.text_offset + kInstructionCount * sizeof(backend::SerializedInstruction);
+    legacy.rodata_size = weights.size() * sizeof(float);
+    WriteBytes("v1.see", 0, &legacy, sizeof(legacy));
+    WriteBytes("v1.see", legacy.text_offset, text.data(), text.size() * sizeof(text[0]));
+    WriteBytes("v1.see", legacy.rodata_offset, weights.data(), legacy.rodata_size);
+
+    RuntimeEngine v1, v2;
+    const auto loaded = v1.Load(Path("v1.see").string());
+    ASSERT_TRUE(loaded) << loaded.error().message;
+    ASSERT_TRUE(v2.Load(WriteNetwork("v2.see", false).string()));
+    EXPECT_EQ(v1.Section(backend::SectionType::kRodata).size(), legacy.rodata_size);
+    EXPECT_TRUE(v1.Section(backend::SectionType::kSourceInfo).empty());
+    EXPECT_EQ(RunNetwork(v1), RunNetwork(v2));
+}
+
+TEST_F(RuntimeEngineTest, SkipsUnknownOptionalSections) {
+    SeeFileWriter writer;
+    AddNetwork(writer, true);
+    const std::vector<uint8_t> future(100'000, 0xAB);
+    writer.Add(200, future, /*flags=*/0, 4096);
+    writer.Write(Path("future.see"), kInstructionCount, kArenaSize);
+
+    RuntimeEngine engine;
+    const auto loaded = engine.Load(Path("future.see").string());
+    ASSERT_TRUE(loaded) << loaded.error().message;
+    EXPECT_EQ(RunNetwork(engine), Reference());
+}
+
+TEST_F(RuntimeEngineTest, RefusesUnknownRequiredSections) {
+    SeeFileWriter writer;
+    AddNetwork(writer, true);
+    writer.Add(200, std::vector<uint8_t>(64), backend::kSectionRequired);
+    writer.Write(Path("future.see"), kInstructionCount, kArenaSize);
+
+    RuntimeEngine engine;
+    const auto loaded = engine.Load(Path("future.see").string());
+    ASSERT_FALSE(loaded);
+    EXPECT_NE(loaded.error().message.find("requires section type 200"), std::string::npos)
+        << loaded.error().message;
+}
+
+TEST_F(RuntimeEngineTest, RejectsSectionsOutsideTheFile) {
+    SeeFileWriter writer;
+    AddNetwork(writer, false);
+    const std::vector<backend::SectionEntry> entries = writer.Write(Path("net.see"), kInstructionCount, kArenaSize);
+    const uint64_t file_size = std::filesystem::file_size(Path("net.see"));
+    ASSERT_EQ(entries[1].type, static_cast<uint32_t>(backend::SectionType::kRodata));
+
+    // Each case rewrites one field of the pristine file.
+    struct Case {
+        const char* what;
+        uint64_t offset;
+        uint64_t value;
+        size_t width;
+    };
+    const uint64_t rodata_entry = sizeof(backend::FileHeader) + sizeof(backend::SectionEntry);
+    const Case cases[] = {
+        {"offset past the end", rodata_entry + offsetof(backend::SectionEntry, offset), file_size + 64, 8},
+        {"size past the end", rodata_entry + offsetof(backend::SectionEntry, size), file_size, 8},
+        {"offset + size wraps", rodata_entry + offsetof(backend::SectionEntry, size), UINT64_MAX - 63, 8},
+        {"table past the end", offsetof(backend::FileHeader, section_table_offset), file_size - 16, 8},
+        {"table count past the end", offsetof(backend::FileHeader, section_count), uint64_t{1} << 31, 4},
+        // count * 64 wraps around to the real .text size.
+        {"instruction count wraps", offsetof(backend::FileHeader, instruction_count),
+         kInstructionCount + (uint64_t{1} << 58), 8},
+    };
+
+    for (const Case& c : cases) {
+        std::filesystem::copy_file(Path("net.see"), Path("bad.see"),
+                                   std::filesystem::copy_options::overwrite_existing);
+        WriteBytes("bad.see", c.offset, &c.value, c.width);
+        RuntimeEngine engine;
+        EXPECT_FALSE(engine.Load(Path("bad.see").string())) << c.what;
+    }
+}
+
+TEST_F(RuntimeEngineTest, MapsOptionalSectionsOnFirstRequest) {
+    SeeFileWriter writer;
+    AddNetwork(writer, true);
+    AddSourceInfo(writer, {"fc1", "fc1/relu", "fc2", "fc2/relu"});
+    writer.Write(Path("named.see"), kInstructionCount, kArenaSize);
+
+    RuntimeEngine engine;
+    ASSERT_TRUE(engine.Load(Path("named.see").string()));
+    EXPECT_TRUE(engine.Section(backend::SectionType::kInstructionCost).empty());
+
+    // Concurrent first requests all see one mapping.
+    std::vector<const uint8_t*> seen(8);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < seen.size(); ++t) {
+        threads.emplace_back([&, t] { seen[t] = engine.Section(backend::SectionType::kSourceInfo).data(); });
+    }
+    for (std::thread& t : threads) t.join();
+    const std::span<const uint8_t> infos = engine.Section(backend::SectionType::kSourceInfo);
+    ASSERT_EQ(infos.size(), kInstructionCount * sizeof(backend::SourceInfo));
+    for (const uint8_t* p : seen) EXPECT_EQ(p, infos.data());
+
+    EXPECT_EQ(engine.InstructionName(2), "fc2");
+    ASSERT_TRUE(engine.SourceOf(3));
+    EXPECT_EQ(engine.SourceOf(3)->node_name, "fc2/relu");
+    EXPECT_EQ(RunNetwork(engine), Reference());
+}
+
+TEST_F(RuntimeEngineTest, VerifyingChecksumsRejectsAFlippedByte) {
+    SeeFileWriter writer;
+    AddNetwork(writer, true, backend::kSectionRequired | backend::kSectionChecksummed);
+    const auto entries = writer.Write(Path("net.see"), kInstructionCount, kArenaSize);
+    ASSERT_EQ(entries[2].type, static_cast<uint32_t>(backend::SectionType::kRodata));
+    {
+        RuntimeEngine engine;
+        ASSERT_TRUE(engine.Load(Path("net.see").string(), LoadOptions{.verify_checksums = true}));
+    }
+
+    // One bit of one weight.
+    uint8_t byte = 0;
+    std::ifstream in(Path("net.see"), std::ios::binary);
+    in.seekg(static_cast<std::streamoff>(entries[2].offset + 37));
+    in.read(reinterpret_cast<char*>(&byte), 1);
+    byte ^= 0x10;
+    WriteBytes("net.see", entries[2].offset + 37, &byte, 1);
+
+    RuntimeEngine verified;
+    const auto loaded = verified.Load(Path("net.see").string(), LoadOptions{.verify_checksums = true});
+    ASSERT_FALSE(loaded);
+    EXPECT_NE(loaded.error().message.find("Checksum mismatch in section of type 2"), std::string::npos)
+        << loaded.error().message;
+
+    // Without verification the corruption goes unnoticed.
+    RuntimeEngine trusting;
+    EXPECT_TRUE(trusting.Load(Path("net.see").string()));
+}
+
+TEST_F(RuntimeEngineTest, SectionDropsACorruptOptionalSection) {
+    SeeFileWriter writer;
+    AddNetwork(writer, true, backend::kSectionRequired | backend::kSectionChecksummed);
+    AddSourceInfo(writer, {"fc1", "fc1/relu", "fc2", "fc2/relu"}, {}, backend::kSectionChecksummed);
+    const auto entries = writer.Write(Path("named.see"), kInstructionCount, kArenaSize);
+    const backend::SectionEntry& infos = entries.back();
+    ASSERT_EQ(infos.type, static_cast<uint32_t>(backend::SectionType::kSourceInfo));
+    const uint32_t bogus = 0xFFFF;
+    WriteBytes("named.see", infos.offset + 2 * sizeof(backend::SourceInfo), &bogus, sizeof(bogus));
+
+    // Optional sections are only verified once mapped, so the load succeeds.
+    RuntimeEngine engine;
+    ASSERT_TRUE(engine.Load(Path("named.see").string(), LoadOptions{.verify_checksums = true}));
+    EXPECT_TRUE(engine.Section(backend::SectionType::kSourceInfo).empty());
+    EXPECT_TRUE(engine.Section(backend::SectionType::kSourceInfo).empty());
+    EXPECT_FALSE(engine.Section(backend::SectionType::kStringTable).empty());
+    EXPECT_FALSE(engine.SourceOf(2));
+    EXPECT_EQ(engine.InstructionName(2), "#2");
+    EXPECT_EQ(RunNetwork(engine), Reference());
+
+    // Unverified, the same bytes are handed out as they are.
+    RuntimeEngine trusting;
+    ASSERT_TRUE(trusting.Load(Path("named.see").string()));
+    EXPECT_EQ(trusting.Section(backend::SectionType::kSourceInfo).size(), infos.size);
+}
+
+}  // namespace seecpp::runtime::testing
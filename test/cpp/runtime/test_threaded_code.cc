@@ -0,0 +1,60 @@
+// test/cpp/runtime/test_threaded_code.cc
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "source/runtime/threaded_code.h"
+
+namespace seecpp::runtime::testing {
+
+namespace {
+std::vector<std::array<uint64_t, 6>> g_calls;
+
+void RecordSix(uint64_t a, uint64_t b, uint64_t c, uint64_t d, uint64_t e, uint64_t f) {
+    g_calls.push_back({a, b, c, d, e, f});
+}
+
+void RecordTwo(uint64_t a, uint64_t b) {
+    g_calls.push_back({a, b, 0, 0, 0, ~uint64_t{0}});
+}
+}  // namespace
+
+TEST(ThreadedCodeTest, CallsEveryKernelInOrderWithItsArguments) {
+    if (!ThreadedCode::Supported()) GTEST_SKIP() << "No code emitter for this host";
+
+    // Both immediate widths: values that fit in 32 bits and ones that do not.
+    const std::vector<KernelCall> calls = {
+        {reinterpret_cast<const void*>(&RecordSix),
+         {1, 0xFFFFFFFF, 0x100000000, 0x7FFF123456789ABC, 0, 0xFEDCBA9876543210}, 6},
+        {reinterpret_cast<const void*>(&RecordTwo), {0xDEADBEEFCAFE, 42}, 2},
+        {reinterpret_cast<const void*>(&RecordSix), {6, 5, 4, 3, 2, 1}, 6},
+    };
+    auto code = ThreadedCode::Compile(calls);
+    ASSERT_TRUE(code.has_value()) << code.error();
+    EXPECT_GT((*code)->code_size(), 0u);
+
+    g_calls.clear();
+    (*code)->Run();
+    (*code)->Run();
+    ASSERT_EQ(g_calls.size(), 6u);
+    EXPECT_EQ(g_calls[0], (std::array<uint64_t, 6>{1, 0xFFFFFFFF, 0x100000000, 0x7FFF123456789ABC, 0,
+                                                   0xFEDCBA9876543210}));
+    EXPECT_EQ(g_calls[1][0], 0xDEADBEEFCAFEu);
+    EXPECT_EQ(g_calls[1][1], 42u);
+    EXPECT_EQ(g_calls[2], (std::array<uint64_t, 6>{6, 5, 4, 3, 2, 1}));
+    EXPECT_EQ(g_calls[3], g_calls[0]);
+}
+
+TEST(ThreadedCodeTest, RejectsCallsItCannotEmit) {
+    if (!ThreadedCode::Supported()) GTEST_SKIP() << "No code emitter for this host";
+    const KernelCall no_target{nullptr, {}, 0};
+    EXPECT_FALSE(ThreadedCode::Compile({&no_target, 1}).has_value());
+
+    auto empty = ThreadedCode::Compile({});
+    ASSERT_TRUE(empty.has_value());
+    (*empty)->Run();
+}
+
+}  // namespace seecpp::runtime::testing
@@ -0,0 +1,167 @@
+// test/cpp/runtime/test_weight_streamer.cc
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "source/backend/serializer/schema.h"
+#include "source/runtime/weight_streamer.h"
+
+namespace seecpp::runtime::testing {
+
+namespace {
+struct Advice {
+    uintptr_t addr;
+    int advice;
+};
+
+std::mutex g_mutex;
+std::vector<Advice> g_advice;
+
+int RecordAdvice(void* addr, size_t /*length*/, int advice) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_advice.push_back({reinterpret_cast<uintptr_t>(addr), advice});
+    return 0;
+}
+
+std::vector<Advice> Snapshot() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    return g_advice;
+}
+
+// Polls until `done` holds for the recorded advice; the helper runs async.
+template <typename Pred>
+std::vector<Advice> WaitFor(Pred done) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    std::vector<Advice> advice = Snapshot();
+    while (!done(advice) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        advice = Snapshot();
+    }
+    return advice;
+}
+
+size_t Count(const std::vector<Advice>& advice, int kind) {
+    size_t n = 0;
+    for (const Advice& a : advice) n += a.advice == kind;
+    return n;
+}
+
+constexpr size_t kPage = 4096;
+// Never dereferenced; the recorder only compares addresses.
+alignas(kPage) const uint8_t g_rodata[1] = {};
+}  // namespace
+
+class WeightStreamerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_advice.clear();
+    }
+
+    // Instruction i reads one page-sized weight at page i.
+    static std::vector<backend::WeightRef> OneWeightPerInstruction(uint32_t n) {
+        std::vector<backend::WeightRef> refs;
+        for (uint32_t i = 0; i < n; ++i) refs.push_back({i, 0, i * kPage, kPage});
+        return refs;
+    }
+
+    // Page index of a recorded address.
+    static std::optional<size_t> PageOf(const Advice& a) {
+        const auto base = reinterpret_cast<uintptr_t>(g_rodata);
+        if (a.addr < base) return std::nullopt;
+        return (a.addr - base) / kPage;
+    }
+};
+
+TEST_F(WeightStreamerTest, PrefetchRunsAheadInOrderAndEvictsBehind) {
+    constexpr uint32_t kNum = 16;
+    const auto refs = OneWeightPerInstruction(kNum);
+    WeightStreamer streamer(g_rodata, refs, kNum,
+                            StreamingOptions{.lookahead = 2, .advise = RecordAdvice});
+    WaitFor([](const std::vector<Advice>& a) { return Count(a, MADV_WILLNEED) >= 3; });
+
+    // Step in lockstep with the helper so every position is observed.
+    for (size_t i = 0; i < kNum; ++i) {
+        streamer.OnInstruction(i);
+        WaitFor([&](const std::vector<Advice>& a) { return Count(a, MADV_WILLNEED) >= i + 3; });
+    }
+    const std::vector<Advice> advice = Snapshot();
+
+    // The window wraps onto weights 0 and 1 of the next step.
+    std::vector<size_t> prefetched, evicted;
+    for (const Advice& a : advice) {
+        (a.advice == MADV_WILLNEED ? prefetched : evicted).push_back(*PageOf(a));
+    }
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < kNum + 2; ++i) expected.push_back(i % kNum);
+    EXPECT_EQ(prefetched, expected);
+
+    // Each weight is dropped once its instruction has passed, and only after
+    // it was fetched; the last one stays until the step ends.
+    expected.clear();
+    for (size_t i = 0; i + 1 < kNum; ++i) expected.push_back(i);
+    EXPECT_EQ(evicted, expected);
+    for (size_t k = 0; k < advice.size(); ++k) {
+        if (advice[k].advice != MADV_DONTNEED) continue;
+        bool fetched_before = false;
+        for (size_t j = 0; j < k; ++j) {
+            fetched_before |= advice[j].advice == MADV_WILLNEED && advice[j].addr == advice[k].addr;
+        }
+        EXPECT_TRUE(fetched_before) << "page " << *PageOf(advice[k]);
+    }
+}
+
+TEST_F(WeightStreamerTest, WakesOnlyAtWeightBoundariesWithoutMissingWork) {
+    // Weights only at instructions 0 and 8 of 64, lookahead 4: the helper is
+    // woken where the window reaches them (60 and 4) and after their use.
+    const std::vector<backend::WeightRef> refs = {{0, 0, 0, kPage}, {8, 0, kPage, kPage}};
+    WeightStreamer streamer(g_rodata, refs, 64,
+                            StreamingOptions{.lookahead = 4, .advise = RecordAdvice});
+    // The helper fetches the first window before the interpreter moves.
+    WaitFor([](const std::vector<Advice>& a) { return Count(a, MADV_WILLNEED) >= 1; });
+
+    for (size_t step = 0; step < 3; ++step) {
+        for (size_t i = 0; i < 64; ++i) {
+            streamer.OnInstruction(i);
+            if (i != 4 && i != 60) continue;
+            // Weight 1 comes into the window at 4, weight 0 of the next step
+            // at 60; weight 0 was dropped by 4 and weight 1 by 60.
+            const size_t fetches = 1 + 2 * step + (i == 4 ? 1 : 2);
+            const size_t drops = 2 * step + (i == 4 ? 1 : 2);
+            const auto advice = WaitFor([&](const std::vector<Advice>& a) {
+                return Count(a, MADV_WILLNEED) >= fetches && Count(a, MADV_DONTNEED) >= drops;
+            });
+            ASSERT_EQ(Count(advice, MADV_WILLNEED), fetches) << "step " << step << " at " << i;
+            ASSERT_EQ(Count(advice, MADV_DONTNEED), drops) << "step " << step << " at " << i;
+        }
+        streamer.OnStepEnd();
+    }
+}
+
+TEST_F(WeightStreamerTest, DestructionStopsAParkedOrBusyHelper) {
+    constexpr uint32_t kNum = 1024;
+    const auto refs = OneWeightPerInstruction(kNum);
+
+    // Parked: nothing to do beyond the initial window.
+    { WeightStreamer parked(g_rodata, refs, kNum, StreamingOptions{.advise = RecordAdvice}); }
+
+    // Busy: destroyed while the interpreter is still moving.
+    {
+        WeightStreamer busy(g_rodata, refs, kNum,
+                            StreamingOptions{.lookahead = 64, .advise = RecordAdvice});
+        for (size_t i = 0; i < kNum / 2; ++i) busy.OnInstruction(i);
+    }
+    const size_t after_join = Snapshot().size();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(Snapshot().size(), after_join);
+
+    // An empty text section starts no helper at all.
+    { WeightStreamer empty(g_rodata, {}, 0, StreamingOptions{.advise = RecordAdvice}); }
+}
+
+}  // namespace seecpp::runtime::testing
@@ -0,0 +1,152 @@
+// test/cpp/sir/test_arena.cc
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include "seecpp/sir/arena.h"
+#include "seecpp/sir/sir.h"
+
+namespace seecpp::sir::testing {
+
+namespace {
+// Forwards to new/delete and counts what is still outstanding.
+class CountingResource final : public std::pmr::memory_resource {
+ public:
+    size_t live_bytes = 0;
+    size_t allocations = 0;
+
+ private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        live_bytes += bytes;
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        live_bytes -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+}  // namespace
+
+TEST(ArenaTest, RequestsShareAFreeListOnlyWithinTheirSizeClass) {
+    Arena arena;
+    void* small = arena.allocate(1, 1);
+    EXPECT_EQ(arena.bytesInUse(), Arena::kSizeClassBytes);
+    arena.deallocate(small, 1, 1);
+    EXPECT_EQ(arena.bytesInUse(), 0u);
+
+    // Anything up to the class size reuses the block, whatever it asked for.
+    void* full = arena.allocate(Arena::kSizeClassBytes, alignof(std::max_align_t));
+    EXPECT_EQ(full, small);
+    arena.deallocate(full, Arena::kSizeClassBytes, alignof(std::max_align_t));
+
+    // One byte more is the next class and comes from fresh memory.
+    void* next = arena.allocate(Arena::kSizeClassBytes + 1, 1);
+    EXPECT_NE(next, small);
+    EXPECT_EQ(arena.bytesInUse(), 2 * Arena::kSizeClassBytes);
+    void* again = arena.allocate(8, 8);
+    EXPECT_EQ(again, small);
+}
+
+TEST(ArenaTest, OversizedOrOverAlignedBlocksAreNotRecycled) {
+    Arena arena;
+    void* big = arena.allocate(Arena::kMaxRecycledBytes + 1, 8);
+    arena.deallocate(big, Arena::kMaxRecycledBytes + 1, 8);
+    EXPECT_EQ(arena.bytesInUse(), 0u);
+    EXPECT_NE(arena.allocate(Arena::kMaxRecycledBytes + 1, 8), big);
+
+    void* aligned = arena.allocate(16, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned) % 64, 0u);
+    arena.deallocate(aligned, 16, 64);
+    EXPECT_NE(arena.allocate(16, 64), aligned);
+}
+
+TEST(ArenaTest, SlabsDoubleAndFreedBlocksAvoidNewSlabs) {
+    Arena arena;
+    constexpr size_t kBlock = 256;
+    // Fill most of the first slab.
+    std::vector<void*> blocks;
+    for (size_t i = 0; i < Arena::kFirstSlabBytes / kBlock - 1; ++i) blocks.push_back(arena.allocate(kBlock, 8));
+    EXPECT_EQ(arena.bytesReserved(), Arena::kFirstSlabBytes);
+
+    // Churn through the free list: no bytes are carved and no slab is added.
+    const size_t carved = arena.bytesAllocated();
+    for (int round = 0; round < 100; ++round) {
+        for (void* p : blocks) arena.deallocate(p, kBlock, 8);
+        for (void*& p : blocks) p = arena.allocate(kBlock, 8);
+    }
+    EXPECT_EQ(arena.bytesAllocated(), carved);
+    EXPECT_EQ(arena.bytesReserved(), Arena::kFirstSlabBytes);
+
+    // Past the first slab the next one is twice as large.
+    for (int i = 0; i < 2; ++i) arena.allocate(kBlock, 8);
+    EXPECT_EQ(arena.bytesReserved(), 3 * Arena::kFirstSlabBytes);
+
+    // A request larger than the next slab gets a slab of its own and leaves
+    // the doubling schedule where it was.
+    arena.allocate(8 * Arena::kFirstSlabBytes, 8);
+    const size_t after_oversized = arena.bytesReserved();
+    EXPECT_GT(after_oversized, 11 * Arena::kFirstSlabBytes);
+    arena.allocate(2 * Arena::kFirstSlabBytes, 8);
+    EXPECT_EQ(arena.bytesReserved(), after_oversized + 4 * Arena::kFirstSlabBytes);
+}
+
+TEST(ArenaTest, LanesRouteRequestsAndCountTowardsTheParent) {
+    Arena arena;
+    void* from_lane;
+    {
+        Arena::LaneScope scope(arena, 0);
+        from_lane = arena.allocate(32, 8);
+    }
+    EXPECT_EQ(arena.bytesInUse(), 32u);
+    EXPECT_EQ(arena.bytesReserved(), Arena::kFirstSlabBytes);
+
+    // Freed outside the lane, the block lands on the parent's free list.
+    arena.deallocate(from_lane, 32, 8);
+    EXPECT_EQ(arena.bytesInUse(), 0u);
+    EXPECT_EQ(arena.allocate(24, 8), from_lane);
+}
+
+TEST(ArenaTest, OpDeleterReturnsMemoryToTheResourceItCameFrom) {
+    Block block;
+    Arena& arena = block.arena();
+    const size_t baseline = arena.bytesInUse();
+
+    Operation* first;
+    {
+        OwnedOp op = block.createOp(op::kAdd);
+        op->addResult("", DataType::F32, {4});
+        first = op.get();
+        EXPECT_GT(arena.bytesInUse(), baseline);
+    }
+    // The op and its result went back to their size classes...
+    EXPECT_EQ(arena.bytesInUse(), baseline);
+    // ...so the next op of the same shape reuses the same block.
+    OwnedOp second = block.createOp(op::kRelu);
+    EXPECT_EQ(second.get(), first);
+    second.reset();
+
+    // An op removed from its block and dropped is returned the same way.
+    Operation* linked = block.appendOp(op::kAdd);
+    block.removeOp(linked);
+    EXPECT_EQ(arena.bytesInUse(), baseline);
+
+    // Ops from another resource go back to that resource, not the arena.
+    CountingResource counting;
+    {
+        OwnedOp op = Operation::create(op::kAdd, &counting);
+        op->addResult("", DataType::F32, {4});
+        EXPECT_GT(counting.live_bytes, 0u);
+    }
+    EXPECT_EQ(counting.live_bytes, 0u);
+    EXPECT_GT(counting.allocations, 0u);
+    EXPECT_EQ(arena.bytesInUse(), baseline);
+}
+
+}  // namespace seecpp::sir::testing
@@ -0,0 +1,84 @@
+// test/cpp/sir/test_block_order.cc
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "seecpp/sir/sir.h"
+
+namespace seecpp::sir::testing {
+
+namespace {
+// Order queries must agree with list position, for neighbours and far pairs.
+void ExpectOrderMatchesList(const Block& block) {
+    std::vector<const Operation*> ops;
+    for (const Operation* op : block.operations()) ops.push_back(op);
+    for (size_t i = 0; i + 1 < ops.size(); ++i) {
+        ASSERT_TRUE(block.isBeforeInBlock(ops[i], ops[i + 1])) << "at " << i;
+        ASSERT_FALSE(block.isBeforeInBlock(ops[i + 1], ops[i])) << "at " << i;
+    }
+    for (size_t i = 0; i < ops.size() / 2; ++i) {
+        ASSERT_TRUE(block.isBeforeInBlock(ops[i], ops[ops.size() - 1 - i])) << "at " << i;
+    }
+}
+}  // namespace
+
+TEST(BlockOrderTest, RepeatedInsertionBeforeOneOpKeepsOrder) {
+    Block block;
+    Operation* first = block.appendOp(op::kConv2d);
+    Operation* anchor = block.appendOp(op::kConv2d);
+
+    // Each insert lands in the gap the previous one halved, so the labels
+    // around `anchor` run out after a few dozen and must be spread again.
+    for (int i = 0; i < 5000; ++i) block.insertOpBefore(op::kRelu, anchor);
+    // The same at the head of the block, where there is no left neighbour.
+    for (int i = 0; i < 500; ++i) block.insertOpBefore(op::kRelu, block.front());
+
+    EXPECT_EQ(block.numOps(), 5502u);
+    EXPECT_TRUE(block.isBeforeInBlock(first, anchor));
+    EXPECT_TRUE(block.isBeforeInBlock(block.front(), first));
+    ExpectOrderMatchesList(block);
+}
+
+TEST(BlockOrderTest, SplicedRangesAreOrderedAgainstTheirNewNeighbours) {
+    Block block;
+    std::vector<Operation*> ops;
+    for (int i = 0; i < 8; ++i) ops.push_back(block.appendOp(op::kConv2d));
+
+    // The staged ops carry labels from another list, larger than those of
+    // the ops they will sit in front of.
+    Block staging(block.arena());
+    for (int i = 0; i < 100; ++i) staging.appendOp(op::kRelu);
+    Operation* staged_first = staging.front();
+    Operation* staged_last = staging.back();
+    block.spliceOps(ops[2], staging, staged_first, staged_last);
+
+    EXPECT_TRUE(staging.empty());
+    EXPECT_TRUE(block.isBeforeInBlock(ops[1], staged_first));
+    EXPECT_TRUE(block.isBeforeInBlock(staged_last, ops[2]));
+    ExpectOrderMatchesList(block);
+
+    // Inserting into the spliced range afterwards.
+    for (int i = 0; i < 1000; ++i) block.insertOpBefore(op::kRelu, staged_last);
+    ExpectOrderMatchesList(block);
+}
+
+TEST(BlockOrderTest, ErasingOpsLeavesTheRestOrdered) {
+    Block block;
+    std::vector<Operation*> ops;
+    for (int i = 0; i < 2000; ++i) ops.push_back(block.appendOp(op::kConv2d));
+
+    // Lowering pattern: expand every other op into two, then erase it.
+    for (size_t i = 0; i < ops.size(); i += 2) {
+        block.insertOpBefore(op::kLowIm2Col, ops[i]);
+        block.insertOpBefore(op::kLowMatMul, ops[i]);
+        block.removeOp(ops[i]);
+    }
+    EXPECT_EQ(block.numOps(), 3000u);
+    ExpectOrderMatchesList(block);
+
+    // New ops may reuse the labels of erased ones.
+    for (int i = 0; i < 2000; ++i) block.insertOpBefore(op::kRelu, ops[1]);
+    ExpectOrderMatchesList(block);
+}
+
+}  // namespace seecpp::sir::testing
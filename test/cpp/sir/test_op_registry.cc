@@ -0,0 +1,131 @@
+// test/cpp/sir/test_op_registry.cc
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "seecpp/sir/op_registry.h"
+#include "seecpp/sir/sir.h"
+
+namespace seecpp::sir::testing {
+
+TEST(OpRegistryTest, BuiltinsHoldTheirCompileTimeIds) {
+    OpRegistry& registry = OpRegistry::Get();
+    EXPECT_EQ(registry.InternOp("sc_high.relu"), op::kRelu);
+    EXPECT_EQ(registry.OpName(op::kLowMatMul), "sc_low.matmul");
+    EXPECT_EQ(registry.InternAttr("kernel_shape"), attr::kKernelShape);
+    EXPECT_EQ(registry.AttrName(attr::kSourceNode), "source_node");
+
+    const OpInfo& info = registry.GetOpInfo(op::kConv2d);
+    EXPECT_EQ(info.id, op::kConv2d);
+    EXPECT_EQ(info.name, "sc_high.conv2d");
+    EXPECT_EQ(info.dialect, Dialect::kHigh);
+    EXPECT_EQ(registry.OpDialect(op::kLowIm2Col), Dialect::kLow);
+}
+
+TEST(OpRegistryTest, InterningIsIdempotentAndLookupNeverInterns) {
+    OpRegistry& registry = OpRegistry::Get();
+    EXPECT_FALSE(registry.LookupOp("sc_mem.registry_test_copy"));
+    EXPECT_FALSE(registry.LookupAttr("registry_test_attr"));
+
+    const OpId id = registry.InternOp("sc_mem.registry_test_copy");
+    EXPECT_GE(id, op::kNumBuiltins);
+    EXPECT_EQ(registry.InternOp("sc_mem.registry_test_copy"), id);
+    EXPECT_EQ(registry.LookupOp("sc_mem.registry_test_copy"), id);
+    EXPECT_EQ(registry.OpDialect(id), Dialect::kMemory);
+    EXPECT_EQ(registry.InternOp("custom.registry_test"), id + 1);
+    EXPECT_EQ(registry.OpDialect(id + 1), Dialect::kOther);
+
+    const AttrId attr_id = registry.InternAttr("registry_test_attr");
+    EXPECT_GE(attr_id, attr::kNumBuiltins);
+    EXPECT_EQ(registry.LookupAttr("registry_test_attr"), attr_id);
+}
+
+TEST(OpRegistryTest, OpInfoAndNamesStayPutAsTheTableGrows) {
+    OpRegistry& registry = OpRegistry::Get();
+    const OpId id = registry.InternOp("sc_ctrl.registry_test_branch");
+    const OpInfo* info = &registry.GetOpInfo(id);
+    const std::string_view name = registry.OpName(id);
+
+    Block block;
+    Operation* op = block.appendOp(id);
+    for (int i = 0; i < 1000; ++i) registry.InternOp("sc_ctrl.registry_test_" + std::to_string(i));
+
+    EXPECT_EQ(&registry.GetOpInfo(id), info);
+    EXPECT_EQ(registry.OpName(id).data(), name.data());
+    EXPECT_EQ(op->mnemonic(), "sc_ctrl.registry_test_branch");
+    EXPECT_TRUE(op->isControlFlow());
+    EXPECT_EQ(op->opId(), id);
+}
+
+TEST(OpRegistryTest, ConcurrentInterningAgreesOnEveryId) {
+    constexpr int kThreads = 8;
+    constexpr int kNames = 200;
+    std::vector<std::vector<OpId>> seen(kThreads, std::vector<OpId>(kNames));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            // Every thread walks the same names from a different start.
+            for (int i = 0; i < kNames; ++i) {
+                const int n = (i + t * 25) % kNames;
+                const OpId id = OpRegistry::Get().InternOp("sc_low.registry_race_" + std::to_string(n));
+                seen[t][n] = id;
+                // Builtins are read unlocked while the table grows.
+                EXPECT_EQ(OpRegistry::Get().OpName(op::kRelu), "sc_high.relu");
+            }
+        });
+    }
+    for (std::thread& t : threads) t.join();
+
+    for (int t = 1; t < kThreads; ++t) EXPECT_EQ(seen[t], seen[0]);
+    for (int n = 0; n < kNames; ++n) {
+        EXPECT_EQ(OpRegistry::Get().OpName(seen[0][n]), "sc_low.registry_race_" + std::to_string(n));
+    }
+}
+
+// Interned IDs against the string keys they replaced, over 500k ops with
+// three attributes each. Run with --gtest_also_run_disabled_tests.
+TEST(OpRegistryTest, DISABLED_BenchmarkIdsAgainstStrings) {
+    constexpr int kOps = 500000;
+    constexpr int kRounds = 10;
+    using Clock = std::chrono::steady_clock;
+    const auto ms = [](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+
+    Block block;
+    auto start = Clock::now();
+    for (int i = 0; i < kOps; ++i) {
+        Operation* op = block.appendOp(i % 3 ? op::kRelu : op::kConv2d);
+        op->setAttribute(attr::kGroup, int64_t{1});
+        op->setAttribute(attr::kAxis, int64_t{i});
+        op->setAttribute(attr::kSourceNode, std::string("node"));
+    }
+    std::printf("build:             %8.1f ms\n", ms(Clock::now() - start));
+
+    size_t matches = 0;
+    start = Clock::now();
+    for (int r = 0; r < kRounds; ++r)
+        for (const Operation* op : block.operations()) matches += op->mnemonic() == "sc_high.relu";
+    std::printf("opcode match x%d:  %8.1f ms (string)\n", kRounds, ms(Clock::now() - start));
+    start = Clock::now();
+    for (int r = 0; r < kRounds; ++r)
+        for (const Operation* op : block.operations()) matches += op->is(op::kRelu);
+    std::printf("opcode match x%d:  %8.1f ms (id)\n", kRounds, ms(Clock::now() - start));
+
+    int64_t sum = 0;
+    start = Clock::now();
+    for (int r = 0; r < kRounds; ++r)
+        for (const Operation* op : block.operations()) sum += *op->getAttrAs<int64_t>("axis");
+    std::printf("attr lookup x%d:   %8.1f ms (string)\n", kRounds, ms(Clock::now() - start));
+    start = Clock::now();
+    for (int r = 0; r < kRounds; ++r)
+        for (const Operation* op : block.operations()) sum += *op->getAttrAs<int64_t>(attr::kAxis);
+    std::printf("attr lookup x%d:   %8.1f ms (id)\n", kRounds, ms(Clock::now() - start));
+
+    EXPECT_EQ(matches, 2u * kRounds * (kOps - (kOps + 2) / 3));
+    EXPECT_GT(sum, 0);
+}
+
+}  // namespace seecpp::sir::testing
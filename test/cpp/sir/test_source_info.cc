@@ -0,0 +1,59 @@
+// test/cpp/sir/test_source_info.cc
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "seecpp/sir/sir.h"
+
+namespace seecpp::sir::testing {
+
+namespace {
+Operation* AppendFromNode(Block& block, OpId id, const std::string& node, const std::string& type) {
+    Operation* op = block.appendOp(id);
+    op->setAttribute(attr::kSourceNode, node);
+    op->setAttribute(attr::kSourceOpType, type);
+    return op;
+}
+}  // namespace
+
+TEST(SourceInfoTest, EveryInsertOpBeforeOverloadInheritsTheAnchorsSource) {
+    Block block;
+    Operation* anchor = AppendFromNode(block, op::kConv2d, "conv1", "Conv");
+
+    Operation* by_id = block.insertOpBefore(op::kRelu, anchor);
+    Operation* by_name = block.insertOpBefore("sc_high.relu", anchor);
+    Operation* owned = block.insertOpBefore(block.createOp(op::kRelu), anchor);
+
+    for (const Operation* op : {by_id, by_name, owned}) {
+        EXPECT_EQ(op->getAttrAs<std::string>(attr::kSourceNode), "conv1");
+        EXPECT_EQ(op->getAttrAs<std::string>(attr::kSourceOpType), "Conv");
+        EXPECT_EQ(op->parentBlock(), &block);
+    }
+    EXPECT_EQ(block.numOps(), 4u);
+}
+
+TEST(SourceInfoTest, AMovedOpKeepsItsOwnSource) {
+    Block block;
+    Operation* moved = AppendFromNode(block, op::kRelu, "relu1", "Relu");
+    Operation* anchor = AppendFromNode(block, op::kConv2d, "conv1", "Conv");
+
+    // Only attributes the op lacks are filled in from the anchor.
+    OwnedOp owned = block.createOp(op::kAdd);
+    Operation* partial = owned.get();
+    owned->setAttribute(attr::kSourceNode, std::string("add1"));
+    block.insertOpBefore(std::move(owned), anchor);
+    EXPECT_EQ(partial->getAttrAs<std::string>(attr::kSourceNode), "add1");
+    EXPECT_EQ(partial->getAttrAs<std::string>(attr::kSourceOpType), "Conv");
+
+    // An op taken out and put back in front of another keeps what it had.
+    block.insertOpBefore(block.removeOp(moved), anchor);
+    EXPECT_EQ(moved->getAttrAs<std::string>(attr::kSourceNode), "relu1");
+    EXPECT_EQ(moved->getAttrAs<std::string>(attr::kSourceOpType), "Relu");
+
+    // Other attributes are never copied.
+    anchor->setAttribute(attr::kFlops, int64_t{42});
+    Operation* plain = block.insertOpBefore(op::kRelu, anchor);
+    EXPECT_FALSE(plain->getAttribute(attr::kFlops));
+}
+
+}  // namespace seecpp::sir::testing
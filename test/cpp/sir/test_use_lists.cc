@@ -0,0 +1,103 @@
+// test/cpp/sir/test_use_lists.cc
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "seecpp/sir/sir.h"
+
+namespace seecpp::sir::testing {
+
+namespace {
+// Every slot of `op` that holds `v` must be on v's use-list exactly once,
+// and every use on the list must be a live slot holding `v`.
+void ExpectUsesMatchSlots(const Value* v, Operation* op) {
+    size_t slots = 0;
+    for (const OpOperand& slot : op->opOperands()) slots += slot.get() == v;
+    size_t listed = 0;
+    for (const OpOperand& use : v->uses()) {
+        if (use.owner() != op) continue;
+        ++listed;
+        EXPECT_EQ(use.get(), v);
+        EXPECT_GE(&use, op->opOperands().data());
+        EXPECT_LT(&use, op->opOperands().data() + op->numOperands());
+    }
+    EXPECT_EQ(listed, slots);
+}
+}  // namespace
+
+TEST(UseListTest, RemovedOpsLeaveTheirOperandsUseListsUntilRelinked) {
+    Block block;
+    Value* x = block.addArgument(DataType::F32, {4});
+    Operation* producer = block.appendOp(op::kRelu);
+    producer->addOperand(x);
+    Value* y = producer->addResult("", DataType::F32, {4});
+    Operation* consumer = block.appendOp(op::kAdd);
+    consumer->addOperand(y);
+    consumer->addOperand(y);
+    ASSERT_EQ(y->numUses(), 2u);
+
+    OwnedOp removed = block.removeOp(consumer);
+    EXPECT_TRUE(y->hasNoUses());
+    // The op still knows its operands, so it can be linked elsewhere.
+    EXPECT_EQ(removed->operand(0), y);
+    EXPECT_EQ(removed->operand(1), y);
+
+    // Linking it again puts both slots back.
+    Operation* relinked = block.appendOp(std::move(removed));
+    EXPECT_EQ(y->numUses(), 2u);
+    ExpectUsesMatchSlots(y, relinked);
+
+    // An op built detached is a user from the start; linking it does not
+    // thread its slots a second time.
+    OwnedOp built = block.createOp(op::kRelu);
+    built->addOperand(x);
+    EXPECT_EQ(x->numUses(), 2u);
+    block.insertOpBefore(std::move(built), relinked);
+    EXPECT_EQ(x->numUses(), 2u);
+}
+
+TEST(UseListTest, OperandArrayGrowthMovesEveryUse) {
+    Block block;
+    std::vector<Value*> args;
+    for (int i = 0; i < 4; ++i) args.push_back(block.addArgument(DataType::F32, {1}));
+    Operation* op = block.appendOp(op::kConcat);
+
+    // Enough operands that the slot array reallocates several times; each
+    // move must repoint the neighbouring uses at the new slot.
+    for (int i = 0; i < 64; ++i) {
+        op->addOperand(args[i % args.size()]);
+        for (const Value* v : args) ExpectUsesMatchSlots(v, op);
+    }
+    for (const Value* v : args) EXPECT_EQ(v->numUses(), 16u);
+
+    // Redirects after growth still find their slots.
+    op->setOperand(0, args[1]);
+    EXPECT_EQ(args[0]->numUses(), 15u);
+    EXPECT_EQ(args[1]->numUses(), 17u);
+    ExpectUsesMatchSlots(args[0], op);
+    ExpectUsesMatchSlots(args[1], op);
+}
+
+TEST(UseListTest, DestroyingAValueDetachesItsUses) {
+    Block block;
+    Value* x = block.addArgument(DataType::F32, {4});
+    Operation* producer = block.appendOp(op::kRelu);
+    producer->addOperand(x);
+    Value* y = producer->addResult("", DataType::F32, {4});
+    Operation* consumer = block.appendOp(op::kAdd);
+    consumer->addOperand(y);
+    consumer->addOperand(x);
+
+    // Dropping the producer destroys y while the consumer still names it.
+    block.removeOp(producer);
+    EXPECT_EQ(consumer->operand(0), nullptr);
+    EXPECT_EQ(consumer->operand(1), x);
+    EXPECT_EQ(x->numUses(), 1u);
+
+    // The emptied slot can be filled again.
+    consumer->setOperand(0, x);
+    EXPECT_EQ(x->numUses(), 2u);
+    ExpectUsesMatchSlots(x, consumer);
+}
+
+}  // namespace seecpp::sir::testing
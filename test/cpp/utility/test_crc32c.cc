@@ -0,0 +1,62 @@
+// test/cpp/utility/test_crc32c.cc
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "include/utility/crc32c.h"
+#include "include/utility/thread_pool.h"
+
+namespace seecpp::utility::testing {
+
+namespace {
+std::span<const uint8_t> Bytes(std::string_view s) {
+    return {reinterpret_cast<const uint8_t*>(s.data()), s.size()};
+}
+
+std::vector<uint8_t> Pattern(size_t size) {
+    std::vector<uint8_t> out(size);
+    uint32_t x = 0x12345678;
+    for (uint8_t& b : out) {
+        x = x * 1664525 + 1013904223;
+        b = static_cast<uint8_t>(x >> 24);
+    }
+    return out;
+}
+}  // namespace
+
+TEST(Crc32cTest, MatchesTheStandardCheckValue) {
+    EXPECT_EQ(Crc32c(Bytes("123456789")), 0xE3069283u);
+    EXPECT_EQ(Crc32c({}), 0u);
+}
+
+TEST(Crc32cTest, ChunkedParallelAndSparseAgreeWithOnePass) {
+    // Long enough for the three-stream path, with an odd tail.
+    const std::vector<uint8_t> data = Pattern(200'003);
+    const uint32_t whole = Crc32c(data);
+
+    // Byte-at-a-time continuation takes only the scalar tail path.
+    uint32_t bytewise = 0;
+    for (uint8_t b : data) bytewise = Crc32c({&b, 1}, bytewise);
+    EXPECT_EQ(bytewise, whole);
+
+    const std::span<const uint8_t> all(data);
+    EXPECT_EQ(Crc32cCombine(Crc32c(all.first(77'777)), Crc32c(all.subspan(77'777)), data.size() - 77'777),
+              whole);
+
+    ThreadPool pool(3);
+    EXPECT_EQ(Crc32cParallel(data, &pool, 4096), whole);
+    EXPECT_EQ(Crc32cParallel(data, nullptr, 1000), whole);
+
+    // Two runs with zero gaps before, between and after them.
+    std::vector<uint8_t> dense(data.size() + 300, 0);
+    std::copy(data.begin(), data.begin() + 1000, dense.begin() + 100);
+    std::copy(data.begin() + 1000, data.end(), dense.begin() + 1200);
+    const Crc32cExtent extents[] = {{100, all.first(1000)}, {1200, all.subspan(1000)}};
+    EXPECT_EQ(Crc32cSparse(extents, dense.size(), &pool, 8192), Crc32c(dense));
+    EXPECT_EQ(Crc32cExtendZeros(Crc32c(all.first(10)), 100),
+              Crc32c(std::vector<uint8_t>(100, 0), Crc32c(all.first(10))));
+}
+
+}  // namespace seecpp::utility::testing
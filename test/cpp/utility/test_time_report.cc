@@ -0,0 +1,74 @@
+// test/cpp/utility/test_time_report.cc
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "seecpp/sir/sir.h"
+#include "seecpp/utility/time_report.h"
+
+namespace seecpp::utility::testing {
+
+class TimeReportTest : public ::testing::Test {
+ protected:
+    void AppendRelu() {
+        auto* op = block_.appendOp(sir::op::kRelu);
+        op->addOperand(x_);
+        op->addResult("", sir::DataType::F32, {4});
+    }
+
+    sir::Block block_;
+    sir::Value* x_ = block_.addArgument(sir::DataType::F32, {4});
+};
+
+TEST_F(TimeReportTest, NestedPhasesRecordIrCounts) {
+    TimeReport report(/*enabled=*/true);
+    {
+        TimeReport::Scope outer(&report, "middle_end", "middle_end", &block_);
+        {
+            TimeReport::Scope pass(&report, "grow", "pass", &block_);
+            AppendRelu();
+            AppendRelu();
+        }
+        TimeReport::Scope split(&report, "split", "pass", &block_);
+        split.set_block(nullptr);
+    }
+
+    const auto phases = report.phases();
+    ASSERT_EQ(phases.size(), 3u);
+    EXPECT_EQ(phases[0].name, "middle_end");
+    EXPECT_EQ(phases[0].depth, 0u);
+    EXPECT_EQ(phases[1].name, "grow");
+    EXPECT_EQ(phases[1].depth, 1u);
+
+    ASSERT_TRUE(phases[1].before && phases[1].after);
+    EXPECT_EQ(phases[1].before->ops, 0u);
+    EXPECT_EQ(phases[1].before->values, 1u);
+    EXPECT_EQ(phases[1].after->ops, 2u);
+    EXPECT_EQ(phases[1].after->values, 3u);
+    EXPECT_TRUE(phases[2].before.has_value());
+    EXPECT_FALSE(phases[2].after.has_value());
+
+    EXPECT_GE(phases[0].wall, phases[1].wall);
+    EXPECT_LE(phases[0].start, phases[1].start);
+
+    const std::string json = report.ToJson();
+    EXPECT_NE(json.find("\"name\": \"grow\""), std::string::npos);
+    EXPECT_NE(json.find("\"after\": {\"ops\": 2, \"values\": 3}"), std::string::npos);
+    EXPECT_NE(json.find("\"after\": null"), std::string::npos);
+
+    const std::string trace = report.ToChromeTrace();
+    EXPECT_NE(trace.find("\"ph\": \"X\""), std::string::npos);
+    EXPECT_NE(trace.find("\"ops_after\": 2"), std::string::npos);
+}
+
+TEST_F(TimeReportTest, DisabledReportRecordsNothing) {
+    TimeReport report;
+    {
+        TimeReport::Scope scope(&report, "ingest", "frontend", &block_);
+        TimeReport::Scope inert(nullptr, "ingest", "frontend", &block_);
+        AppendRelu();
+    }
+    EXPECT_TRUE(report.phases().empty());
+}
+
+}  // namespace seecpp::utility::testing
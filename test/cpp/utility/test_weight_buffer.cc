@@ -0,0 +1,83 @@
+// test/cpp/utility/test_weight_buffer.cc
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "seecpp/utility/weight_buffer.h"
+
+namespace seecpp::utility::testing {
+
+namespace {
+// Storage whose lifetime the buffer extends through keep_alive.
+struct Backing {
+    alignas(16) uint8_t bytes[64];
+};
+
+std::shared_ptr<Backing> MakeBacking() {
+    auto backing = std::make_shared<Backing>();
+    for (size_t i = 0; i < sizeof(backing->bytes); ++i) backing->bytes[i] = static_cast<uint8_t>(i);
+    return backing;
+}
+}  // namespace
+
+TEST(WeightBufferTest, AlignedBorrowedBytesAreNotCopied) {
+    auto backing = MakeBacking();
+    const std::span<const uint8_t> bytes(backing->bytes, 16);
+
+    WeightBuffer weights;
+    const auto stored = weights.AddBorrowed("w", bytes, sizeof(float), BufferDtype::kF32, backing);
+    EXPECT_EQ(stored.data(), backing->bytes);
+    EXPECT_TRUE(weights.IsBorrowed("w"));
+    // The entry pins the backing storage.
+    EXPECT_EQ(backing.use_count(), 2);
+
+    auto floats = weights.Get<float>("w");
+    ASSERT_TRUE(floats.has_value());
+    EXPECT_EQ(floats->size(), 4u);
+    EXPECT_EQ(static_cast<const void*>(floats->data()), backing->bytes);
+
+    weights.Remove("w");
+    EXPECT_EQ(backing.use_count(), 1);
+}
+
+TEST(WeightBufferTest, MisalignedBorrowedBytesAreCopied) {
+    auto backing = MakeBacking();
+    // Offset 3 suits single bytes but not floats.
+    const std::span<const uint8_t> bytes(backing->bytes + 3, 16);
+
+    WeightBuffer weights;
+    const auto stored = weights.AddBorrowed("w", bytes, sizeof(float), BufferDtype::kF32, backing);
+    EXPECT_NE(stored.data(), bytes.data());
+    EXPECT_FALSE(weights.IsBorrowed("w"));
+    // A copy needs no keep-alive.
+    EXPECT_EQ(backing.use_count(), 1);
+
+    auto floats = weights.Get<float>("w");
+    ASSERT_TRUE(floats.has_value());
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(floats->data()) % alignof(float), 0u);
+    ASSERT_EQ(floats->size(), 4u);
+    EXPECT_EQ(std::memcmp(floats->data(), bytes.data(), bytes.size()), 0);
+
+    // The same offset is fine for one-byte elements.
+    weights.AddBorrowed("b", bytes, 1, BufferDtype::kU8, backing);
+    EXPECT_TRUE(weights.IsBorrowed("b"));
+    EXPECT_EQ(weights.GetRawBytes("b")->data(), bytes.data());
+}
+
+TEST(WeightBufferTest, ExistingNamesAreNotOverwritten) {
+    auto backing = MakeBacking();
+    WeightBuffer weights;
+    const std::vector<float> owned = {1.0f, 2.0f};
+    const auto first = weights.Add<float>("w", owned, BufferDtype::kF32);
+
+    const auto second = weights.AddBorrowed("w", {backing->bytes, 16}, sizeof(float), BufferDtype::kF32, backing);
+    EXPECT_EQ(second.data(), reinterpret_cast<const uint8_t*>(first.data()));
+    EXPECT_EQ(second.size(), owned.size() * sizeof(float));
+    EXPECT_FALSE(weights.IsBorrowed("w"));
+    EXPECT_EQ(backing.use_count(), 1);
+}
+
+}  // namespace seecpp::utility::testing